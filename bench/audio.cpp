@@ -0,0 +1,218 @@
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <benchmark/benchmark.h>
+#include "audio_offline.h"
+#include "audio_secache.h"
+#include "filefinder.h"
+#include "output.h"
+
+using namespace std::chrono_literals;
+using Event = OfflineAudio::Event;
+
+// The RTP files of the unit test assets are empty placeholders, the script
+// uses fixtures generated into EP_BENCH_ASSET_PATH instead
+const Event script[] = {
+	{ 0ms, Event::Type::BgmPlay, "Music/bgm1.wav", 100, 100, 0 },
+	{ 500ms, Event::Type::SePlay, "Sound/se.wav" },
+	{ 1000ms, Event::Type::SePlay, "Sound/se.wav", 80, 150 },
+	{ 1500ms, Event::Type::BgmFade, "", 100, 100, 500 },
+	{ 2000ms, Event::Type::BgmPlay, "Music/bgm2.wav", 100, 100, 200 },
+	{ 2500ms, Event::Type::SePlay, "Sound/se.wav", 100, 50 },
+	{ 3000ms, Event::Type::BgmPlay, "Music/bgm3.mid", 100, 120, 0 },
+	{ 3500ms, Event::Type::SePlay, "Sound/se.wav" },
+	{ 4000ms, Event::Type::BgmStop },
+};
+constexpr auto script_length = 5000ms;
+
+template <typename T>
+static void WriteLE(std::ostream& os, T value) {
+	for (size_t i = 0; i < sizeof(T); ++i) {
+		os.put(static_cast<char>((value >> (i * 8)) & 0xFF));
+	}
+}
+
+template <typename T>
+static void WriteBE(std::ostream& os, T value) {
+	for (size_t i = sizeof(T); i > 0; --i) {
+		os.put(static_cast<char>((value >> ((i - 1) * 8)) & 0xFF));
+	}
+}
+
+// 16 bit PCM sine tone
+static void WriteSineWav(std::ostream& os, int rate, int channels, double freq, std::chrono::milliseconds length) {
+	const uint32_t frames = static_cast<uint32_t>(rate * length.count() / 1000);
+	const uint32_t data_size = frames * channels * 2;
+
+	os.write("RIFF", 4);
+	WriteLE<uint32_t>(os, 36 + data_size);
+	os.write("WAVEfmt ", 8);
+	WriteLE<uint32_t>(os, 16);
+	WriteLE<uint16_t>(os, 1);
+	WriteLE<uint16_t>(os, channels);
+	WriteLE<uint32_t>(os, rate);
+	WriteLE<uint32_t>(os, rate * channels * 2);
+	WriteLE<uint16_t>(os, channels * 2);
+	WriteLE<uint16_t>(os, 16);
+	os.write("data", 4);
+	WriteLE<uint32_t>(os, data_size);
+
+	for (uint32_t i = 0; i < frames; ++i) {
+		auto sample = static_cast<int16_t>(std::sin(2.0 * 3.14159265358979 * freq * i / rate) * 8000.0);
+		for (int c = 0; c < channels; ++c) {
+			WriteLE<uint16_t>(os, static_cast<uint16_t>(sample));
+		}
+	}
+}
+
+// Format 0 MIDI file playing a short scale
+static void WriteScaleMidi(std::ostream& os) {
+	std::string track;
+	auto event = [&](std::initializer_list<int> bytes) {
+		for (int b: bytes) {
+			track.push_back(static_cast<char>(b));
+		}
+	};
+
+	event({ 0x00, 0xC0, 0x00 });
+	for (int note: { 60, 62, 64, 65, 67, 69, 71, 72 }) {
+		event({ 0x00, 0x90, note, 0x64 });
+		event({ 0x60, 0x80, note, 0x40 });
+	}
+	event({ 0x00, 0xFF, 0x2F, 0x00 });
+
+	os.write("MThd", 4);
+	WriteBE<uint32_t>(os, 6);
+	WriteBE<uint16_t>(os, 0);
+	WriteBE<uint16_t>(os, 1);
+	WriteBE<uint16_t>(os, 96);
+	os.write("MTrk", 4);
+	WriteBE<uint32_t>(os, track.size());
+	os.write(track.data(), track.size());
+}
+
+// Generates the files of the script once per process
+static FilesystemView GetAssets() {
+	static FilesystemView fs = []() {
+		auto root = FileFinder::Root();
+		root.MakeDirectory(EP_BENCH_ASSET_PATH "/Music", false);
+		root.MakeDirectory(EP_BENCH_ASSET_PATH "/Sound", false);
+
+		{
+			auto os = root.OpenOutputStream(EP_BENCH_ASSET_PATH "/Music/bgm1.wav");
+			WriteSineWav(os, 44100, 2, 440.0, 3s);
+		}
+		{
+			// Different rate and channel count for the resampler
+			auto os = root.OpenOutputStream(EP_BENCH_ASSET_PATH "/Music/bgm2.wav");
+			WriteSineWav(os, 22050, 1, 330.0, 3s);
+		}
+		{
+			auto os = root.OpenOutputStream(EP_BENCH_ASSET_PATH "/Music/bgm3.mid");
+			WriteScaleMidi(os);
+		}
+		{
+			auto os = root.OpenOutputStream(EP_BENCH_ASSET_PATH "/Sound/se.wav");
+			WriteSineWav(os, 11025, 1, 880.0, 300ms);
+		}
+
+		return root.Subtree(EP_BENCH_ASSET_PATH);
+	}();
+	return fs;
+}
+
+// Measuring an empty mixer is no benchmark, fail when the fixtures did not decode
+static bool CheckDecoders(benchmark::State& state, const GenericAudio::DecodeStats& stats) {
+	bool has_bgm = false;
+	for (auto& dec: stats.decoders) {
+		has_bgm |= (dec.first != "se" && dec.second.calls > 0);
+	}
+	if (!has_bgm) {
+		state.SkipWithError("No BGM decoder was opened");
+		return false;
+	}
+	if (stats.decoders.find("se") == stats.decoders.end()) {
+		state.SkipWithError("No SE decoder was opened");
+		return false;
+	}
+	return true;
+}
+
+static void ReportStats(benchmark::State& state, const GenericAudio::DecodeStats& stats) {
+	using ms = std::chrono::duration<double, std::milli>;
+
+	for (auto& dec: stats.decoders) {
+		state.counters[dec.first + "_ms"] = benchmark::Counter(ms(dec.second.time).count(), benchmark::Counter::kAvgIterations);
+	}
+	state.counters["mix_ms"] = benchmark::Counter(ms(stats.mix_time).count(), benchmark::Counter::kAvgIterations);
+	state.counters["decode_ms"] = benchmark::Counter(ms(stats.total_time).count(), benchmark::Counter::kAvgIterations);
+}
+
+static void BM_AudioScript(benchmark::State& state) {
+	Output::SetLogLevel(LogLevel::Error);
+	auto fs = GetAssets();
+	Game_ConfigAudio cfg;
+
+	GenericAudio::DecodeStats stats;
+	for (auto _: state) {
+		OfflineAudio audio(cfg, state.range(0));
+		audio.SetDecodeStatsEnabled(true);
+		audio.RunScript(script, script_length, fs);
+		audio.BGM_Stop();
+
+		auto& s = audio.GetDecodeStats();
+		for (auto& dec: s.decoders) {
+			stats.decoders[dec.first].time += dec.second.time;
+			stats.decoders[dec.first].calls += dec.second.calls;
+		}
+		stats.mix_time += s.mix_time;
+		stats.total_time += s.total_time;
+	}
+
+	if (CheckDecoders(state, stats)) {
+		ReportStats(state, stats);
+	}
+	AudioSeCache::Clear();
+	Output::SetLogLevel(LogLevel::Debug);
+}
+
+BENCHMARK(BM_AudioScript)->Arg(44100)->Arg(48000)->Unit(benchmark::kMillisecond);
+
+static void BM_AudioMixOnly(benchmark::State& state) {
+	Output::SetLogLevel(LogLevel::Error);
+	Game_ConfigAudio cfg;
+	OfflineAudio audio(cfg, 44100);
+
+	for (auto _: state) {
+		audio.Render(1s);
+	}
+
+	Output::SetLogLevel(LogLevel::Debug);
+}
+
+BENCHMARK(BM_AudioMixOnly)->Unit(benchmark::kMillisecond);
+
+// Renders the script once to the file in EP_BENCH_AUDIO_WAV for listening tests
+static void BM_AudioRenderWav(benchmark::State& state) {
+	const char* out = getenv("EP_BENCH_AUDIO_WAV");
+	if (!out) {
+		state.SkipWithError("EP_BENCH_AUDIO_WAV not set");
+		return;
+	}
+
+	auto fs = GetAssets();
+	Game_ConfigAudio cfg;
+
+	for (auto _: state) {
+		OfflineAudio audio(cfg, 44100);
+		audio.SetCapture(true);
+		audio.RunScript(script, script_length, fs);
+
+		std::ofstream os(out, std::ios::binary);
+		audio.WriteWav(os);
+	}
+}
+
+BENCHMARK(BM_AudioRenderWav)->Iterations(1)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -1,4 +1,5 @@
 #include <cmath>
+#include <vector>
 #include <benchmark/benchmark.h>
 #include <rect.h>
 #include <bitmap.h>
@@ -118,6 +119,47 @@ static void BM_TiledBlit(benchmark::State& state) {
 
 BENCHMARK(BM_TiledBlit);
 
+static void BM_ParticleBlit(benchmark::State& state) {
+	Bitmap::SetFormat(format);
+	auto dest = Bitmap::Create(320, 160);
+	auto src = Bitmap::Create(6, 24, Color(255, 255, 255, 255));
+	auto rect = src->GetRect();
+
+	constexpr int n = 100;
+	std::vector<int16_t> xs(n), ys(n);
+	std::vector<uint8_t> opacities(n, 160);
+	for (int i = 0; i < n; ++i) {
+		xs[i] = (i * 37) % 320;
+		ys[i] = (i * 23) % 160;
+	}
+
+	for (auto _: state) {
+		dest->ParticleBlit(*src, rect, 1, xs, ys, opacities, true);
+	}
+}
+
+BENCHMARK(BM_ParticleBlit);
+
+static void BM_SelectBlit(benchmark::State& state) {
+	Bitmap::SetFormat(format);
+	auto dest = Bitmap::Create(320, 240);
+	auto src1 = Bitmap::Create(320, 240, false);
+	auto src2 = Bitmap::Create(320, 240, false);
+
+	// Random blocks transition at 50%
+	const int cell = static_cast<int>(state.range(0));
+	std::vector<uint8_t> map((320 / cell) * (240 / cell));
+	for (size_t i = 0; i < map.size(); ++i) {
+		map[i] = 1 + (i * 7919) % 2;
+	}
+
+	for (auto _: state) {
+		dest->SelectBlit(*src1, *src2, map, cell, cell);
+	}
+}
+
+BENCHMARK(BM_SelectBlit)->Arg(1)->Arg(4);
+
 static void BM_TiledBlitOffset(benchmark::State& state) {
 	Bitmap::SetFormat(format);
 	auto dest = Bitmap::Create(320, 240);
@@ -207,6 +249,22 @@ static void BM_WaverBlit(benchmark::State& state) {
 
 BENCHMARK(BM_WaverBlit);
 
+static void BM_WaverBlitPicture(benchmark::State& state) {
+	Bitmap::SetFormat(format);
+	auto dest = Bitmap::Create(320, 240);
+	auto src = Bitmap::Create(320, 240);
+	auto rect = src->GetRect();
+	// Same phase steps as a picture with Effect_wave
+	int depth = 8;
+	int waver = 0;
+	for (auto _: state) {
+		dest->WaverBlit(0, 0, 1.0, 1.0, *src, rect, depth, waver * (2 * M_PI) / 256, opacity);
+		waver += 8;
+	}
+}
+
+BENCHMARK(BM_WaverBlitPicture);
+
 static void BM_Fill(benchmark::State& state) {
 	Bitmap::SetFormat(format);
 	auto dest = Bitmap::Create(320, 240);
@@ -264,6 +322,23 @@ static void BM_HueChangeBlit(benchmark::State& state) {
 
 BENCHMARK(BM_HueChangeBlit);
 
+static void BM_HueChangeBlitColors(benchmark::State& state) {
+	Bitmap::SetFormat(format);
+	auto dest = Bitmap::Create(320, 240);
+	auto src = Bitmap::Create(320, 240);
+	// Colored stripes, the empty bitmap of BM_HueChangeBlit skips every pixel
+	for (int i = 0; i < 240; ++i) {
+		src->FillRect(Rect(0, i, 320, 1), Color(i, 255 - i, (i * 7) & 0xFF, 255));
+	}
+	auto rect = src->GetRect();
+	double hue = state.range(0);
+	for (auto _: state) {
+		dest->HueChangeBlit(0, 0, *src, rect, hue);
+	}
+}
+
+BENCHMARK(BM_HueChangeBlitColors)->Arg(45)->Arg(180)->Arg(300);
+
 static void BM_ToneBlit(benchmark::State& state) {
 	Bitmap::SetFormat(format);
 	auto dest = Bitmap::Create(320, 240);
@@ -290,6 +365,20 @@ static void BM_BlendBlit(benchmark::State& state) {
 
 BENCHMARK(BM_BlendBlit);
 
+static void BM_ToneBlendFlipBlit(benchmark::State& state) {
+	Bitmap::SetFormat(format);
+	auto dest = Bitmap::Create(320, 240);
+	auto src = Bitmap::Create(320, 240);
+	auto rect = src->GetRect();
+	auto tone = Tone(255,255,255,128);
+	auto color = Color(255, 255, 255, 128);
+	for (auto _: state) {
+		dest->ToneBlendFlipBlit(0, 0, *src, rect, tone, color, true, false, opacity);
+	}
+}
+
+BENCHMARK(BM_ToneBlendFlipBlit);
+
 static void BM_Flip(benchmark::State& state) {
 	Bitmap::SetFormat(format);
 	auto dest = Bitmap::Create(320, 240);
@@ -0,0 +1,54 @@
+#include <cstddef>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include <scaler.h>
+
+static std::vector<uint32_t> CreateFrame(int width, int height) {
+	std::vector<uint32_t> pixels(width * height);
+	for (size_t i = 0; i < pixels.size(); ++i) {
+		pixels[i] = static_cast<uint32_t>(i * 2654435761u);
+	}
+	return pixels;
+}
+
+static void NearestTest(benchmark::State& state, int width, int height) {
+	auto src = CreateFrame(320, 240);
+	std::vector<uint32_t> dst(width * height);
+	for (auto _: state) {
+		Scaler::Nearest(src.data(), 320, 240, 320 * 4, dst.data(), width, height, width * 4);
+	}
+}
+
+static void BilinearTest(benchmark::State& state, int width, int height, int prescale) {
+	auto src = CreateFrame(320, 240);
+	std::vector<uint32_t> dst(width * height);
+	for (auto _: state) {
+		Scaler::Bilinear(src.data(), 320, 240, 320 * 4, dst.data(), width, height, width * 4, prescale);
+	}
+}
+
+static void BM_ScalerNearest3x(benchmark::State& state) {
+	NearestTest(state, 960, 720);
+}
+
+BENCHMARK(BM_ScalerNearest3x);
+
+static void BM_ScalerNearestFractional(benchmark::State& state) {
+	NearestTest(state, 1024, 768);
+}
+
+BENCHMARK(BM_ScalerNearestFractional);
+
+static void BM_ScalerBilinear(benchmark::State& state) {
+	BilinearTest(state, 1024, 768, 1);
+}
+
+BENCHMARK(BM_ScalerBilinear);
+
+static void BM_ScalerBilinearPrescale(benchmark::State& state) {
+	BilinearTest(state, 1024, 768, 4);
+}
+
+BENCHMARK(BM_ScalerBilinearPrescale);
+
+BENCHMARK_MAIN();
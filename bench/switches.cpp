@@ -64,5 +64,61 @@ static void BM_SwitchFlipRange(benchmark::State& state) {
 
 BENCHMARK(BM_SwitchFlipRange);
 
+static void BM_SwitchCountRange(benchmark::State& state) {
+	volatile int x = 0;
+	BM_SwitchOp(state, [&x](auto& s, auto, bool) { x = s.CountRange(1, max_sws); });
+}
+
+BENCHMARK(BM_SwitchCountRange);
+
+template <typename F>
+static void BM_SwitchRangeOpN(benchmark::State& state, F&& op) {
+	const int n = static_cast<int>(state.range(0));
+	auto s = make(n);
+	for (int i = 1; i <= n; i += 3) {
+		s.Set(i, true);
+	}
+	for (auto _: state) {
+		// Unaligned bounds to include the partial words
+		op(s, 3, n - 3);
+	}
+	state.SetItemsProcessed(state.iterations() * n);
+}
+
+#define BENCHMARK_SWITCH_RANGE(fn) BENCHMARK(fn)->Arg(1000)->Arg(5000)->Arg(100000)
+
+static void BM_SwitchSetRangeN(benchmark::State& state) {
+	bool val = false;
+	BM_SwitchRangeOpN(state, [&val](auto& s, int first, int last) { s.SetRange(first, last, val); val = !val; });
+}
+
+BENCHMARK_SWITCH_RANGE(BM_SwitchSetRangeN);
+
+static void BM_SwitchFlipRangeN(benchmark::State& state) {
+	BM_SwitchRangeOpN(state, [](auto& s, int first, int last) { s.FlipRange(first, last); });
+}
+
+BENCHMARK_SWITCH_RANGE(BM_SwitchFlipRangeN);
+
+static void BM_SwitchCountRangeN(benchmark::State& state) {
+	volatile int x = 0;
+	BM_SwitchRangeOpN(state, [&x](auto& s, int first, int last) { x = s.CountRange(first, last); });
+}
+
+BENCHMARK_SWITCH_RANGE(BM_SwitchCountRangeN);
+
+static void BM_SwitchGetAllN(benchmark::State& state) {
+	volatile int x = 0;
+	BM_SwitchRangeOpN(state, [&x](auto& s, int first, int last) {
+		int count = 0;
+		for (int i = first; i <= last; ++i) {
+			count += s.GetInt(i);
+		}
+		x = count;
+	});
+}
+
+BENCHMARK_SWITCH_RANGE(BM_SwitchGetAllN);
+
 
 BENCHMARK_MAIN();
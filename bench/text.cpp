@@ -24,6 +24,17 @@ static void BM_TextDrawStrSystem(benchmark::State& state) {
 
 BENCHMARK(BM_TextDrawStrSystem);
 
+static void BM_BitmapTextDrawCached(benchmark::State& state) {
+	Bitmap::SetFormat(format_R8G8B8A8_a().format());
+	auto surface = Bitmap::Create(width, height);
+
+	for (auto _: state) {
+		surface->TextDraw(0, 0, 0, text);
+	}
+}
+
+BENCHMARK(BM_BitmapTextDrawCached);
+
 static void BM_TextDrawStrColor(benchmark::State& state) {
 	Bitmap::SetFormat(format_R8G8B8A8_a().format());
 	auto font = Font::Default();
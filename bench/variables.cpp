@@ -124,4 +124,64 @@ static void BM_VariableSetRangeRandom(benchmark::State& state) {
 
 BENCHMARK(BM_VariableSetRangeRandom);
 
+template <typename F>
+static void BM_VariableRangeOp(benchmark::State& state, F&& op) {
+	const int n = static_cast<int>(state.range(0));
+	auto v = make(n * 2);
+	for (int i = 1; i <= n * 2; ++i) {
+		v.Set(i, (i * 7919) % 20001 - 10000);
+	}
+	for (auto _: state) {
+		op(v, n);
+	}
+	state.SetItemsProcessed(state.iterations() * n);
+}
+
+#define BENCHMARK_VARIABLE_RANGE(fn) BENCHMARK(fn)->Arg(1000)->Arg(10000)->Arg(100000)
+
+static void BM_VariableAddRangeN(benchmark::State& state) {
+	BM_VariableRangeOp(state, [](auto& v, int n) { v.AddRange(1, n, 1); });
+}
+
+BENCHMARK_VARIABLE_RANGE(BM_VariableAddRangeN);
+
+static void BM_VariableMultRangeN(benchmark::State& state) {
+	BM_VariableRangeOp(state, [](auto& v, int n) { v.MultRange(1, n, 3); });
+}
+
+BENCHMARK_VARIABLE_RANGE(BM_VariableMultRangeN);
+
+static void BM_VariableBitXorRangeVariableN(benchmark::State& state) {
+	BM_VariableRangeOp(state, [](auto& v, int n) { v.BitXorRangeVariable(1, n, n + 1); });
+}
+
+BENCHMARK_VARIABLE_RANGE(BM_VariableBitXorRangeVariableN);
+
+static void BM_VariableAddArrayN(benchmark::State& state) {
+	BM_VariableRangeOp(state, [](auto& v, int n) { v.AddArray(1, n, n + 1); });
+}
+
+BENCHMARK_VARIABLE_RANGE(BM_VariableAddArrayN);
+
+static void BM_VariableMultArrayN(benchmark::State& state) {
+	BM_VariableRangeOp(state, [](auto& v, int n) { v.MultArray(1, n, n + 1); });
+}
+
+BENCHMARK_VARIABLE_RANGE(BM_VariableMultArrayN);
+
+static void BM_VariableSortRangeN(benchmark::State& state) {
+	BM_VariableRangeOp(state, [](auto& v, int n) {
+		v.SetArray(1, n, n + 1);
+		v.SortRange(1, n, true);
+	});
+}
+
+BENCHMARK_VARIABLE_RANGE(BM_VariableSortRangeN);
+
+static void BM_VariableShuffleRangeN(benchmark::State& state) {
+	BM_VariableRangeOp(state, [](auto& v, int n) { v.ShuffleRange(1, n); });
+}
+
+BENCHMARK_VARIABLE_RANGE(BM_VariableShuffleRangeN);
+
 BENCHMARK_MAIN();
@@ -0,0 +1,260 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Headers
+#include "audio_decoder_streamed.h"
+
+#ifdef SUPPORT_THREADS
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace {
+	/** Bytes decoded per call into the wrapped decoder */
+	constexpr size_t chunk_size = 4096;
+}
+
+AudioDecoderStreamed::AudioDecoderStreamed(std::unique_ptr<AudioDecoderBase> decoder, std::chrono::milliseconds buffer_time) :
+	stream(std::make_shared<Stream>()) {
+	assert(decoder);
+
+	decoder->GetFormat(frequency, format, channels);
+	music_type = decoder->GetType();
+
+	stream->frame_size = GetSamplesizeForFormat(format) * channels;
+	stream->chunk.resize(chunk_size - chunk_size % stream->frame_size);
+
+	size_t frames = static_cast<size_t>(frequency) * buffer_time.count() / 1000;
+	stream->buffer.resize(std::max<size_t>(frames * stream->frame_size, stream->chunk.size()));
+
+	stream->pitch = decoder->GetPitch();
+	pitch_supported = decoder->SetPitch(stream->pitch);
+	stream->played.ticks = decoder->GetTicks();
+	stream->played.loop_count = decoder->GetLoopCount();
+	stream->decoder = std::move(decoder);
+}
+
+std::shared_ptr<AudioDecoderStreamed::Stream> AudioDecoderStreamed::GetStream() const {
+	return stream;
+}
+
+bool AudioDecoderStreamed::Stream::Fill() {
+	std::lock_guard<std::mutex> decoder_lock(decoder_mutex);
+	ApplyPitch();
+
+	bool decoded = false;
+	for (;;) {
+		size_t len;
+		{
+			std::lock_guard<std::mutex> buffer_lock(buffer_mutex);
+			if (finished) {
+				break;
+			}
+			len = std::min(buffer.size() - size, chunk.size());
+		}
+		len -= len % frame_size;
+		if (len == 0) {
+			break;
+		}
+
+		// Decoding happens outside of the buffer lock, the audio thread can read meanwhile
+		int read = decoder->Decode(chunk.data(), static_cast<int>(len));
+		bool at_end = read <= 0 || decoder->IsFinished();
+		int ticks = decoder->GetTicks();
+		int loops = decoder->GetLoopCount();
+
+		std::lock_guard<std::mutex> buffer_lock(buffer_mutex);
+		if (read > 0) {
+			size_t write_pos = (read_pos + size) % buffer.size();
+			size_t first = std::min(static_cast<size_t>(read), buffer.size() - write_pos);
+			memcpy(&buffer[write_pos], chunk.data(), first);
+			memcpy(buffer.data(), chunk.data() + first, read - first);
+			size += read;
+			AddPosition(read, ticks, loops);
+			decoded = true;
+		}
+		finished = at_end;
+	}
+
+	return decoded;
+}
+
+int AudioDecoderStreamed::Stream::Read(uint8_t* out, int out_size) {
+	std::lock_guard<std::mutex> buffer_lock(buffer_mutex);
+
+	size_t len = std::min(size, static_cast<size_t>(out_size));
+	size_t first = std::min(len, buffer.size() - read_pos);
+	memcpy(out, &buffer[read_pos], first);
+	memcpy(out + first, buffer.data(), len - first);
+	read_pos = (read_pos + len) % buffer.size();
+	size -= len;
+
+	consumed += len;
+	while (!positions.empty() && positions.front().end <= consumed) {
+		played = positions.front();
+		positions.pop_front();
+	}
+
+	return static_cast<int>(len);
+}
+
+void AudioDecoderStreamed::Stream::Flush(int ticks) {
+	std::lock_guard<std::mutex> buffer_lock(buffer_mutex);
+	read_pos = 0;
+	size = 0;
+	finished = false;
+	positions.clear();
+	played.ticks = ticks;
+	played.end = consumed;
+}
+
+void AudioDecoderStreamed::Stream::ApplyPitch() {
+	int new_pitch;
+	{
+		std::lock_guard<std::mutex> buffer_lock(buffer_mutex);
+		if (!pitch_changed) {
+			return;
+		}
+		pitch_changed = false;
+		new_pitch = pitch;
+	}
+	decoder->SetPitch(new_pitch);
+}
+
+void AudioDecoderStreamed::Stream::AddPosition(int size, int ticks, int loop_count) {
+	uint64_t end = (positions.empty() ? played.end : positions.back().end) + size;
+	positions.push_back({ end, ticks, loop_count });
+}
+
+bool AudioDecoderStreamed::Open(Filesystem_Stream::InputStream) {
+	error_message = "AudioDecoderStreamed: Wrapped decoder is already open";
+	return false;
+}
+
+int AudioDecoderStreamed::FillBuffer(uint8_t* buffer, int size) {
+	int read = stream->Read(buffer, size);
+	if (read == size) {
+		return read;
+	}
+
+	// Underrun: Decode directly when the worker is not using the decoder.
+	// Never wait here, this runs on the audio thread.
+	std::unique_lock<std::mutex> decoder_lock(stream->decoder_mutex, std::try_to_lock);
+	if (decoder_lock.owns_lock()) {
+		// The worker could have filled the buffer meanwhile
+		read += stream->Read(buffer + read, size - read);
+		if (read < size && !IsFinished()) {
+			stream->ApplyPitch();
+			int res = stream->decoder->Decode(buffer + read, size - read);
+			if (res > 0) {
+				read += res;
+			}
+			bool at_end = res <= 0 || stream->decoder->IsFinished();
+			int ticks = stream->decoder->GetTicks();
+			int loops = stream->decoder->GetLoopCount();
+
+			// The buffer is empty, the data is played directly
+			std::lock_guard<std::mutex> buffer_lock(stream->buffer_mutex);
+			if (res > 0) {
+				stream->AddPosition(res, ticks, loops);
+				stream->consumed += res;
+				stream->played = stream->positions.back();
+				stream->positions.clear();
+			}
+			stream->finished = at_end;
+		}
+		return read;
+	}
+
+	if (IsFinished()) {
+		return read;
+	}
+
+	// The worker is busy: Output silence instead of stalling the audio thread
+	memset(buffer + read, '\0', size - read);
+	return size;
+}
+
+bool AudioDecoderStreamed::Seek(std::streamoff offset, std::ios_base::seekdir origin) {
+	std::lock_guard<std::mutex> decoder_lock(stream->decoder_mutex);
+	bool res = stream->decoder->Seek(offset, origin);
+	stream->Flush(stream->decoder->GetTicks());
+	return res;
+}
+
+bool AudioDecoderStreamed::IsFinished() const {
+	std::lock_guard<std::mutex> buffer_lock(stream->buffer_mutex);
+	return stream->finished && stream->size == 0;
+}
+
+void AudioDecoderStreamed::GetFormat(int& frequency, Format& format, int& channels) const {
+	frequency = this->frequency;
+	format = this->format;
+	channels = this->channels;
+}
+
+bool AudioDecoderStreamed::SetPitch(int pitch) {
+	if (!pitch_supported) {
+		return false;
+	}
+
+	// Called by the audio thread, must not wait for the worker
+	std::lock_guard<std::mutex> buffer_lock(stream->buffer_mutex);
+	stream->pitch = pitch;
+	stream->pitch_changed = true;
+	return true;
+}
+
+int AudioDecoderStreamed::GetPitch() const {
+	std::lock_guard<std::mutex> buffer_lock(stream->buffer_mutex);
+	return stream->pitch;
+}
+
+bool AudioDecoderStreamed::GetLooping() const {
+	std::lock_guard<std::mutex> decoder_lock(stream->decoder_mutex);
+	return stream->decoder->GetLooping();
+}
+
+void AudioDecoderStreamed::SetLooping(bool enable) {
+	std::lock_guard<std::mutex> decoder_lock(stream->decoder_mutex);
+	stream->decoder->SetLooping(enable);
+}
+
+int AudioDecoderStreamed::GetLoopCount() const {
+	// Called by the audio thread, must not wait for the worker
+	std::lock_guard<std::mutex> buffer_lock(stream->buffer_mutex);
+	return stream->played.loop_count;
+}
+
+int AudioDecoderStreamed::GetTicks() const {
+	std::lock_guard<std::mutex> buffer_lock(stream->buffer_mutex);
+
+	const auto& played = stream->played;
+	if (stream->positions.empty()) {
+		return played.ticks;
+	}
+
+	// Interpolate inside the chunk that is played, unless it contains the loop point
+	const auto& next = stream->positions.front();
+	if (next.loop_count != played.loop_count || next.ticks < played.ticks) {
+		return played.ticks;
+	}
+	return played.ticks + static_cast<int>(static_cast<int64_t>(next.ticks - played.ticks) * (stream->consumed - played.end) / (next.end - played.end));
+}
+
+#endif
@@ -0,0 +1,170 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EP_AUDIO_DECODER_STREAMED_H
+#define EP_AUDIO_DECODER_STREAMED_H
+
+#include "system.h"
+
+#ifdef SUPPORT_THREADS
+
+// Headers
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "audio_decoder.h"
+
+/**
+ * Wraps an opened decoder and decodes ahead into a ring buffer.
+ * The buffer is filled by a worker thread through the shared Stream, the
+ * audio thread only copies from the buffer. Looping of the wrapped decoder
+ * (and the Seek this requires) happens while decoding ahead, so the audio
+ * thread never has to wait for file access.
+ *
+ * Volume and fades are handled by this decoder and not forwarded.
+ */
+class AudioDecoderStreamed : public AudioDecoder {
+public:
+	/** Decode-ahead state shared between the audio thread and the worker */
+	class Stream {
+	public:
+		/**
+		 * Decodes until the buffer is full or the wrapped decoder finished.
+		 * Called by the worker thread.
+		 *
+		 * @return Whether any data was decoded
+		 */
+		bool Fill();
+
+	private:
+		friend class AudioDecoderStreamed;
+
+		/** Decoder position at the end of a decoded chunk */
+		struct Position {
+			/** Total bytes written to the buffer up to the end of the chunk */
+			uint64_t end = 0;
+			int ticks = 0;
+			int loop_count = 0;
+		};
+
+		/**
+		 * Copies buffered data.
+		 *
+		 * @return number of bytes copied
+		 */
+		int Read(uint8_t* out, int size);
+
+		/**
+		 * Discards the buffered data.
+		 *
+		 * @param ticks Position of the decoder after the flush
+		 */
+		void Flush(int ticks);
+
+		/** Applies a pitch change requested by SetPitch. Requires the decoder lock. */
+		void ApplyPitch();
+
+		/**
+		 * Records the position of the decoder after data was written.
+		 * Requires the buffer lock.
+		 */
+		void AddPosition(int size, int ticks, int loop_count);
+
+		/** Guards decoder and chunk */
+		std::mutex decoder_mutex;
+		std::unique_ptr<AudioDecoderBase> decoder;
+		std::vector<uint8_t> chunk;
+
+		/** Guards the ring buffer, the positions, finished and the pitch */
+		std::mutex buffer_mutex;
+		std::vector<uint8_t> buffer;
+		size_t read_pos = 0;
+		size_t size = 0;
+		bool finished = false;
+		/** Positions of the chunks in the buffer, the played position lags behind the decoder */
+		std::deque<Position> positions;
+		/** Position at the end of the last completely played chunk */
+		Position played;
+		/** Total bytes read from the buffer */
+		uint64_t consumed = 0;
+		/** Pitch requested by SetPitch, applied before the next decode */
+		int pitch = 100;
+		bool pitch_changed = false;
+
+		int frame_size = 1;
+	};
+
+	/**
+	 * Creates a streamed decoder.
+	 *
+	 * @param decoder Opened decoder with the final output format
+	 * @param buffer_time Amount of audio that is decoded ahead
+	 */
+	AudioDecoderStreamed(std::unique_ptr<AudioDecoderBase> decoder, std::chrono::milliseconds buffer_time);
+
+	/** @return decode-ahead state for registering at the worker thread */
+	std::shared_ptr<Stream> GetStream() const;
+
+	/**
+	 * The wrapped decoder is already opened.
+	 *
+	 * @return always false
+	 */
+	bool Open(Filesystem_Stream::InputStream stream) override;
+
+	/**
+	 * Seeks in the wrapped decoder and discards the buffered data.
+	 */
+	bool Seek(std::streamoff offset, std::ios_base::seekdir origin) override;
+
+	bool IsFinished() const override;
+	void GetFormat(int& frequency, Format& format, int& channels) const override;
+
+	/**
+	 * Forwards the pitch to the wrapped decoder before it decodes again.
+	 * Does not wait for the worker. Already buffered data is played at the
+	 * old pitch.
+	 */
+	bool SetPitch(int pitch) override;
+	int GetPitch() const override;
+
+	bool GetLooping() const override;
+	void SetLooping(bool enable) override;
+
+	/**
+	 * @return loop count of the played data, not of the decoded ahead data.
+	 * Updated when a decoded chunk was played completely.
+	 */
+	int GetLoopCount() const override;
+
+	/** @return ticks of the played data, not of the decoded ahead data */
+	int GetTicks() const override;
+
+private:
+	int FillBuffer(uint8_t* buffer, int size) override;
+
+	std::shared_ptr<Stream> stream;
+	int frequency = 0;
+	Format format = Format::S16;
+	int channels = 0;
+	bool pitch_supported = false;
+};
+
+#endif
+
+#endif
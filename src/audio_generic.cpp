@@ -17,12 +17,179 @@
 
 #include "system.h"
 
+#include <algorithm>
 #include <cstring>
 #include <cassert>
 #include <memory>
 #include "audio_generic.h"
 #include "output.h"
 
+#ifdef SUPPORT_THREADS
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include "audio_decoder_streamed.h"
+#endif
+
+namespace {
+	using stats_clock = std::chrono::steady_clock;
+
+	/** Duration of the crossfade between two BGM and of the fade out on BGM stop */
+	constexpr std::chrono::milliseconds bgm_crossfade_time(50);
+
+	bool IsMidiFile(Filesystem_Stream::InputStream& stream) {
+		char magic[4] = { 0 };
+		if (!stream.ReadIntoObj(magic)) {
+			stream.clear();
+			stream.seekg(0, std::ios::beg);
+			return false;
+		}
+		stream.seekg(0, std::ios::beg);
+		return strncmp(magic, "MThd", 4) == 0;
+	}
+}
+
+#ifdef SUPPORT_THREADS
+/**
+ * Opens BGM and decodes ahead for all streamed BGM.
+ * File access and decoder creation happen here instead of on the main or
+ * on the audio thread.
+ */
+class GenericAudio::BgmWorker {
+public:
+	/** Amount of audio decoded ahead */
+	static constexpr std::chrono::milliseconds buffer_time = std::chrono::milliseconds(250);
+	/** How often the decode-ahead buffers are refilled */
+	static constexpr std::chrono::milliseconds refill_interval = std::chrono::milliseconds(20);
+
+	struct Result {
+		unsigned generation = 0;
+		/** nullptr when opening failed */
+		std::unique_ptr<AudioDecoderBase> decoder;
+	};
+
+	BgmWorker() : thread(&BgmWorker::Run, this) {}
+
+	~BgmWorker() {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stop = true;
+		}
+		cv.notify_one();
+		thread.join();
+	}
+
+	/**
+	 * Requests opening of a BGM. Replaces a request that was not processed yet.
+	 */
+	void RequestOpen(Filesystem_Stream::InputStream stream, unsigned generation, int pitch, const GenericAudio::Format& format) {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			request = Request{ std::move(stream), generation, pitch, format };
+		}
+		cv.notify_one();
+	}
+
+	/**
+	 * Takes the last opened BGM. Does not block, called by the audio thread.
+	 *
+	 * @return Whether a result was available
+	 */
+	bool TakeResult(Result& out) {
+		std::unique_lock<std::mutex> lock(mutex, std::try_to_lock);
+		if (!lock.owns_lock() || !result) {
+			return false;
+		}
+		out = std::move(*result);
+		result.reset();
+		return true;
+	}
+
+	/** @return Warnings of failed requests, must be reported by the main thread */
+	std::vector<std::string> TakeWarnings() {
+		std::lock_guard<std::mutex> lock(mutex);
+		return std::move(warnings);
+	}
+
+private:
+	struct Request {
+		Filesystem_Stream::InputStream stream;
+		unsigned generation;
+		int pitch;
+		GenericAudio::Format format;
+	};
+
+	void Run() {
+		std::unique_lock<std::mutex> lock(mutex);
+		while (!stop) {
+			if (request) {
+				Request req = std::move(*request);
+				request.reset();
+				lock.unlock();
+				Result res = Open(req);
+				lock.lock();
+				result = std::move(res);
+				continue;
+			}
+
+			auto active = streams;
+			lock.unlock();
+			for (auto& weak_stream : active) {
+				if (auto stream = weak_stream.lock()) {
+					stream->Fill();
+				}
+			}
+			lock.lock();
+
+			streams.erase(std::remove_if(streams.begin(), streams.end(), [](const auto& weak_stream) {
+				return weak_stream.expired();
+			}), streams.end());
+
+			cv.wait_for(lock, refill_interval, [this]() { return stop || request.has_value(); });
+		}
+	}
+
+	Result Open(Request& req) {
+		Result res;
+		res.generation = req.generation;
+
+		std::string name = ToString(req.stream.GetName());
+		auto decoder = AudioDecoder::Create(req.stream);
+		if (!decoder || !decoder->Open(std::move(req.stream))) {
+			std::lock_guard<std::mutex> lock(mutex);
+			warnings.push_back(fmt::format("Couldn't play BGM {}. Format not supported", name));
+			return res;
+		}
+
+		decoder->SetPitch(req.pitch);
+		decoder->SetFormat(req.format.frequency, req.format.format, req.format.channels);
+		decoder->SetLooping(true);
+
+		auto streamed = std::make_unique<AudioDecoderStreamed>(std::move(decoder), buffer_time);
+		auto stream = streamed->GetStream();
+		stream->Fill();
+
+		std::lock_guard<std::mutex> lock(mutex);
+		streams.push_back(stream);
+		res.decoder = std::move(streamed);
+		return res;
+	}
+
+	std::mutex mutex;
+	std::condition_variable cv;
+	bool stop = false;
+	std::optional<Request> request;
+	std::optional<Result> result;
+	std::vector<std::string> warnings;
+	std::vector<std::weak_ptr<AudioDecoderStreamed::Stream>> streams;
+	/** Declared last: Starts running in the constructor */
+	std::thread thread;
+};
+#else
+class GenericAudio::BgmWorker {};
+#endif
+
 GenericAudio::GenericAudio(const Game_ConfigAudio& cfg) : AudioInterface(cfg) {
 	int i = 0;
 	for (auto& BGM_Channel : BGM_Channels) {
@@ -44,26 +211,67 @@ GenericAudio::GenericAudio(const Game_ConfigAudio& cfg) : AudioInterface(cfg) {
 	SetFormat(12345, AudioDecoder::Format::S8, 1);
 }
 
+GenericAudio::~GenericAudio() = default;
+
 void GenericAudio::BGM_Play(Filesystem_Stream::InputStream stream, int volume, int pitch, int fadein) {
 	if (!stream) {
 		Output::Warning("Couldn't play BGM {}: File not readable", stream.GetName());
 		return;
 	}
 
-	for (auto& BGM_Channel : BGM_Channels) {
-		BGM_Channel.stopped = true; //Stop all running background music
-		if (!BGM_Channel.IsUsed()) {
-			// If there is an unused bgm channel
-			LockMutex();
-			BGM_PlayedOnceIndicator = false;
-			UnlockMutex();
-			PlayOnChannel(BGM_Channel, std::move(stream), volume, pitch, fadein);
-			return;
+#ifdef SUPPORT_THREADS
+	// MIDI is opened synchronously: It can use the exclusive Midi out device
+	if (bgm_async_open && !IsMidiFile(stream)) {
+		if (!bgm_worker) {
+			bgm_worker = std::make_unique<BgmWorker>();
+		}
+
+		LockMutex();
+		for (auto& BGM_Channel : BGM_Channels) {
+			if (BGM_Channel.midi_out_used) {
+				BGM_Channel.Stop();
+			} else {
+				// Keeps playing until the new BGM is ready, then crossfades
+				BGM_Channel.stopped = true;
+			}
+		}
+		BGM_PlayedOnceIndicator = false;
+
+		unsigned generation = pending_bgm.generation + 1;
+		pending_bgm = {};
+		pending_bgm.active = true;
+		pending_bgm.generation = generation;
+		pending_bgm.volume = volume;
+		pending_bgm.pitch = pitch;
+		pending_bgm.open_pitch = pitch;
+		pending_bgm.fadein = fadein;
+		UnlockMutex();
+
+		bgm_worker->RequestOpen(std::move(stream), generation, pitch, output_format);
+		return;
+	}
+#endif
+
+	LockMutex();
+	pending_bgm.active = false;
+	BGM_PlayedOnceIndicator = false;
+	if (Audio().GetNativeMidiEnabled() && IsMidiFile(stream)) {
+		// Midi out is only available on the first channel, it cannot wait for a crossfade
+		for (auto& BGM_Channel : BGM_Channels) {
+			BGM_Channel.Stop();
 		}
 	}
+	BgmChannel& BGM_Channel = FadeOutAndGetFreeBgmChannel();
+	UnlockMutex();
+
+	PlayOnChannel(BGM_Channel, std::move(stream), volume, pitch, fadein);
 }
 
 void GenericAudio::BGM_Pause() {
+	LockMutex();
+	pending_bgm.paused = true;
+	UnlockMutex();
+
 	for (auto& BGM_Channel : BGM_Channels) {
 		if (BGM_Channel.IsUsed()) {
 			BGM_Channel.SetPaused(true);
@@ -72,6 +280,10 @@ void GenericAudio::BGM_Pause() {
 }
 
 void GenericAudio::BGM_Resume() {
+	LockMutex();
+	pending_bgm.paused = false;
+	UnlockMutex();
+
 	for (auto& BGM_Channel : BGM_Channels) {
 		if (BGM_Channel.IsUsed()) {
 			BGM_Channel.SetPaused(false);
@@ -81,6 +293,7 @@ void GenericAudio::BGM_Resume() {
 
 void GenericAudio::BGM_Stop() {
 	LockMutex();
+	pending_bgm.active = false;
 	for (auto& BGM_Channel : BGM_Channels) {
 		BGM_Channel.Stop();
 	}
@@ -106,6 +319,13 @@ bool GenericAudio::BGM_PlayedOnce() const {
 }
 
 bool GenericAudio::BGM_IsPlaying() const {
+	LockMutex();
+	bool pending = pending_bgm.active;
+	UnlockMutex();
+
+	if (pending) {
+		return true;
+	}
 	for (auto& BGM_Channel : BGM_Channels) {
 		if (!BGM_Channel.stopped) {
 			return true;
@@ -118,6 +338,9 @@ int GenericAudio::BGM_GetTicks() const {
 	unsigned ticks = 0;
 	LockMutex();
 	for (auto& BGM_Channel : BGM_Channels) {
+		if (BGM_Channel.stopped) {
+			continue;
+		}
 		int cur_ticks = BGM_Channel.GetTicks();
 		if (cur_ticks >= 0) {
 			ticks = static_cast<unsigned>(cur_ticks);
@@ -129,24 +352,33 @@ int GenericAudio::BGM_GetTicks() const {
 
 void GenericAudio::BGM_Fade(int fade) {
 	LockMutex();
+	pending_bgm.fadeout = fade;
 	for (auto& BGM_Channel : BGM_Channels) {
-		BGM_Channel.SetFade(fade);
+		if (!BGM_Channel.stopped) {
+			BGM_Channel.SetFade(fade);
+		}
 	}
 	UnlockMutex();
 }
 
 void GenericAudio::BGM_Volume(int volume) {
 	LockMutex();
+	pending_bgm.volume = volume;
 	for (auto& BGM_Channel : BGM_Channels) {
-		BGM_Channel.SetVolume(volume);
+		if (!BGM_Channel.stopped) {
+			BGM_Channel.SetVolume(volume);
+		}
 	}
 	UnlockMutex();
 }
 
 void GenericAudio::BGM_Pitch(int pitch) {
 	LockMutex();
+	pending_bgm.pitch = pitch;
 	for (auto& BGM_Channel : BGM_Channels) {
-		BGM_Channel.SetPitch(pitch);
+		if (!BGM_Channel.stopped) {
+			BGM_Channel.SetPitch(pitch);
+		}
 	}
 	UnlockMutex();
 }
@@ -156,7 +388,7 @@ std::string GenericAudio::BGM_GetType() const {
 
 	LockMutex();
 	for (auto& BGM_Channel : BGM_Channels) {
-		if (BGM_Channel.IsUsed()) {
+		if (BGM_Channel.IsUsed() && !BGM_Channel.stopped) {
 			if (BGM_Channel.midi_out_used) {
 				type = "midi";
 				break;
@@ -195,7 +427,14 @@ void GenericAudio::SE_Stop() {
 }
 
 void GenericAudio::Update() {
-	// no-op, handled by the Decode function called through a thread
+	// Decoding is handled by the Decode function called through a thread
+#ifdef SUPPORT_THREADS
+	if (bgm_worker) {
+		for (const auto& warning: bgm_worker->TakeWarnings()) {
+			Output::Warning("{}", warning);
+		}
+	}
+#endif
 }
 
 GenericAudioMidiOut* GenericAudio::CreateAndGetMidiOut() {
@@ -211,6 +450,91 @@ GenericAudioMidiOut* GenericAudio::CreateAndGetMidiOut() {
 	return midi_thread.get();
 }
 
+void GenericAudio::SetDecodeStatsEnabled(bool enabled) {
+	decode_stats_enabled = enabled;
+}
+
+const GenericAudio::DecodeStats& GenericAudio::GetDecodeStats() const {
+	return decode_stats;
+}
+
+void GenericAudio::ResetDecodeStats() {
+	decode_stats = {};
+}
+
+void GenericAudio::SetBgmAsyncOpen(bool enabled) {
+	bgm_async_open = enabled;
+}
+
+int GenericAudio::GetCrossfadeFrames() const {
+	return static_cast<int>(static_cast<int64_t>(output_format.frequency) * bgm_crossfade_time.count() / 1000);
+}
+
+GenericAudio::BgmChannel& GenericAudio::FadeOutAndGetFreeBgmChannel() {
+	const int frames = GetCrossfadeFrames();
+
+	BgmChannel* free_channel = nullptr;
+	for (auto& BGM_Channel : BGM_Channels) {
+		if (BGM_Channel.IsUsed()) {
+			BGM_Channel.FadeOut(frames);
+		}
+		if (!free_channel && !BGM_Channel.IsUsed()) {
+			free_channel = &BGM_Channel;
+		}
+	}
+
+	if (!free_channel) {
+		// All channels are still fading out: Cut the quietest one
+		free_channel = &*std::min_element(std::begin(BGM_Channels), std::end(BGM_Channels), [](const auto& a, const auto& b) {
+			return a.ramp_gain < b.ramp_gain;
+		});
+		free_channel->Stop();
+	}
+
+	free_channel->FadeIn(frames);
+	return *free_channel;
+}
+
+void GenericAudio::StartPendingBgm() {
+#ifdef SUPPORT_THREADS
+	if (!bgm_worker) {
+		return;
+	}
+
+	BgmWorker::Result result;
+	if (!bgm_worker->TakeResult(result)) {
+		return;
+	}
+
+	if (!pending_bgm.active || result.generation != pending_bgm.generation) {
+		// Superseded by another BGM_Play or BGM_Stop
+		return;
+	}
+	pending_bgm.active = false;
+
+	BgmChannel& chan = FadeOutAndGetFreeBgmChannel();
+	if (!result.decoder) {
+		// Opening failed, the warning is reported by Update
+		return;
+	}
+
+	chan.decoder = std::move(result.decoder);
+	chan.midi_out_used = false;
+	chan.stopped = false;
+	chan.paused = pending_bgm.paused;
+
+	if (pending_bgm.pitch != pending_bgm.open_pitch) {
+		// Deferred by the streamed decoder until the worker decodes again, does not block
+		chan.decoder->SetPitch(pending_bgm.pitch);
+	}
+	chan.decoder->SetVolume(0);
+	chan.decoder->SetFade(pending_bgm.volume, std::chrono::milliseconds(pending_bgm.fadein));
+	if (pending_bgm.fadeout >= 0) {
+		chan.decoder->SetFade(0, std::chrono::milliseconds(pending_bgm.fadeout));
+	}
+#endif
+}
+
 void GenericAudio::SetFormat(int frequency, AudioDecoder::Format format, int channels) {
 	output_format.frequency = frequency;
 	output_format.format = format;
@@ -297,6 +621,29 @@ void GenericAudio::Decode(uint8_t* output_buffer, int buffer_length) {
 
 	assert(buffer_length > 0);
 
+	stats_clock::time_point decode_start;
+	std::chrono::nanoseconds decoder_time = {};
+	if (decode_stats_enabled) {
+		decode_start = stats_clock::now();
+	}
+
+	auto decode_channel = [&](AudioDecoderBase& decoder, unsigned bytes_to_read, bool is_bgm) {
+		if (!decode_stats_enabled) {
+			return decoder.Decode(scrap_buffer.data(), bytes_to_read);
+		}
+
+		auto start = stats_clock::now();
+		int read = decoder.Decode(scrap_buffer.data(), bytes_to_read);
+		auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(stats_clock::now() - start);
+		decoder_time += elapsed;
+
+		auto& stats = decode_stats.decoders[is_bgm ? decoder.GetType() : "se"];
+		stats.time += elapsed;
+		stats.calls++;
+		stats.bytes += std::max(read, 0);
+		return read;
+	};
+
 	if (sample_buffer.size() != (size_t)buffer_length) {
 		sample_buffer.resize(buffer_length);
 	}
@@ -309,6 +656,8 @@ void GenericAudio::Decode(uint8_t* output_buffer, int buffer_length) {
 	}
 	std::fill(mixer_buffer.begin(), mixer_buffer.end(), '\0');
 
+	StartPendingBgm();
+
 	for (unsigned i = 0; i < nr_of_bgm_channels + nr_of_se_channels; i++) {
 		int read_bytes = 0;
 		int channels = 0;
@@ -320,15 +669,18 @@ void GenericAudio::Decode(uint8_t* output_buffer, int buffer_length) {
 		// Mix BGM and SE together;
 		bool is_bgm_channel = i < nr_of_bgm_channels;
 		bool channel_used = false;
+		BgmChannel* ramp_channel = nullptr;
 
 		if (is_bgm_channel) {
 			BgmChannel& currently_mixed_channel = BGM_Channels[i];
 			float current_master_volume = cfg.music_volume.Get() / 100.0f;
 
 			if (currently_mixed_channel.decoder && !currently_mixed_channel.paused) {
-				if (currently_mixed_channel.stopped) {
+				// Stopped channels keep playing while fading out or until a pending BGM replaces them
+				if (currently_mixed_channel.stopped && currently_mixed_channel.ramp_step >= 0.0f && !pending_bgm.active) {
 					currently_mixed_channel.decoder.reset();
 				} else {
+					ramp_channel = &currently_mixed_channel;
 					currently_mixed_channel.decoder->Update(std::chrono::microseconds(1000 * 1000 / 60));
 					volume = current_master_volume * (currently_mixed_channel.decoder->GetVolume() / 100.0);
 					currently_mixed_channel.decoder->GetFormat(frequency, sampleformat, channels);
@@ -340,7 +692,7 @@ void GenericAudio::Decode(uint8_t* output_buffer, int buffer_length) {
 					unsigned bytes_to_read = (samplesize * channels * samples_per_frame);
 					bytes_to_read = (bytes_to_read < scrap_buffer_size) ? bytes_to_read : scrap_buffer_size;
 
-					read_bytes = currently_mixed_channel.decoder->Decode(scrap_buffer.data(), bytes_to_read);
+					read_bytes = decode_channel(*currently_mixed_channel.decoder, bytes_to_read, true);
 
 					if (read_bytes <= 0) {
 						// An error occured when reading - the channel is faulty - discard
@@ -373,7 +725,7 @@ void GenericAudio::Decode(uint8_t* output_buffer, int buffer_length) {
 					unsigned bytes_to_read = (samplesize * channels * samples_per_frame);
 					bytes_to_read = (bytes_to_read < scrap_buffer_size) ? bytes_to_read : scrap_buffer_size;
 
-					read_bytes = currently_mixed_channel.decoder->Decode(scrap_buffer.data(), bytes_to_read);
+					read_bytes = decode_channel(*currently_mixed_channel.decoder, bytes_to_read, false);
 
 					if (read_bytes <= 0) {
 						// An error occured when reading - the channel is faulty - discard
@@ -397,11 +749,18 @@ void GenericAudio::Decode(uint8_t* output_buffer, int buffer_length) {
 		//--------------------------------------------------------------------------------------------------------------------//
 
 		if (channel_used) {
+			float ramp_gain = ramp_channel ? ramp_channel->ramp_gain : 1.0f;
+			const float ramp_step = ramp_channel ? ramp_channel->ramp_step : 0.0f;
+
 			for (unsigned ii = 0; ii < (unsigned)(read_bytes / (samplesize * channels)); ii++) {
 
-				float vall = volume;
+				float vall = volume * ramp_gain;
 				float valr = vall;
 
+				if (ramp_step != 0.0f) {
+					ramp_gain = std::min(std::max(ramp_gain + ramp_step, 0.0f), 1.0f);
+				}
+
 				// Convert to floating point
 				switch (sampleformat) {
 					case AudioDecoder::Format::S8:
@@ -453,6 +812,18 @@ void GenericAudio::Decode(uint8_t* output_buffer, int buffer_length) {
 
 			}
 			channel_active = true;
+
+			if (ramp_channel) {
+				ramp_channel->ramp_gain = ramp_gain;
+				if (ramp_step < 0.0f && ramp_gain <= 0.0f) {
+					// Fade out finished
+					ramp_channel->decoder.reset();
+					ramp_channel->ramp_step = 0.0f;
+					ramp_channel->ramp_gain = 1.0f;
+				} else if (ramp_step > 0.0f && ramp_gain >= 1.0f) {
+					ramp_channel->ramp_step = 0.0f;
+				}
+			}
 		}
 	}
 
@@ -481,10 +852,19 @@ void GenericAudio::Decode(uint8_t* output_buffer, int buffer_length) {
 	} else {
 		memset(output_buffer, '\0', buffer_length);
 	}
+
+	if (decode_stats_enabled) {
+		auto total = std::chrono::duration_cast<std::chrono::nanoseconds>(stats_clock::now() - decode_start);
+		decode_stats.total_time += total;
+		decode_stats.mix_time += total - decoder_time;
+		decode_stats.calls++;
+	}
 }
 
 void GenericAudio::BgmChannel::Stop() {
 	stopped = true;
+	ramp_gain = 1.0f;
+	ramp_step = 0.0f;
 	if (midi_out_used) {
 		midi_out_used = false;
 		instance->midi_thread->GetMidiOut().Reset();
@@ -494,6 +874,28 @@ void GenericAudio::BgmChannel::Stop() {
 	}
 }
 
+void GenericAudio::BgmChannel::FadeOut(int frames) {
+	if (midi_out_used || !decoder || paused || frames <= 0) {
+		// Paused channels are not mixed and would never finish the fade
+		Stop();
+		return;
+	}
+
+	stopped = true;
+	// Continue from the current gain, a running faster fade out is kept
+	ramp_step = std::min(ramp_step, -1.0f / frames);
+}
+
+void GenericAudio::BgmChannel::FadeIn(int frames) {
+	if (frames <= 0) {
+		ramp_gain = 1.0f;
+		ramp_step = 0.0f;
+		return;
+	}
+	ramp_gain = 0.0f;
+	ramp_step = 1.0f / frames;
+}
+
 void GenericAudio::BgmChannel::SetPaused(bool newPaused) {
 	paused = newPaused;
 	if (midi_out_used) {
@@ -22,6 +22,8 @@
 #include "audio_secache.h"
 #include "audio_decoder_base.h"
 #include "audio_generic_midiout.h"
+#include <chrono>
+#include <map>
 #include <memory>
 
 /**
@@ -41,7 +43,7 @@
 class GenericAudio : public AudioInterface {
 public:
 	GenericAudio(const Game_ConfigAudio& cfg);
-	virtual ~GenericAudio() = default;
+	~GenericAudio() override;
 
 	void BGM_Play(Filesystem_Stream::InputStream stream, int volume, int pitch, int fadein) override;
 	void BGM_Pause() override;
@@ -70,6 +72,48 @@ public:
 
 	void Decode(uint8_t* output_buffer, int buffer_length);
 
+	/** Timing statistics of a decoder type */
+	struct DecoderStats {
+		std::chrono::nanoseconds time = {};
+		int calls = 0;
+		int64_t bytes = 0;
+	};
+
+	/** Timing statistics of the Decode function */
+	struct DecodeStats {
+		/** Time spent in the decoders, by decoder type ("se" for sound effects) */
+		std::map<std::string, DecoderStats> decoders;
+		/** Time spent in Decode outside of the decoders (mixing and conversion) */
+		std::chrono::nanoseconds mix_time = {};
+		std::chrono::nanoseconds total_time = {};
+		int calls = 0;
+	};
+
+	/**
+	 * Enables collection of timing statistics in Decode.
+	 * Disabled by default because it adds clock queries to the audio thread.
+	 *
+	 * @param enabled Whether to collect statistics
+	 */
+	void SetDecodeStatsEnabled(bool enabled);
+
+	/** @return collected timing statistics */
+	const DecodeStats& GetDecodeStats() const;
+
+	/** Clears the collected timing statistics */
+	void ResetDecodeStats();
+
+	/**
+	 * Enables opening of BGM on a worker thread. The BGM starts in a later
+	 * Decode call once the decoder is ready and is decoded ahead so loops
+	 * never seek on the audio thread.
+	 * Enabled by default on platforms with thread support. Disable it when
+	 * Decode must be deterministic.
+	 *
+	 * @param enabled Whether to open BGM asynchronously
+	 */
+	void SetBgmAsyncOpen(bool enabled);
+
 private:
 	struct BgmChannel {
 		int id;
@@ -78,7 +122,13 @@ private:
 		bool paused;
 		bool stopped;
 		bool midi_out_used = false;
+		/** Crossfade gain applied on top of the decoder volume (0.0 - 1.0) */
+		float ramp_gain = 1.0f;
+		/** Change of ramp_gain per sample, the decoder is freed when a fade out reaches 0 */
+		float ramp_step = 0.0f;
 		void Stop();
+		void FadeOut(int frames);
+		void FadeIn(int frames);
 		void SetPaused(bool newPaused);
 		int GetTicks() const;
 		void SetFade(int fade);
@@ -103,6 +153,34 @@ private:
 	bool PlayOnChannel(BgmChannel& chan, Filesystem_Stream::InputStream stream, int volume, int pitch, int fadein);
 	bool PlayOnChannel(SeChannel& chan, std::unique_ptr<AudioSeCache> se, int volume, int pitch);
 
+	/**
+	 * Fades out the playing BGM and returns a channel for a new BGM.
+	 * Must be called with the mutex locked.
+	 */
+	BgmChannel& FadeOutAndGetFreeBgmChannel();
+	/** @return Amount of samples of a crossfade */
+	int GetCrossfadeFrames() const;
+	/** Starts a BGM opened by the worker thread. Called by Decode. */
+	void StartPendingBgm();
+
+	class BgmWorker;
+
+	/** Settings of a BGM that is opened by the worker, guarded by the mutex */
+	struct PendingBgm {
+		bool active = false;
+		unsigned generation = 0;
+		int volume = 0;
+		int pitch = 100;
+		/** Pitch passed to the worker */
+		int open_pitch = 100;
+		int fadein = 0;
+		/** Fade out requested while opening, -1 when none */
+		int fadeout = -1;
+		bool paused = false;
+	};
+	PendingBgm pending_bgm;
+	bool bgm_async_open = true;
+
 	static constexpr unsigned nr_of_se_channels = 31;
 	static constexpr unsigned nr_of_bgm_channels = 2;
 
@@ -115,7 +193,12 @@ private:
 	unsigned scrap_buffer_size = 0;
 	std::vector<float> mixer_buffer = {};
 
+	bool decode_stats_enabled = false;
+	DecodeStats decode_stats;
+
 	std::unique_ptr<GenericAudioMidiOut> midi_thread;
+	/** Declared last: The thread must be joined before the other members are destroyed */
+	std::unique_ptr<BgmWorker> bgm_worker;
 };
 
 #endif
@@ -0,0 +1,150 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Headers
+#include "audio_offline.h"
+#include "audio_secache.h"
+#include "game_clock.h"
+#include "output.h"
+#include "utils.h"
+
+OfflineAudio::OfflineAudio(const Game_ConfigAudio& cfg, int frequency, int block_frames) :
+	GenericAudio(cfg), frequency(frequency), block_frames(block_frames) {
+	if (this->block_frames <= 0) {
+		// Same granularity as the libretro audio callback
+		this->block_frames = frequency / Game_Clock::GetTargetGameFps();
+	}
+
+	SetFormat(frequency, AudioDecoder::Format::S16, 2);
+	// Rendering must not depend on the timing of the BGM worker
+	SetBgmAsyncOpen(false);
+	buffer.resize(this->block_frames * 2 * sizeof(int16_t));
+}
+
+void OfflineAudio::SetCapture(bool enabled) {
+	capture = enabled;
+}
+
+void OfflineAudio::Render(std::chrono::microseconds duration) {
+	const auto block_duration = std::chrono::microseconds(static_cast<int64_t>(block_frames) * 1000000 / frequency);
+	time += duration;
+
+	while (rendered + block_duration <= time) {
+		Decode(buffer.data(), static_cast<int>(buffer.size()));
+		rendered += block_duration;
+
+		if (capture) {
+			const auto* samples = reinterpret_cast<const int16_t*>(buffer.data());
+			captured.insert(captured.end(), samples, samples + buffer.size() / sizeof(int16_t));
+		}
+	}
+}
+
+void OfflineAudio::RunScript(Span<const Event> events, std::chrono::milliseconds length, const FilesystemView& fs) {
+	const auto start = time;
+
+	for (const auto& event: events) {
+		const auto at = start + event.time;
+		if (at > time) {
+			Render(at - time);
+		}
+		ExecuteEvent(event, fs);
+	}
+
+	if (start + length > time) {
+		Render(start + length - time);
+	}
+}
+
+void OfflineAudio::ExecuteEvent(const Event& event, const FilesystemView& fs) {
+	switch (event.type) {
+		case Event::Type::BgmPlay: {
+			auto stream = fs.OpenFile(event.file);
+			if (!stream) {
+				Output::Warning("OfflineAudio: BGM {} not found", event.file);
+				return;
+			}
+			BGM_Play(std::move(stream), event.volume, event.pitch, event.fade);
+			break;
+		}
+		case Event::Type::BgmStop:
+			BGM_Stop();
+			break;
+		case Event::Type::BgmFade:
+			BGM_Fade(event.fade);
+			break;
+		case Event::Type::SePlay: {
+			auto se = AudioSeCache::GetCachedSe(event.file);
+			if (!se) {
+				auto stream = fs.OpenFile(event.file);
+				if (!stream) {
+					Output::Warning("OfflineAudio: SE {} not found", event.file);
+					return;
+				}
+				se = AudioSeCache::Create(std::move(stream), event.file);
+			}
+			if (se) {
+				SE_Play(std::move(se), event.volume, event.pitch);
+			}
+			break;
+		}
+		case Event::Type::SeStop:
+			SE_Stop();
+			break;
+	}
+}
+
+std::chrono::microseconds OfflineAudio::GetTime() const {
+	return time;
+}
+
+bool OfflineAudio::WriteWav(std::ostream& os) const {
+	const uint32_t data_size = static_cast<uint32_t>(captured.size() * sizeof(int16_t));
+	const uint16_t channels = 2;
+	const uint16_t bits = 16;
+	const uint32_t byte_rate = frequency * channels * bits / 8;
+	const uint16_t block_align = channels * bits / 8;
+
+	// WAV is little endian
+	auto write32 = [&os](uint32_t v) {
+		Utils::SwapByteOrder(v);
+		os.write(reinterpret_cast<const char*>(&v), sizeof(v));
+	};
+	auto write16 = [&os](uint16_t v) {
+		Utils::SwapByteOrder(v);
+		os.write(reinterpret_cast<const char*>(&v), sizeof(v));
+	};
+
+	os.write("RIFF", 4);
+	write32(36 + data_size);
+	os.write("WAVEfmt ", 8);
+	write32(16);
+	write16(1); // PCM
+	write16(channels);
+	write32(frequency);
+	write32(byte_rate);
+	write16(block_align);
+	write16(bits);
+	os.write("data", 4);
+	write32(data_size);
+
+	for (auto sample: captured) {
+		write16(static_cast<uint16_t>(sample));
+	}
+
+	return os.good();
+}
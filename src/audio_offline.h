@@ -0,0 +1,119 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EP_AUDIO_OFFLINE_H
+#define EP_AUDIO_OFFLINE_H
+
+// Headers
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "audio_generic.h"
+#include "filesystem.h"
+#include "span.h"
+
+/**
+ * GenericAudio implementation without an audio device.
+ * Decode is driven by a fake clock instead of an audio callback, the output
+ * is discarded or captured for writing a WAV file.
+ * Used to measure decoder and mixer performance without sound hardware.
+ */
+class OfflineAudio : public GenericAudio {
+public:
+	/** A scripted audio command */
+	struct Event {
+		enum class Type {
+			BgmPlay,
+			BgmStop,
+			BgmFade,
+			SePlay,
+			SeStop
+		};
+
+		/** Time relative to the start of the script */
+		std::chrono::milliseconds time;
+		Type type;
+		/** File to play, relative to the filesystem passed to RunScript */
+		std::string file;
+		int volume = 100;
+		int pitch = 100;
+		/** Fade in (BgmPlay) or fade out (BgmFade) in ms */
+		int fade = 0;
+	};
+
+	/**
+	 * @param cfg Audio configuration
+	 * @param frequency Output frequency, the format is always S16 stereo
+	 * @param block_frames Frames rendered per Decode call, 0 for one logical frame
+	 */
+	OfflineAudio(const Game_ConfigAudio& cfg, int frequency = 44100, int block_frames = 0);
+
+	void LockMutex() const override {}
+	void UnlockMutex() const override {}
+
+	/**
+	 * Enables capturing of the rendered samples for WriteWav.
+	 * When disabled the output is discarded.
+	 *
+	 * @param enabled Whether to capture
+	 */
+	void SetCapture(bool enabled);
+
+	/**
+	 * Advances the fake clock and renders the audio of the elapsed time.
+	 * Rendering happens in whole blocks, the remainder is carried over.
+	 *
+	 * @param duration Time to render
+	 */
+	void Render(std::chrono::microseconds duration);
+
+	/**
+	 * Executes a list of events at their scheduled time and renders
+	 * until the end of the script.
+	 *
+	 * @param events Events sorted by time
+	 * @param length Total length to render
+	 * @param fs Filesystem used to open the event files
+	 */
+	void RunScript(Span<const Event> events, std::chrono::milliseconds length, const FilesystemView& fs);
+
+	/** @return Time rendered so far */
+	std::chrono::microseconds GetTime() const;
+
+	/**
+	 * Writes the captured samples as a 16 bit stereo WAV file.
+	 *
+	 * @param os Output stream
+	 * @return Whether writing succeeded
+	 */
+	bool WriteWav(std::ostream& os) const;
+
+private:
+	void ExecuteEvent(const Event& event, const FilesystemView& fs);
+
+	int frequency;
+	int block_frames;
+	bool capture = false;
+	std::chrono::microseconds time = {};
+	std::chrono::microseconds rendered = {};
+	std::vector<uint8_t> buffer;
+	std::vector<int16_t> captured;
+};
+
+#endif
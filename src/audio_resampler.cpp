@@ -215,6 +215,19 @@ AudioResampler::AudioResampler(std::unique_ptr<AudioDecoderBase> wrapped, AudioR
 				sampling_quality = SRC_SINC_BEST_QUALITY;
 				break;
 		}
+	#else
+		// Filter length of the built-in resampler
+		switch (quality) {
+			case Quality::Low:
+				sampling_quality = 16;
+				break;
+			case Quality::Medium:
+				sampling_quality = 32;
+				break;
+			case Quality::High:
+				sampling_quality = 64;
+				break;
+		}
 	#endif
 
 	finished = false;
@@ -260,6 +273,8 @@ bool AudioResampler::Open(Filesystem_Stream::InputStream stream) {
 			speex_resampler_skip_zeros(conversion_state);
 		#elif defined(HAVE_LIBSAMPLERATE)
 			conversion_state = src_new(sampling_quality, nr_of_channels, &lasterror);
+		#else
+			conversion_state = std::make_unique<AudioPolyphaseResampler>(nr_of_channels, sampling_quality);
 		#endif
 
 		//Init the conversion data structure
@@ -305,6 +320,8 @@ bool AudioResampler::Seek(std::streamoff offset, std::ios_base::seekdir origin)
 			speex_resampler_reset_mem(conversion_state);
 		#elif defined(HAVE_LIBSAMPLERATE)
 			src_reset(conversion_state);
+		#else
+			conversion_state->Reset();
 		#endif
 		return true;
 	}
@@ -360,9 +377,21 @@ bool AudioResampler::SetFormat(int freq, AudioDecoder::Format fmt, int channels)
 			break;
 	}
 	wrapped_decoder->SetFormat(input_rate, output_format, channels);
+	int old_nr_of_channels = nr_of_channels;
 	wrapped_decoder->GetFormat(input_rate, input_format, nr_of_channels);
 	output_rate = freq;
 
+	#if !defined(HAVE_LIBSPEEXDSP) && !defined(HAVE_LIBSAMPLERATE)
+		if (conversion_state && nr_of_channels != old_nr_of_channels) {
+			// The built-in resampler is bound to a channel count
+			conversion_state = std::make_unique<AudioPolyphaseResampler>(nr_of_channels, sampling_quality);
+			conversion_data.input_frames = 0;
+			conversion_data.input_frames_used = 0;
+		}
+	#else
+		(void)old_nr_of_channels;
+	#endif
+
 	mono_to_stereo_resample = false;
 	if (channels == 2 && nr_of_channels == 1) {
 		mono_to_stereo_resample = true;
@@ -604,6 +633,17 @@ int AudioResampler::FillBufferDifferentRate(uint8_t* buffer, int length) {
 				error_message = src_strerror(error);
 				return ERROR;
 			}
+		#else
+			if (pitch_handled_by_decoder) {
+				conversion_state->SetRate(input_rate, output_rate);
+			} else {
+				conversion_state->SetRate(input_rate * pitch, output_rate * STANDARD_PITCH);
+			}
+
+			conversion_data.input_frames_used = conversion_data.input_frames;
+			conversion_data.output_frames_gen = conversion_data.output_frames;
+			conversion_state->Process((float*)internal_buffer, conversion_data.input_frames_used, (float*)buffer, conversion_data.output_frames_gen);
+			(void)error;
 		#endif
 
 		total_output_frames -= conversion_data.output_frames_gen;
@@ -29,10 +29,13 @@
 #include <speex/speex_resampler.h>
 #elif defined(HAVE_LIBSAMPLERATE)
 #include <samplerate.h>
+#else
+#include "audio_resampler_polyphase.h"
 #endif
 
 /**
- * Audio resampler powered by Libspeexdsp or Libsamplerate
+ * Audio resampler powered by Libspeexdsp, Libsamplerate or the built-in
+ * polyphase resampler.
  * Wraps another decoder and provides resampling.
  */
 class AudioResampler : public AudioDecoderBase {
@@ -184,7 +187,7 @@ public:
 	 * Requests a certain frame format from the resampler.
 	 * Supported formats are:
 	 *  * float,int16_t for libspeexdsp
-	 *  * float for libsamplerate
+	 *  * float for libsamplerate and the built-in resampler
 	 * The channel setting is redirected to the wrapped decoder.
 	 * The frequency setting controls the resampler.
 	 *
@@ -256,6 +259,12 @@ private:
 	#elif defined(HAVE_LIBSAMPLERATE)
 		SRC_DATA conversion_data;
 		SRC_STATE * conversion_state = nullptr;
+	#else
+		struct {
+			uint32_t input_frames, output_frames;
+			uint32_t input_frames_used, output_frames_gen;
+		} conversion_data;
+		std::unique_ptr<AudioPolyphaseResampler> conversion_state;
 	#endif
 
 	/**
@@ -0,0 +1,257 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Headers
+#include "audio_resampler_polyphase.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <numeric>
+#include <tuple>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace {
+	/** Ratios with a reduced denominator up to this value get a table entry for every phase */
+	constexpr uint32_t max_exact_phases = 256;
+	/** Amount of phases of the table used for all other ratios */
+	constexpr int interpolated_phases = 256;
+	/** Passband relative to the Nyquist frequency */
+	constexpr double rolloff = 0.92;
+	constexpr double kaiser_beta = 8.0;
+	/** Downsampling widens the filter, this caps the growth */
+	constexpr int max_taps_factor = 4;
+
+	double BesselI0(double x) {
+		// Power series, converges quickly for the used beta
+		double sum = 1.0;
+		double term = 1.0;
+		const double half_x = x / 2.0;
+		for (int k = 1; k < 32; ++k) {
+			term *= half_x / k;
+			sum += term * term;
+			if (term * term < sum * 1e-12) {
+				break;
+			}
+		}
+		return sum;
+	}
+
+	std::shared_ptr<AudioPolyphaseResampler::FilterBank> BuildFilterBank(int taps, int phases, bool exact, double cutoff) {
+		auto bank = std::make_shared<AudioPolyphaseResampler::FilterBank>();
+		bank->taps = taps;
+		bank->phases = phases;
+		bank->exact = exact;
+		bank->coeffs.resize(static_cast<size_t>(phases + 1) * taps);
+
+		const int half = taps / 2;
+		const double i0_beta = BesselI0(kaiser_beta);
+
+		for (int p = 0; p <= phases; ++p) {
+			float* row = &bank->coeffs[static_cast<size_t>(p) * taps];
+			double sum = 0.0;
+			for (int k = 0; k < taps; ++k) {
+				// Distance of this tap from the interpolated position
+				const double d = (k - (half - 1)) - static_cast<double>(p) / phases;
+				const double x = d * cutoff;
+				const double sinc = (x == 0.0) ? 1.0 : std::sin(M_PI * x) / (M_PI * x);
+				const double w = d / half;
+				const double window = (std::abs(w) >= 1.0) ? 0.0 : BesselI0(kaiser_beta * std::sqrt(1.0 - w * w)) / i0_beta;
+				const double v = cutoff * sinc * window;
+				row[k] = static_cast<float>(v);
+				sum += v;
+			}
+			// Normalize for unity gain at DC
+			if (sum != 0.0) {
+				for (int k = 0; k < taps; ++k) {
+					row[k] = static_cast<float>(row[k] / sum);
+				}
+			}
+		}
+
+		return bank;
+	}
+
+	std::shared_ptr<const AudioPolyphaseResampler::FilterBank> GetFilterBank(uint32_t num, uint32_t den, int base_taps) {
+		int taps = base_taps;
+		double cutoff = rolloff;
+		if (num > den) {
+			// Downsampling: Lower the cutoff below the output Nyquist frequency and
+			// widen the filter to keep the transition band
+			taps = static_cast<int>((static_cast<uint64_t>(base_taps) * num + den - 1) / den);
+			taps = std::min((taps + 3) & ~3, base_taps * max_taps_factor);
+			cutoff = rolloff * den / num;
+		}
+
+		const bool exact = den <= max_exact_phases;
+		const int phases = exact ? static_cast<int>(den) : interpolated_phases;
+		// Cutoff is quantized so that pitch slides share tables
+		const int cutoff_key = static_cast<int>(cutoff * 1000.0);
+		cutoff = cutoff_key / 1000.0;
+
+		using Key = std::tuple<int, bool, int, int>;
+		static std::map<Key, std::weak_ptr<const AudioPolyphaseResampler::FilterBank>> cache;
+		static std::mutex cache_mutex;
+
+		std::lock_guard<std::mutex> lock(cache_mutex);
+
+		const Key key { phases, exact, taps, cutoff_key };
+		auto it = cache.find(key);
+		if (it != cache.end()) {
+			if (auto bank = it->second.lock()) {
+				return bank;
+			}
+		}
+
+		for (auto cit = cache.begin(); cit != cache.end();) {
+			if (cit->second.expired()) {
+				cit = cache.erase(cit);
+			} else {
+				++cit;
+			}
+		}
+
+		std::shared_ptr<const AudioPolyphaseResampler::FilterBank> bank = BuildFilterBank(taps, phases, exact, cutoff);
+		cache[key] = bank;
+		return bank;
+	}
+}
+
+AudioPolyphaseResampler::AudioPolyphaseResampler(int channels, int taps) :
+	channels(channels), taps(std::max(4, (taps + 3) & ~3)) {
+	assert(channels > 0);
+
+	bank = GetFilterBank(ratio_num, ratio_den, this->taps);
+	Reset();
+}
+
+void AudioPolyphaseResampler::SetRate(uint32_t num, uint32_t den) {
+	assert(num > 0 && den > 0);
+
+	const uint32_t g = std::gcd(num, den);
+	num /= g;
+	den /= g;
+
+	if (num == ratio_num && den == ratio_den) {
+		return;
+	}
+
+	frac = static_cast<uint32_t>(static_cast<uint64_t>(frac) * den / ratio_den);
+	ratio_num = num;
+	ratio_den = den;
+
+	const int old_half = bank->taps / 2;
+	bank = GetFilterBank(ratio_num, ratio_den, taps);
+
+	// Keep the filter centered on the same input frame
+	pos += old_half - bank->taps / 2;
+	if (pos < 0) {
+		history.insert(history.begin(), static_cast<size_t>(-pos) * channels, 0.0f);
+		pos = 0;
+	}
+}
+
+void AudioPolyphaseResampler::Reset() {
+	// Zero history in front of the first frame, it is the center of the first output
+	history.assign(static_cast<size_t>(bank->taps / 2 - 1) * channels, 0.0f);
+	pos = 0;
+	frac = 0;
+}
+
+template <int C>
+void AudioPolyphaseResampler::ProcessFrames(const float* src, int src_frames, float*& out, uint32_t& out_left) {
+	const int ch = (C > 0) ? C : channels;
+	const int n = bank->taps;
+	const float* coeffs = bank->coeffs.data();
+
+	if (!bank->exact) {
+		interp.resize(n);
+	}
+
+	while (out_left > 0 && pos + n <= src_frames) {
+		const float* h;
+		if (bank->exact) {
+			h = coeffs + static_cast<size_t>(frac) * n;
+		} else {
+			const uint64_t p = static_cast<uint64_t>(frac) * bank->phases;
+			const float* h0 = coeffs + static_cast<size_t>(p / ratio_den) * n;
+			const float* h1 = h0 + n;
+			const float w = static_cast<float>(p % ratio_den) / ratio_den;
+			for (int k = 0; k < n; ++k) {
+				interp[k] = h0[k] + (h1[k] - h0[k]) * w;
+			}
+			h = interp.data();
+		}
+
+		const float* x = src + static_cast<size_t>(pos) * ch;
+		for (int c = 0; c < ch; ++c) {
+			// Independent accumulators break the dependency chain, n is a multiple of 4
+			float acc0 = 0.0f, acc1 = 0.0f, acc2 = 0.0f, acc3 = 0.0f;
+			for (int k = 0; k < n; k += 4) {
+				acc0 += h[k] * x[k * ch + c];
+				acc1 += h[k + 1] * x[(k + 1) * ch + c];
+				acc2 += h[k + 2] * x[(k + 2) * ch + c];
+				acc3 += h[k + 3] * x[(k + 3) * ch + c];
+			}
+			*out++ = (acc0 + acc1) + (acc2 + acc3);
+		}
+		--out_left;
+
+		frac += ratio_num;
+		pos += frac / ratio_den;
+		frac %= ratio_den;
+	}
+}
+
+void AudioPolyphaseResampler::Process(const float* in, uint32_t& in_frames, float* out, uint32_t& out_frames) {
+	const int hist_frames = static_cast<int>(history.size()) / channels;
+	const int mem_frames = hist_frames + static_cast<int>(in_frames);
+
+	mem.resize(static_cast<size_t>(mem_frames) * channels);
+	std::copy(history.begin(), history.end(), mem.begin());
+	std::copy(in, in + static_cast<size_t>(in_frames) * channels, mem.begin() + history.size());
+
+	uint32_t out_left = out_frames;
+	switch (channels) {
+		case 1:
+			ProcessFrames<1>(mem.data(), mem_frames, out, out_left);
+			break;
+		case 2:
+			ProcessFrames<2>(mem.data(), mem_frames, out, out_left);
+			break;
+		default:
+			ProcessFrames<0>(mem.data(), mem_frames, out, out_left);
+			break;
+	}
+
+	int keep_end = mem_frames;
+	if (out_left == 0) {
+		// Output is full: Only consume what is needed for the next frame, the rest is returned to the caller
+		keep_end = std::max(hist_frames, std::min(mem_frames, pos + bank->taps));
+	}
+	const int keep_begin = std::min(pos, keep_end);
+
+	history.assign(mem.begin() + static_cast<size_t>(keep_begin) * channels, mem.begin() + static_cast<size_t>(keep_end) * channels);
+	pos -= keep_begin;
+
+	in_frames = static_cast<uint32_t>(keep_end - hist_frames);
+	out_frames -= out_left;
+}
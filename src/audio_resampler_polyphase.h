@@ -0,0 +1,100 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EP_AUDIO_RESAMPLER_POLYPHASE_H
+#define EP_AUDIO_RESAMPLER_POLYPHASE_H
+
+// Headers
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * Built-in polyphase windowed-sinc resampler.
+ * Used by AudioResampler when neither libspeexdsp nor libsamplerate are
+ * available. Operates on interleaved float frames.
+ *
+ * The conversion ratio is a fraction (input rate / output rate). When the
+ * reduced denominator is small (22050->44100, 32000->48000, common pitch
+ * steps) every phase of the filter is precomputed, otherwise a fixed amount
+ * of phases is precomputed and interpolated linearly.
+ * Filter tables are shared between all instances with the same parameters.
+ */
+class AudioPolyphaseResampler {
+public:
+	/**
+	 * Creates a resampler.
+	 *
+	 * @param channels Number of interleaved channels
+	 * @param taps Filter length per phase (multiple of 4). Higher is slower with better quality.
+	 */
+	AudioPolyphaseResampler(int channels, int taps);
+
+	/**
+	 * Sets the conversion ratio. The fraction is reduced internally.
+	 * The current phase is retained so the ratio can be changed while playing.
+	 *
+	 * @param num input rate
+	 * @param den output rate
+	 */
+	void SetRate(uint32_t num, uint32_t den);
+
+	/**
+	 * Clears the filter history, e.g. after a seek.
+	 */
+	void Reset();
+
+	/**
+	 * Resamples interleaved frames.
+	 *
+	 * @param in input frames
+	 * @param[inout] in_frames Number of input frames, filled with the amount of frames consumed
+	 * @param out output buffer
+	 * @param[inout] out_frames Capacity of the output buffer in frames, filled with the amount of frames written
+	 */
+	void Process(const float* in, uint32_t& in_frames, float* out, uint32_t& out_frames);
+
+	/** Filter table for one ratio and filter length */
+	struct FilterBank {
+		int taps = 0;
+		int phases = 0;
+		/** true: phase equals the fractional position, false: interpolate between phases */
+		bool exact = false;
+		/** phases + 1 rows of taps coefficients */
+		std::vector<float> coeffs;
+	};
+
+private:
+	template <int C>
+	void ProcessFrames(const float* src, int src_frames, float*& out, uint32_t& out_left);
+
+	int channels;
+	int taps;
+	uint32_t ratio_num = 1;
+	uint32_t ratio_den = 1;
+	/** fractional read position in units of 1/ratio_den */
+	uint32_t frac = 0;
+	/** frame index of the first filter tap relative to the start of history */
+	int pos = 0;
+
+	std::shared_ptr<const FilterBank> bank;
+	std::vector<float> history;
+	std::vector<float> mem;
+	std::vector<float> interp;
+};
+
+#endif
@@ -0,0 +1,300 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Headers
+#include "battle_simulator.h"
+#include <algorithm>
+#include <deque>
+#include <memory>
+#include <numeric>
+#include <ostream>
+#include <utility>
+#include <fmt/format.h>
+#include <lcf/data.h>
+#include <lcf/reader_util.h>
+#include "autobattle.h"
+#include "enemyai.h"
+#include "game_actor.h"
+#include "game_battlealgorithm.h"
+#include "game_enemy.h"
+#include "game_enemyparty.h"
+#include "game_party.h"
+#include "game_switches.h"
+#include "game_variables.h"
+#include "main_data.h"
+#include "output.h"
+#include "rand.h"
+#include "utils.h"
+
+namespace {
+	/** Action selection algorithms, indexed by their ID like in Scene_Battle */
+	struct Algorithms {
+		std::vector<std::unique_ptr<AutoBattle::AlgorithmBase>> autobattle;
+		std::vector<std::unique_ptr<EnemyAi::AlgorithmBase>> enemyai;
+		int default_autobattle = 0;
+		int default_enemyai = 0;
+	};
+
+	template <typename T>
+	int FindAlgorithm(const std::vector<std::unique_ptr<T>>& algos, const std::string& name, int db_default) {
+		if (name.empty()) {
+			return (db_default >= 0 && db_default < static_cast<int>(algos.size())) ? db_default : 0;
+		}
+		for (auto& algo : algos) {
+			if (Utils::StrICmp(algo->GetName(), name) == 0) {
+				return algo->GetId();
+			}
+		}
+		Output::Warning("BattleSimulator: Unknown algorithm {}, using {}", name, algos[0]->GetName());
+		return 0;
+	}
+
+	Algorithms CreateAlgorithms(const BattleSimulator::Config& config) {
+		Algorithms algos;
+		algos.autobattle.push_back(AutoBattle::CreateAlgorithm(AutoBattle::RpgRtCompat::name));
+		algos.autobattle.push_back(AutoBattle::CreateAlgorithm(AutoBattle::RpgRtImproved::name));
+		algos.autobattle.push_back(AutoBattle::CreateAlgorithm(AutoBattle::AttackOnly::name));
+		algos.enemyai.push_back(EnemyAi::CreateAlgorithm(EnemyAi::RpgRtCompat::name));
+		algos.enemyai.push_back(EnemyAi::CreateAlgorithm(EnemyAi::RpgRtImproved::name));
+
+		algos.default_autobattle = FindAlgorithm(algos.autobattle, config.autobattle_algo, lcf::Data::system.easyrpg_default_actorai);
+		algos.default_enemyai = FindAlgorithm(algos.enemyai, config.enemyai_algo, lcf::Data::system.easyrpg_default_enemyai);
+		return algos;
+	}
+
+	/** Same as Scene_Battle_Rpg2k::SelectNextActor with auto battle enabled */
+	void SelectActorAction(Game_Actor& actor, const Algorithms& algos) {
+		if (!actor.CanAct()) {
+			actor.SetBattleAlgorithm(std::make_shared<Game_BattleAlgorithm::None>(&actor));
+			return;
+		}
+
+		Game_Battler* random_target = nullptr;
+		switch (actor.GetSignificantRestriction()) {
+			case lcf::rpg::State::Restriction_attack_ally:
+				random_target = Main_Data::game_party->GetRandomActiveBattler();
+				break;
+			case lcf::rpg::State::Restriction_attack_enemy:
+				random_target = Main_Data::game_enemyparty->GetRandomActiveBattler();
+				break;
+			default:
+				break;
+		}
+
+		if (random_target) {
+			actor.SetBattleAlgorithm(std::make_shared<Game_BattleAlgorithm::Normal>(&actor, random_target));
+			return;
+		}
+
+		const int ai = actor.GetActorAi() == -1 ? algos.default_autobattle : actor.GetActorAi();
+		algos.autobattle[ai]->SetAutoBattleAction(actor);
+	}
+
+	/** Applies an action like the Scene_Battle_Rpg2k action states without messages and waits */
+	void ExecuteAction(Game_BattleAlgorithm::AlgorithmBase& action) {
+		auto* source = action.GetSource();
+		source->NextBattleTurn();
+		source->BattleStateHeal();
+		source->ApplyConditions();
+
+		if (action.GetType() != Game_BattleAlgorithm::Type::None) {
+			action.Start();
+			do {
+				action.Execute();
+				if (action.IsSuccess() && action.GetTarget()) {
+					action.ApplyAll();
+				} else {
+					action.ApplyCustomEffect();
+					action.ApplySwitchEffect();
+				}
+			} while (action.RepeatNext(true) || action.TargetNext());
+		}
+
+		action.ProcessPostActionSwitches();
+	}
+
+	/** Checks the end conditions in the order of Scene_Battle_Rpg2k::CheckBattleEndConditions */
+	bool CheckBattleEnd(BattleSimulator::RunResult& result) {
+		if (Game_Battle::CheckLose()) {
+			result.result = BattleResult::Defeat;
+			return true;
+		}
+		if (Game_Battle::CheckWin()) {
+			result.result = BattleResult::Victory;
+			return true;
+		}
+		return false;
+	}
+
+	BattleSimulator::TurnStats CalculateTurnStats(std::vector<int> turns) {
+		BattleSimulator::TurnStats stats;
+		if (turns.empty()) {
+			return stats;
+		}
+
+		std::sort(turns.begin(), turns.end());
+		stats.count = static_cast<int>(turns.size());
+		stats.min = turns.front();
+		stats.max = turns.back();
+		stats.median = turns[turns.size() / 2];
+		stats.mean = std::accumulate(turns.begin(), turns.end(), 0.0) / turns.size();
+		return stats;
+	}
+
+	void WriteTurnStats(std::ostream& os, const char* name, const BattleSimulator::TurnStats& stats) {
+		if (stats.count == 0) {
+			return;
+		}
+		os << fmt::format("{} turns: min {} / median {} / mean {:.2f} / max {}\n",
+				name, stats.min, stats.median, stats.mean, stats.max);
+	}
+
+	BattleSimulator::RunResult SimulateBattle(const BattleSimulator::Config& config, const Algorithms& algos, int32_t seed) {
+		Rand::SeedRandomNumberGenerator(seed);
+		Game_Battle::SetBattleCondition(config.condition);
+		Game_Battle::Init(config.troop_id, false);
+
+		BattleSimulator::RunResult result;
+		std::deque<Game_Battler*> battlers;
+
+		while (!CheckBattleEnd(result)) {
+			if (result.turns >= config.max_turns) {
+				result.result = BattleResult::Abort;
+				break;
+			}
+
+			++result.turns;
+			Main_Data::game_party->IncTurns();
+
+			battlers.clear();
+			for (auto* actor : Main_Data::game_party->GetActors()) {
+				SelectActorAction(*actor, algos);
+				battlers.push_back(actor);
+			}
+			for (auto* enemy : Main_Data::game_enemyparty->GetEnemies()) {
+				if (enemy->IsHidden()) {
+					continue;
+				}
+				Game_Battle::SelectEnemyAction(*enemy, algos.enemyai, algos.default_enemyai);
+				battlers.push_back(enemy);
+			}
+
+			Game_Battle::CreateExecutionOrder(battlers);
+
+			for (auto* battler : battlers) {
+				if (CheckBattleEnd(result)) {
+					break;
+				}
+				if (battler->Exists()) {
+					Game_Battle::PrepareBattleAction(battler);
+					// Keep the action alive, state changes during execution can replace it
+					auto action = battler->GetBattleAlgorithm();
+					if (action) {
+						ExecuteAction(*action);
+					}
+				}
+				battler->SetBattleAlgorithm(nullptr);
+			}
+
+			// Actions left over when the battle ended during the turn
+			for (auto* battler : battlers) {
+				battler->SetBattleAlgorithm(nullptr);
+			}
+		}
+
+		Game_Battle::Quit();
+		return result;
+	}
+}
+
+BattleSimulator::RunResult BattleSimulator::RunBattle(const Config& config, int32_t seed) {
+	return SimulateBattle(config, CreateAlgorithms(config), seed);
+}
+
+std::vector<BattleSimulator::RunResult> BattleSimulator::Run(const Config& config) {
+	// Snapshot of everything a battle can change outside of the troop
+	std::vector<std::pair<Game_Actor*, lcf::rpg::SaveActor>> actors;
+	for (auto* actor : Main_Data::game_party->GetActors()) {
+		actors.emplace_back(actor, actor->GetSaveData());
+	}
+	const auto inventory = Main_Data::game_party->GetSaveData();
+	const auto switches = Main_Data::game_switches->GetData();
+	const auto variables = Main_Data::game_variables->GetData();
+
+	auto restore = [&]() {
+		for (auto& actor : actors) {
+			actor.first->SetSaveData(actor.second);
+		}
+		Main_Data::game_party->SetupFromSave(inventory);
+		Main_Data::game_switches->SetData(switches);
+		Main_Data::game_variables->SetData(variables);
+	};
+
+	const auto algos = CreateAlgorithms(config);
+
+	std::vector<RunResult> results;
+	results.reserve(std::max(config.runs, 0));
+	for (int i = 0; i < config.runs; ++i) {
+		restore();
+		results.push_back(SimulateBattle(config, algos, config.seed + i));
+	}
+	restore();
+
+	return results;
+}
+
+BattleSimulator::Summary BattleSimulator::Summarize(Span<const RunResult> results) {
+	Summary summary;
+	std::vector<int> victory_turns;
+	std::vector<int> defeat_turns;
+
+	for (auto& result : results) {
+		++summary.runs;
+		switch (result.result) {
+			case BattleResult::Victory:
+				++summary.victories;
+				victory_turns.push_back(result.turns);
+				break;
+			case BattleResult::Defeat:
+				++summary.defeats;
+				defeat_turns.push_back(result.turns);
+				break;
+			default:
+				++summary.timeouts;
+				break;
+		}
+	}
+
+	summary.victory_turns = CalculateTurnStats(std::move(victory_turns));
+	summary.defeat_turns = CalculateTurnStats(std::move(defeat_turns));
+	return summary;
+}
+
+void BattleSimulator::WriteReport(std::ostream& os, const Config& config, const Summary& summary) {
+	auto percent = [&](int n) {
+		return summary.runs > 0 ? 100.0 * n / summary.runs : 0.0;
+	};
+
+	const auto* troop = lcf::ReaderUtil::GetElement(lcf::Data::troops, config.troop_id);
+	os << fmt::format("Troop {} ({}): {} battles, seed {}\n",
+			config.troop_id, troop ? ToString(troop->name) : std::string(), summary.runs, config.seed);
+	os << fmt::format("Victory: {} ({:.1f}%)\n", summary.victories, percent(summary.victories));
+	os << fmt::format("Defeat: {} ({:.1f}%)\n", summary.defeats, percent(summary.defeats));
+	os << fmt::format("Timeout after {} turns: {} ({:.1f}%)\n", config.max_turns, summary.timeouts, percent(summary.timeouts));
+	WriteTurnStats(os, "Victory", summary.victory_turns);
+	WriteTurnStats(os, "Defeat", summary.defeat_turns);
+}
@@ -0,0 +1,117 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EP_BATTLE_SIMULATOR_H
+#define EP_BATTLE_SIMULATOR_H
+
+// Headers
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+#include <lcf/rpg/system.h>
+#include "game_battle.h"
+#include "span.h"
+
+/**
+ * Runs battles of a troop against the current party without a scene.
+ * Actions are chosen by the AutoBattle and EnemyAi algorithms and executed
+ * through Game_BattleAlgorithm in the turn order of the RPG Maker 2000
+ * battle system. Messages, animations, waits and troop battle events are
+ * skipped.
+ */
+namespace BattleSimulator {
+	struct Config {
+		/** Troop to fight against */
+		int troop_id = 0;
+		/** Number of battles */
+		int runs = 100;
+		/** Seed of the first battle, battle N uses seed + N */
+		int32_t seed = 0;
+		/** Battles lasting longer are counted as timeout */
+		int max_turns = 100;
+		lcf::rpg::System::BattleCondition condition = lcf::rpg::System::BattleCondition_none;
+		/** AutoBattle algorithm of the party, empty for the database default */
+		std::string autobattle_algo;
+		/** EnemyAi algorithm of the troop, empty for the database default */
+		std::string enemyai_algo;
+	};
+
+	/** Outcome of one battle */
+	struct RunResult {
+		/** Victory, Defeat or Abort on timeout */
+		BattleResult result = BattleResult::Abort;
+		/** Number of turns started */
+		int turns = 0;
+	};
+
+	/** Turn count statistics of a set of battles */
+	struct TurnStats {
+		int count = 0;
+		int min = 0;
+		int max = 0;
+		int median = 0;
+		double mean = 0.0;
+	};
+
+	/** Aggregated outcome of all battles */
+	struct Summary {
+		int runs = 0;
+		int victories = 0;
+		int defeats = 0;
+		int timeouts = 0;
+		TurnStats victory_turns;
+		TurnStats defeat_turns;
+	};
+
+	/**
+	 * Simulates a single battle. The party is modified by the battle.
+	 *
+	 * @param config simulation settings
+	 * @param seed seed of the random number generator
+	 * @return outcome of the battle
+	 */
+	RunResult RunBattle(const Config& config, int32_t seed);
+
+	/**
+	 * Simulates config.runs battles. The party, inventory, switches and
+	 * variables are restored before every battle and after the last one.
+	 *
+	 * @param config simulation settings
+	 * @return outcome of every battle in order
+	 */
+	std::vector<RunResult> Run(const Config& config);
+
+	/**
+	 * Aggregates battle outcomes.
+	 *
+	 * @param results outcomes of the battles
+	 * @return win rates and turn counts
+	 */
+	Summary Summarize(Span<const RunResult> results);
+
+	/**
+	 * Writes a human readable report.
+	 *
+	 * @param os stream to write to
+	 * @param config simulation settings
+	 * @param summary aggregated outcome
+	 */
+	void WriteReport(std::ostream& os, const Config& config, const Summary& summary);
+}
+
+#endif
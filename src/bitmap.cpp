@@ -20,8 +20,10 @@
 #include <cstdlib>
 #include <cstring>
 #include <algorithm>
+#include <array>
 #include <iostream>
 #include <unordered_map>
+#include <vector>
 
 #include "utils.h"
 #include "cache.h"
@@ -38,6 +40,7 @@
 #include "output.h"
 #include "util_macro.h"
 #include "bitmap_hslrgb.h"
+#include "text_run_cache.h"
 #include <iostream>
 
 BitmapRef Bitmap::Create(int width, int height, const Color& color) {
@@ -304,6 +307,13 @@ Color Bitmap::GetColorAt(int x, int y) const {
 	return color;
 }
 
+namespace {
+	/** Reused pixel buffer of IntegerZoomBlit and ToneBlendFlipBlit */
+	std::vector<uint32_t> scanlines;
+	/** Reused pixel buffer of HueChangeBlit */
+	std::vector<uint32_t> hue_scanlines;
+}
+
 void Bitmap::HueChangeBlit(int x, int y, Bitmap const& src, Rect const& src_rect_, double hue_) {
 	Rect dst_rect(x, y, 0, 0), src_rect = src_rect_;
 
@@ -315,27 +325,55 @@ void Bitmap::HueChangeBlit(int x, int y, Bitmap const& src, Rect const& src_rect
 	int hue  = (int) (hue_ / 60.0 * 0x100);
 	if (hue < 0)
 		hue += ((-hue + 0x5FF) / 0x600) * 0x600;
-	else if (hue > 0x600)
+	else if (hue >= 0x600)
 		hue -= (hue / 0x600) * 0x600;
 
-	DynamicFormat format(32,8,24,8,16,8,8,8,0,PF::Alpha);
-	std::vector<uint32_t> pixels;
-	pixels.resize(src_rect.width * src_rect.height);
-	Bitmap bmp(reinterpret_cast<void*>(&pixels.front()), src_rect.width, src_rect.height, src_rect.width * 4, format);
-	bmp.Blit(0, 0, src, src_rect, Opacity::Opaque());
+	if (hue == 0) {
+		Blit(dst_rect.x, dst_rect.y, src, src_rect, Opacity::Opaque());
+		return;
+	}
+
+	// The kernel works on 8 bit channels, other screen formats are converted
+	static const DynamicFormat rgba_format(32,8,24,8,16,8,8,8,0,PF::Alpha);
+	const DynamicFormat& work_format = (pixel_format.bits == 32) ? pixel_format : rgba_format;
+
+	const int w = src_rect.width;
+	const int h = src_rect.height;
+	hue_scanlines.resize(static_cast<size_t>(w) * h);
 
-	for (std::vector<uint32_t>::iterator p = pixels.begin(); p != pixels.end(); ++p) {
-		uint32_t pixel = *p;
-		uint8_t r = (pixel>>24) & 0xFF;
-		uint8_t g = (pixel>>16) & 0xFF;
-		uint8_t b = (pixel>> 8) & 0xFF;
-		uint8_t a = pixel & 0xFF;
-		if (a > 0)
-			RGB_adjust_HSL(r, g, b, hue);
-		*p = ((uint32_t) r << 24) | ((uint32_t) g << 16) | ((uint32_t) b << 8) | (uint32_t) a;
+	auto image = PixmanImagePtr{ pixman_image_create_bits(find_format(work_format), w, h,
+		hue_scanlines.data(), w * sizeof(uint32_t)) };
+
+	if (pixel_format.bits == 32 && pixel_format == src.format && src.bpp() == 4) {
+		const int src_next_row = src.pitch() / sizeof(uint32_t);
+		const uint32_t* src_pixels = static_cast<const uint32_t*>(src.pixels()) + src_rect.y * src_next_row + src_rect.x;
+		for (int i = 0; i < h; ++i) {
+			memcpy(&hue_scanlines[static_cast<size_t>(i) * w], src_pixels + i * src_next_row, w * sizeof(uint32_t));
+		}
+	} else {
+		pixman_image_composite32(PIXMAN_OP_SRC,
+								 src.bitmap.get(), nullptr, image.get(),
+								 src_rect.x, src_rect.y,
+								 0, 0,
+								 0, 0,
+								 w, h);
 	}
 
-	Blit(dst_rect.x, dst_rect.y, bmp, bmp.GetRect(), Opacity::Opaque());
+	const int as = work_format.a.shift;
+	const int rs = work_format.r.shift;
+	const int gs = work_format.g.shift;
+	const int bs = work_format.b.shift;
+
+	for (int i = 0; i < h; ++i) {
+		HSL_rotate_row(&hue_scanlines[static_cast<size_t>(i) * w], w, hue, rs, gs, bs, as);
+	}
+
+	pixman_image_composite32(PIXMAN_OP_OVER,
+							 image.get(), nullptr, bitmap.get(),
+							 0, 0,
+							 0, 0,
+							 dst_rect.x, dst_rect.y,
+							 w, h);
 }
 
 Point Bitmap::TextDraw(Rect const& rect, int color, StringView text, Text::Alignment align) {
@@ -366,7 +404,26 @@ Point Bitmap::TextDraw(Rect const& rect, int color, StringView text, Text::Align
 Point Bitmap::TextDraw(int x, int y, int color, StringView text, Text::Alignment align) {
 	auto f = font ? font : Font::Default();
 	auto system = Cache::SystemOrBlack();
-	return Text::Draw(*this, x, y, *f, *system, color, text, align);
+
+	const auto* run = TextRunCache::Get(f, system, color, text);
+	if (!run) {
+		return Text::Draw(*this, x, y, *f, *system, color, text, align);
+	}
+
+	switch (align) {
+	case Text::AlignCenter:
+		x -= run->width / 2; break;
+	case Text::AlignRight:
+		x -= run->width; break;
+	case Text::AlignLeft:
+		break;
+	default: assert(false);
+	}
+
+	if (run->bitmap) {
+		Blit(x + run->offset.x, y + run->offset.y, *run->bitmap, run->bitmap->GetRect(), Opacity::Opaque());
+	}
+	return run->advance;
 }
 
 Point Bitmap::TextDraw(Rect const& rect, Color color, StringView text, Text::Alignment align) {
@@ -627,6 +684,33 @@ void Bitmap::Blit(int x, int y, Bitmap const& src, Rect const& src_rect, Opacity
 							 src_rect.width, src_rect.height);
 }
 
+void Bitmap::BatchBlit(Bitmap const& src, Span<const BatchItem> items, Opacity const& opacity, Bitmap::BlendMode blend_mode) {
+	assert(!opacity.IsSplit());
+
+	if (opacity.IsTransparent() || items.empty()) {
+		return;
+	}
+
+	auto mask = CreateMask(opacity, items[0].src_rect);
+	const auto op = src.GetOperator(mask.get(), blend_mode);
+	const Rect dst_rect = GetRect();
+
+	for (const auto& item: items) {
+		const Rect& src_rect = item.src_rect;
+		if (Rect(item.x, item.y, src_rect.width, src_rect.height).IsOutOfBounds(dst_rect)) {
+			continue;
+		}
+
+		pixman_image_composite32(op,
+								 src.bitmap.get(),
+								 mask.get(), bitmap.get(),
+								 src_rect.x, src_rect.y,
+								 0, 0,
+								 item.x, item.y,
+								 src_rect.width, src_rect.height);
+	}
+}
+
 void Bitmap::BlitFast(int x, int y, Bitmap const & src, Rect const & src_rect, Opacity const & opacity) {
 	if (opacity.IsTransparent()) {
 		return;
@@ -684,6 +768,10 @@ void Bitmap::StretchBlit(Rect const& dst_rect, Bitmap const& src, Rect const& sr
 		return;
 	}
 
+	if (IntegerZoomBlit(dst_rect, src, src_rect, opacity, blend_mode)) {
+		return;
+	}
+
 	double zoom_x = (double)src_rect.width  / dst_rect.width;
 	double zoom_y = (double)src_rect.height / dst_rect.height;
 
@@ -703,16 +791,130 @@ void Bitmap::StretchBlit(Rect const& dst_rect, Bitmap const& src, Rect const& sr
 	pixman_image_set_transform(src.bitmap.get(), nullptr);
 }
 
+bool Bitmap::IntegerZoomBlit(Rect const& dst_rect, Bitmap const& src, Rect const& src_rect, Opacity const& opacity, Bitmap::BlendMode blend_mode) {
+	// Split opacity needs the transformed mask of the generic path
+	if (opacity.IsSplit() || src.bpp() != 4) {
+		return false;
+	}
+
+	if (src_rect.width <= 0 || src_rect.height <= 0 || dst_rect.width <= 0 || dst_rect.height <= 0) {
+		return false;
+	}
+
+	if (dst_rect.width % src_rect.width != 0 || dst_rect.height % src_rect.height != 0) {
+		return false;
+	}
+
+	if (src_rect.x < 0 || src_rect.y < 0 || src_rect.x + src_rect.width > src.width() || src_rect.y + src_rect.height > src.height()) {
+		return false;
+	}
+
+	const int nx = dst_rect.width / src_rect.width;
+	const int ny = dst_rect.height / src_rect.height;
+
+	if (nx == 1 && ny == 1) {
+		Blit(dst_rect.x, dst_rect.y, src, src_rect, opacity, blend_mode);
+		return true;
+	}
+
+	Rect clip = dst_rect;
+	clip.Adjust(GetRect());
+	if (clip.width <= 0 || clip.height <= 0) {
+		return true;
+	}
+
+	// Offset of the visible part in the zoomed image
+	const int cx = clip.x - dst_rect.x;
+	const int cy = clip.y - dst_rect.y;
+	const int w = clip.width;
+	const int h = clip.height;
+
+	scanlines.resize(static_cast<size_t>(w) * h);
+
+	const int src_next_row = src.pitch() / sizeof(uint32_t);
+	const uint32_t* src_pixels = static_cast<const uint32_t*>(src.pixels());
+
+	// Pixels are only copied, this works for every 32 bit format
+	for (int i = 0; i < h; ++i) {
+		uint32_t* out = &scanlines[static_cast<size_t>(i) * w];
+
+		if (i > 0 && (cy + i) % ny != 0) {
+			memcpy(out, out - w, w * sizeof(uint32_t));
+			continue;
+		}
+
+		const uint32_t* in = src_pixels + (src_rect.y + (cy + i) / ny) * src_next_row + src_rect.x + cx / nx;
+		int k = cx % nx;
+		for (int j = 0; j < w; ++j) {
+			out[j] = *in;
+			if (++k == nx) {
+				k = 0;
+				++in;
+			}
+		}
+	}
+
+	auto image = PixmanImagePtr{ pixman_image_create_bits(src.pixman_format, w, h,
+		scanlines.data(), w * sizeof(uint32_t)) };
+
+	auto mask = CreateMask(opacity, src_rect);
+
+	pixman_image_composite32(src.GetOperator(mask.get(), blend_mode),
+							 image.get(), mask.get(), bitmap.get(),
+							 0, 0,
+							 0, 0,
+							 clip.x, clip.y,
+							 w, h);
+
+	return true;
+}
+
+namespace {
+	/** sin(2 * pi * i / 256) */
+	const std::array<double, 256>& GetSineTable() {
+		static const auto table = []() {
+			std::array<double, 256> t = {};
+			for (size_t i = 0; i < t.size(); ++i) {
+				t[i] = std::sin(i * (2 * M_PI) / 256);
+			}
+			return t;
+		}();
+		return table;
+	}
+
+	/**
+	 * Converts an angle to 1/256 turns.
+	 * The waver phase of pictures advances in these steps.
+	 *
+	 * @param angle angle in radians
+	 * @param[out] steps the angle in 1/256 turns, modulo 256
+	 * @return false when the angle is not a whole step
+	 */
+	bool ToSineSteps(double angle, int& steps) {
+		const double v = angle * 256 / (2 * M_PI);
+		const double r = std::round(v);
+		if (std::abs(v - r) > 1e-6 || std::abs(r) > (1 << 30)) {
+			return false;
+		}
+		steps = static_cast<int>(r) & 0xFF;
+		return true;
+	}
+} // anonymous namespace
+
 void Bitmap::WaverBlit(int x, int y, double zoom_x, double zoom_y, Bitmap const& src, Rect const& src_rect, int depth, double phase, Opacity const& opacity, Bitmap::BlendMode blend_mode) {
 	if (opacity.IsTransparent()) {
 		return;
 	}
 
+	const bool zoom = zoom_x != 1.0 || zoom_y != 1.0;
 	Transform xform = Transform::Scale(1.0 / zoom_x, 1.0 / zoom_y);
 
-	pixman_image_set_transform(src.bitmap.get(), &xform.matrix);
+	if (zoom) {
+		pixman_image_set_transform(src.bitmap.get(), &xform.matrix);
+	}
 
-	auto mask = CreateMask(opacity, src_rect, &xform);
+	auto mask = CreateMask(opacity, src_rect, zoom ? &xform : nullptr);
+	const auto op = src.GetOperator(mask.get(), blend_mode);
 
 	int height = static_cast<int>(std::floor(src_rect.height * zoom_y));
 	int width  = static_cast<int>(std::floor(src_rect.width * zoom_x));
@@ -720,23 +922,48 @@ void Bitmap::WaverBlit(int x, int y, double zoom_x, double zoom_y, Bitmap const&
 	const auto yoff = src_rect.y * zoom_y;
 	const auto yclip = y < 0 ? -y : 0;
 	const auto yend = std::min(height, this->height() - y);
-	for (int i = yclip; i < yend; i++) {
-		int dy = y + i;
+	const double amplitude = 2 * zoom_x * depth;
+
+	// Use the sine table when the phase and the per row step are whole table steps
+	const auto& sine = GetSineTable();
+	int phase_step = 0;
+	int row_step = 0;
+	const bool use_table = ToSineSteps(phase, phase_step) && ToSineSteps(2 * M_PI / (32.0 * zoom_y), row_step);
+
+	auto get_offset = [&](int i) {
 		// RPG_RT starts the effect from the top of the screen even if the image is clipped. The result
 		// is that moving images which cross the top of the screen can appear to go too fast or too slow
 		// in RPT_RT. The (i - yclip) is RPG_RT compatible behavior. Just (i) would be more correct.
+		if (use_table) {
+			return static_cast<int>(amplitude * sine[(phase_step + (i - yclip) * row_step) & 0xFF]);
+		}
 		const double sy = (i - yclip) * (2 * M_PI) / (32.0 * zoom_y);
-		const int offset = 2 * zoom_x * depth * std::sin(phase + sy);
+		return static_cast<int>(amplitude * std::sin(phase + sy));
+	};
+
+	// Consecutive rows with the same offset are drawn together
+	int run_start = yclip;
+	int run_offset = (yclip < yend) ? get_offset(yclip) : 0;
+	for (int i = yclip + 1; i <= yend; i++) {
+		const int offset = (i < yend) ? get_offset(i) : 0;
+		if (i < yend && offset == run_offset) {
+			continue;
+		}
 
-		pixman_image_composite32(src.GetOperator(mask.get(), blend_mode),
+		pixman_image_composite32(op,
 								 src.bitmap.get(), mask.get(), bitmap.get(),
-								 xoff, yoff + i,
-								 0, i,
-								 x + offset, dy,
-								 width, 1);
+								 xoff, yoff + run_start,
+								 0, run_start,
+								 x + run_offset, y + run_start,
+								 width, i - run_start);
+
+		run_start = i;
+		run_offset = offset;
 	}
 
-	pixman_image_set_transform(src.bitmap.get(), nullptr);
+	if (zoom) {
+		pixman_image_set_transform(src.bitmap.get(), nullptr);
+	}
 }
 
 static pixman_color_t PixmanColor(const Color &color) {
@@ -1041,6 +1268,119 @@ void Bitmap::BlendBlit(int x, int y, Bitmap const& src, Rect const& src_rect, co
 							 src_rect.width, src_rect.height);
 }
 
+bool Bitmap::ToneBlendFlipBlit(int x, int y, Bitmap const& src, Rect const& src_rect, const Tone& tone, const Color& color,
+		bool flip_x, bool flip_y, Opacity const& opacity, Bitmap::BlendMode blend_mode) {
+	// The pixel operations require the 32 bit format with alpha used by ToneBlit
+	if (pixel_format != src.format || src.bpp() != 4) {
+		return false;
+	}
+
+	if (src_rect.x < 0 || src_rect.y < 0 || src_rect.x + src_rect.width > src.width() || src_rect.y + src_rect.height > src.height()) {
+		return false;
+	}
+
+	if (opacity.IsTransparent() || src.GetImageOpacity() == ImageOpacity::Transparent) {
+		return true;
+	}
+
+	Rect clip(x, y, src_rect.width, src_rect.height);
+	clip.Adjust(GetRect());
+	if (clip.width <= 0 || clip.height <= 0) {
+		return true;
+	}
+
+	// Offset of the visible part in the drawn image
+	const int cx = clip.x - x;
+	const int cy = clip.y - y;
+	const int w = clip.width;
+	const int h = clip.height;
+
+	const int as = pixel_format.a.shift;
+	const int rs = pixel_format.r.shift;
+	const int gs = pixel_format.g.shift;
+	const int bs = pixel_format.b.shift;
+
+	const bool apply_sat = tone.gray != 128;
+	const bool apply_tone = (tone.red != 128 || tone.green != 128 || tone.blue != 128);
+	const bool apply_flash = color.alpha != 0;
+	const int sat = tone.gray > 128 ? 1024 + (tone.gray - 128) * 16 : tone.gray * 8;
+
+	// Flash color, premultiplied like in PixmanColor
+	const int flash_r = color.red * color.alpha / 255;
+	const int flash_g = color.green * color.alpha / 255;
+	const int flash_b = color.blue * color.alpha / 255;
+
+	scanlines.resize(static_cast<size_t>(w) * h);
+
+	const int src_next_row = src.pitch() / sizeof(uint32_t);
+	const uint32_t* src_pixels = static_cast<const uint32_t*>(src.pixels());
+
+	for (int i = 0; i < h; ++i) {
+		const int row = cy + i;
+		const int sy = flip_y ? src_rect.y + src_rect.height - 1 - row : src_rect.y + row;
+		const uint32_t* src_row = src_pixels + sy * src_next_row;
+		uint32_t* out = &scanlines[static_cast<size_t>(i) * w];
+
+		if (flip_x) {
+			const uint32_t* in = src_row + src_rect.x + src_rect.width - 1 - cx;
+			for (int j = 0; j < w; ++j) {
+				out[j] = *(in - j);
+			}
+		} else {
+			memcpy(out, src_row + src_rect.x + cx, w * sizeof(uint32_t));
+		}
+
+		if (!apply_sat && !apply_tone && !apply_flash) {
+			continue;
+		}
+
+		for (int j = 0; j < w; ++j) {
+			uint32_t& pixel = out[j];
+			const uint8_t a = (uint8_t)((pixel >> as) & 0xFF);
+			if (a == 0) {
+				continue;
+			}
+
+			if (apply_sat) {
+				saturation_tone(pixel, sat, rs, gs, bs, as);
+			}
+
+			if (apply_tone) {
+				if (a == 255) {
+					color_tone(pixel, tone, rs, gs, bs, as);
+				} else {
+					color_tone_alpha(pixel, tone, rs, gs, bs, as);
+				}
+			}
+
+			if (apply_flash) {
+				// OVER of the flash color masked by the pixel alpha, like BlendBlit
+				const int m = color.alpha * a / 255;
+				const int inv = 255 - m;
+				const int r = (flash_r * a + ((pixel >> rs) & 0xFF) * inv) / 255;
+				const int g = (flash_g * a + ((pixel >> gs) & 0xFF) * inv) / 255;
+				const int b = (flash_b * a + ((pixel >> bs) & 0xFF) * inv) / 255;
+				const int na = m + a * inv / 255;
+				pixel = ((uint32_t)r << rs) | ((uint32_t)g << gs) | ((uint32_t)b << bs) | ((uint32_t)na << as);
+			}
+		}
+	}
+
+	auto image = PixmanImagePtr{ pixman_image_create_bits(src.pixman_format, w, h,
+		scanlines.data(), w * sizeof(uint32_t)) };
+
+	auto mask = CreateMask(opacity, src_rect);
+
+	pixman_image_composite32(src.GetOperator(mask.get(), blend_mode),
+							 image.get(), mask.get(), bitmap.get(),
+							 0, 0,
+							 cx, cy,
+							 clip.x, clip.y,
+							 w, h);
+
+	return true;
+}
+
 void Bitmap::FlipBlit(int x, int y, Bitmap const& src, Rect const& src_rect, bool horizontal, bool vertical, Opacity const& opacity, Bitmap::BlendMode blend_mode) {
 	if (opacity.IsTransparent()) {
 		return;
@@ -1306,3 +1646,201 @@ void Bitmap::EdgeMirrorBlit(int x, int y, Bitmap const& src, Rect const& src_rec
 	}
 }
 
+namespace {
+	/** Multiplies all four channels by a / 255, rounded like pixman */
+	inline uint32_t MulUn8x4(uint32_t px, uint32_t a) {
+		uint32_t rb = (px & 0x00FF00FF) * a + 0x00800080;
+		rb = ((rb + ((rb >> 8) & 0x00FF00FF)) >> 8) & 0x00FF00FF;
+		uint32_t ag = ((px >> 8) & 0x00FF00FF) * a + 0x00800080;
+		ag = (ag + ((ag >> 8) & 0x00FF00FF)) & 0xFF00FF00;
+		return rb | ag;
+	}
+
+	/** A visible source pixel of a particle frame */
+	struct ParticlePixel {
+		int x;
+		int y;
+		uint32_t color;
+	};
+
+	/** Reused buffers of ParticleBlit */
+	std::vector<ParticlePixel> particle_pixels;
+	std::vector<int> particle_frame_begin;
+}
+
+void Bitmap::ParticleBlit(Bitmap const& src, Rect const& src_rect, int num_frames,
+		Span<const int16_t> xs, Span<const int16_t> ys, Span<const uint8_t> opacities, bool wrap) {
+	assert(xs.size() == ys.size() && xs.size() == opacities.size());
+	assert(num_frames > 0);
+
+	const int n = static_cast<int>(xs.size());
+
+	auto frame_rect = [&](int i) {
+		return Rect(src_rect.x, src_rect.y + (i % num_frames) * src_rect.height, src_rect.width, src_rect.height);
+	};
+
+	const bool direct = bpp() == 4 && src.bpp() == 4 && src.GetTransparent()
+		&& format.r.shift == src.format.r.shift && format.g.shift == src.format.g.shift && format.b.shift == src.format.b.shift
+		&& (!GetTransparent() || format.a.shift == src.format.a.shift)
+		&& src_rect.x >= 0 && src_rect.y >= 0
+		&& src_rect.x + src_rect.width <= src.width() && src_rect.y + src_rect.height * num_frames <= src.height();
+
+	if (!direct) {
+		for (int i = 0; i < n; ++i) {
+			if (opacities[i] == 0) {
+				continue;
+			}
+			if (wrap) {
+				EdgeMirrorBlit(xs[i], ys[i], src, frame_rect(i), true, true, opacities[i]);
+			} else {
+				Blit(xs[i], ys[i], src, frame_rect(i), opacities[i]);
+			}
+		}
+		return;
+	}
+
+	// The visible source pixels of every frame, particles are mostly transparent
+	auto& src_pixels = particle_pixels;
+	auto& frame_begin = particle_frame_begin;
+	src_pixels.clear();
+	frame_begin.resize(num_frames + 1);
+
+	for (int f = 0; f < num_frames; ++f) {
+		frame_begin[f] = static_cast<int>(src_pixels.size());
+		const auto rect = frame_rect(f);
+		for (int y = 0; y < rect.height; ++y) {
+			auto* row = reinterpret_cast<const uint32_t*>(static_cast<const uint8_t*>(src.pixels()) + (rect.y + y) * src.pitch()) + rect.x;
+			for (int x = 0; x < rect.width; ++x) {
+				if (row[x] != 0) {
+					src_pixels.push_back({ x, y, row[x] });
+				}
+			}
+		}
+	}
+	frame_begin[num_frames] = static_cast<int>(src_pixels.size());
+
+	const int dst_w = width();
+	const int dst_h = height();
+	const int dst_pitch = pitch();
+	auto* dst_pixels = static_cast<uint8_t*>(pixels());
+	const int alpha_shift = src.format.a.shift;
+	// Without alpha the unused channel can contain anything, treat it as opaque
+	const uint32_t dst_alpha_fill = GetTransparent() ? 0 : (0xFFu << alpha_shift);
+
+	for (int i = 0; i < n; ++i) {
+		const uint32_t opacity = opacities[i];
+		if (opacity == 0) {
+			continue;
+		}
+
+		const int x = xs[i];
+		const int y = ys[i];
+		const bool clone_x = wrap && x + src_rect.width > dst_w;
+		const bool clone_y = wrap && y + src_rect.height > dst_h;
+		const int f = i % num_frames;
+
+		for (int k = frame_begin[f]; k < frame_begin[f + 1]; ++k) {
+			const auto& sp = src_pixels[k];
+			const uint32_t s = (opacity == 255) ? sp.color : MulUn8x4(sp.color, opacity);
+			const uint32_t inv_alpha = 255 - ((s >> alpha_shift) & 0xFF);
+
+			auto plot = [&](int px, int py) {
+				if (px < 0 || py < 0 || px >= dst_w || py >= dst_h) {
+					return;
+				}
+				auto* d = reinterpret_cast<uint32_t*>(dst_pixels + py * dst_pitch) + px;
+				// OVER with premultiplied alpha
+				*d = s + MulUn8x4(*d | dst_alpha_fill, inv_alpha);
+			};
+
+			const int px = x + sp.x;
+			const int py = y + sp.y;
+			plot(px, py);
+			if (clone_x) {
+				plot(px - dst_w, py);
+			}
+			if (clone_y) {
+				plot(px, py - dst_h);
+			}
+			if (clone_x && clone_y) {
+				plot(px - dst_w, py - dst_h);
+			}
+		}
+	}
+}
+
+void Bitmap::SelectBlit(Bitmap const& src1, Bitmap const& src2, Span<const uint8_t> map, int cell_w, int cell_h) {
+	assert(cell_w > 0 && cell_h > 0);
+
+	const int w = width();
+	const int h = height();
+	const int map_w = (w + cell_w - 1) / cell_w;
+	const int map_h = (h + cell_h - 1) / cell_h;
+	assert(static_cast<int>(map.size()) >= map_w * map_h);
+
+	auto same_layout = [&](Bitmap const& src) {
+		return src.bpp() == 4 && src.width() >= w && src.height() >= h
+			&& format.r.shift == src.format.r.shift && format.g.shift == src.format.g.shift && format.b.shift == src.format.b.shift
+			&& (!GetTransparent() || !src.GetTransparent() || format.a.shift == src.format.a.shift);
+	};
+
+	if (bpp() != 4 || !same_layout(src1) || !same_layout(src2)) {
+		// Generic path: One blit per run of equal cells
+		for (int my = 0; my < map_h; ++my) {
+			const uint8_t* mrow = map.data() + my * map_w;
+			for (int mx = 0; mx < map_w;) {
+				int end = mx + 1;
+				while (end < map_w && mrow[end] == mrow[mx]) {
+					++end;
+				}
+				if (mrow[mx] != 0) {
+					Rect rect(mx * cell_w, my * cell_h, (end - mx) * cell_w, cell_h);
+					Blit(rect.x, rect.y, mrow[mx] == 2 ? src2 : src1, rect, Opacity::Opaque());
+				}
+				mx = end;
+			}
+		}
+		return;
+	}
+
+	// The sources are opaque: Set the alpha channel when they have none
+	const uint32_t alpha_fill = GetTransparent() ? (0xFFu << format.a.shift) : 0;
+
+	for (int y = 0; y < h; ++y) {
+		const uint8_t* mrow = map.data() + (y / cell_h) * map_w;
+		auto* dst_row = reinterpret_cast<uint32_t*>(static_cast<uint8_t*>(pixels()) + y * pitch());
+		auto* row1 = reinterpret_cast<const uint32_t*>(static_cast<const uint8_t*>(src1.pixels()) + y * src1.pitch());
+		auto* row2 = reinterpret_cast<const uint32_t*>(static_cast<const uint8_t*>(src2.pixels()) + y * src2.pitch());
+
+		if (cell_w == 1) {
+			// Branchless select, vectorized by the compiler
+			for (int x = 0; x < w; ++x) {
+				const uint8_t m = mrow[x];
+				const uint32_t v = ((m == 2) ? row2[x] : row1[x]) | alpha_fill;
+				dst_row[x] = (m == 0) ? dst_row[x] : v;
+			}
+			continue;
+		}
+
+		for (int mx = 0; mx < map_w;) {
+			int end = mx + 1;
+			while (end < map_w && mrow[end] == mrow[mx]) {
+				++end;
+			}
+			if (mrow[mx] != 0) {
+				const int x0 = mx * cell_w;
+				const int x1 = std::min(w, end * cell_w);
+				const uint32_t* src_row = (mrow[mx] == 2) ? row2 : row1;
+				if (alpha_fill == 0) {
+					memcpy(dst_row + x0, src_row + x0, (x1 - x0) * sizeof(uint32_t));
+				} else {
+					for (int x = x0; x < x1; ++x) {
+						dst_row[x] = src_row[x] | alpha_fill;
+					}
+				}
+			}
+			mx = end;
+		}
+	}
+}
+
@@ -36,6 +36,7 @@
 #include "opacity.h"
 #include "filesystem_stream.h"
 #include "string_view.h"
+#include "span.h"
 
 struct Transform;
 
@@ -306,6 +307,26 @@ public:
 	void Blit(int x, int y, Bitmap const& src, Rect const& src_rect,
 		Opacity const& opacity, BlendMode blend_mode = BlendMode::Default);
 
+	/** Destination position and source rect of one blit of BatchBlit */
+	struct BatchItem {
+		int x;
+		int y;
+		Rect src_rect;
+	};
+
+	/**
+	 * Blits multiple parts of a source bitmap to this one.
+	 * Same result as calling Blit for every item in order, the pixman and
+	 * mask setup is only done once.
+	 *
+	 * @param src source bitmap.
+	 * @param items positions and source rects.
+	 * @param opacity opacity for blending with bitmap, must not be split.
+	 * @param blend_mode Blend mode to use.
+	 */
+	void BatchBlit(Bitmap const& src, Span<const BatchItem> items,
+		Opacity const& opacity, BlendMode blend_mode = BlendMode::Default);
+
 	/**
 	 * Blits source bitmap to this one ignoring alpha (faster)
 	 *
@@ -357,6 +378,38 @@ public:
 	 */
 	void EdgeMirrorBlit(int x, int y, Bitmap const& src, Rect const& src_rect, bool mirror_x, bool mirror_y, Opacity const& opacity);
 
+	/**
+	 * Blits a small source rect at many positions, used for weather particles.
+	 * The pixels are blended directly into the destination rows instead of
+	 * compositing every position on its own.
+	 * The source rects of the frames are stacked vertically, position i uses
+	 * frame i % num_frames.
+	 *
+	 * @param src source bitmap.
+	 * @param src_rect source rect of the first frame.
+	 * @param num_frames number of frames.
+	 * @param xs x positions.
+	 * @param ys y positions, same size as xs.
+	 * @param opacities opacity of each position, same size as xs. 0 skips the position.
+	 * @param wrap Blit clones across the right and bottom edge (see EdgeMirrorBlit)
+	 */
+	void ParticleBlit(Bitmap const& src, Rect const& src_rect, int num_frames,
+		Span<const int16_t> xs, Span<const int16_t> ys, Span<const uint8_t> opacities, bool wrap);
+
+	/**
+	 * Composes this bitmap from two sources by choosing the source per cell of
+	 * a map. Used by screen transitions: the map is precomputed and every frame
+	 * is a single pass over the rows.
+	 * The pixels are copied and not blended, the sources are treated as opaque.
+	 *
+	 * @param src1 source of cells with value 1, at least the size of this bitmap.
+	 * @param src2 source of cells with value 2, at least the size of this bitmap.
+	 * @param map source of each cell, row major. 0 keeps the pixels of this bitmap.
+	 * @param cell_w cell width, the map has ceil(width / cell_w) columns.
+	 * @param cell_h cell height, the map has ceil(height / cell_h) rows.
+	 */
+	void SelectBlit(Bitmap const& src1, Bitmap const& src2, Span<const uint8_t> map, int cell_w, int cell_h);
+
 	/**
 	 * Blits source bitmap stretched to this one.
 	 *
@@ -513,6 +566,26 @@ public:
 	 */
 	void BlendBlit(int x, int y, Bitmap const& src, Rect const& src_rect, const Color &color, Opacity const& opacity);
 
+	/**
+	 * Blits a bitmap with tone, flash color and flip applied in a single pass.
+	 * Produces the same result as applying ToneBlit, BlendBlit and FlipBlit
+	 * to a temporary bitmap and blitting it, without allocating the bitmap.
+	 *
+	 * @param x x position.
+	 * @param y y position.
+	 * @param src source bitmap.
+	 * @param src_rect source bitmap rect.
+	 * @param tone tone to apply.
+	 * @param color flash color to blend with.
+	 * @param flip_x flip horizontally (mirror).
+	 * @param flip_y flip vertically.
+	 * @param opacity opacity to apply.
+	 * @param blend_mode Blend mode
+	 * @return false when the source format is not supported, nothing was drawn
+	 */
+	bool ToneBlendFlipBlit(int x, int y, Bitmap const& src, Rect const& src_rect, const Tone& tone, const Color& color,
+			bool flip_x, bool flip_y, Opacity const& opacity, BlendMode blend_mode = BlendMode::Default);
+
 	/**
 	 * Flips the bitmap pixels.
 	 *
@@ -630,6 +703,14 @@ protected:
 	void ConvertImage(int& width, int& height, void*& pixels, bool transparent);
 
 	static PixmanImagePtr GetSubimage(Bitmap const& src, const Rect& src_rect);
+
+	/**
+	 * StretchBlit fast path for zooms by a whole factor without a pixman transform.
+	 *
+	 * @return false when the blit is not supported and nothing was drawn
+	 */
+	bool IntegerZoomBlit(Rect const& dst_rect, Bitmap const& src, Rect const& src_rect,
+		Opacity const& opacity, BlendMode blend_mode);
 	static inline void MultiplyAlpha(uint8_t &r, uint8_t &g, uint8_t &b, const uint8_t &a) {
 		r = (uint8_t)((int)r * a / 0xFF);
 		g = (uint8_t)((int)g * a / 0xFF);
@@ -1,3 +1,7 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
 
 static inline void RGB_to_HSL(const uint8_t& r, const uint8_t& g, const uint8_t& b,
 							  int &h, int &s, int &l)
@@ -68,3 +72,91 @@ static inline void RGB_adjust_HSL(uint8_t& r, uint8_t& g, uint8_t& b,
 	HSL_adjust(h, s, l, hue);
 	HSL_to_RGB(h, s, l, r, g, b);
 }
+
+/**
+ * Table of 0x100 * 2^16 / c (rounded up) for 1 <= c <= 0xFF.
+ * Replaces the division by the chroma when calculating the hue.
+ */
+static inline const uint32_t* HSL_chroma_reciprocals() {
+	static const auto table = []() {
+		std::array<uint32_t, 0x100> t = {};
+		for (uint32_t c = 1; c < 0x100; ++c) {
+			t[c] = ((0x100u << 16) + c - 1) / c;
+		}
+		return t;
+	}();
+	return table.data();
+}
+
+/**
+ * Rotates the hue of a row of 32 bit pixels in place.
+ * Same result as RGB_adjust_HSL without the rounding of the saturation and
+ * lightness: Hue rotation keeps the minimum and maximum channel and only
+ * moves the middle channel, so no conversion to HSL is needed.
+ * Pixels with alpha 0 and gray pixels are not changed.
+ * The loop stays scalar: The per pixel branches on the maximum channel and
+ * the table lookup prevent auto-vectorization.
+ *
+ * @param pixels row to modify
+ * @param n amount of pixels
+ * @param hue rotation in the range [0, 0x600)
+ * @param rs shift of the red channel
+ * @param gs shift of the green channel
+ * @param bs shift of the blue channel
+ * @param as shift of the alpha channel
+ */
+static inline void HSL_rotate_row(uint32_t* pixels, int n, int hue, int rs, int gs, int bs, int as) {
+	const uint32_t* recip = HSL_chroma_reciprocals();
+	const uint32_t keep = ~((0xFFu << rs) | (0xFFu << gs) | (0xFFu << bs));
+
+	// floor(0x100 * d / c) for 0 <= d <= c
+	auto frac = [recip](int d, int c) {
+		return static_cast<int>((static_cast<uint32_t>(d) * recip[c]) >> 16);
+	};
+
+	for (int i = 0; i < n; ++i) {
+		const uint32_t pixel = pixels[i];
+		if (((pixel >> as) & 0xFF) == 0) {
+			continue;
+		}
+
+		int r = (pixel >> rs) & 0xFF;
+		int g = (pixel >> gs) & 0xFF;
+		int b = (pixel >> bs) & 0xFF;
+
+		const int max = std::max(r, std::max(g, b));
+		const int min = std::min(r, std::min(g, b));
+		const int c = max - min;
+		if (c == 0) {
+			continue;
+		}
+
+		int h;
+		if (max == r) {
+			h = (g >= b) ? frac(g - b, c) : 0x600 - frac(b - g, c);
+		} else if (max == g) {
+			h = (b >= r) ? 0x200 + frac(b - r, c) : 0x200 - frac(r - b, c);
+		} else {
+			h = (r >= g) ? 0x400 + frac(r - g, c) : 0x400 - frac(g - r, c);
+		}
+
+		h += hue;
+		if (h >= 0x600) h -= 0x600;
+
+		// Rounded up, this makes a rotation by 0 lossless
+		const int h0 = h & 0xFF;
+		const int up = min + ((h0 * c + 0xFF) >> 8);
+		const int down = min + (((0x100 - h0) * c + 0xFF) >> 8);
+
+		switch (h >> 8) {
+			case 0: r = max; g = up; b = min; break;
+			case 1: r = down; g = max; b = min; break;
+			case 2: r = min; g = max; b = up; break;
+			case 3: r = min; g = down; b = max; break;
+			case 4: r = up; g = min; b = max; break;
+			default: r = max; g = min; b = down; break;
+		}
+
+		pixels[i] = (pixel & keep) | ((uint32_t)r << rs) | ((uint32_t)g << gs) | ((uint32_t)b << bs);
+	}
+}
@@ -20,10 +20,12 @@
 #  pragma warning(disable: 4003)
 #endif
 
-#include <map>
+#include <algorithm>
+#include <unordered_map>
 #include <tuple>
 #include <chrono>
 #include <cassert>
+#include <vector>
 
 #include "async_handler.h"
 #include "cache.h"
@@ -36,6 +38,7 @@
 #include <lcf/data.h>
 #include "game_clock.h"
 #include "translation.h"
+#include "text_run_cache.h"
 
 using namespace std::chrono_literals;
 
@@ -81,9 +84,110 @@ namespace {
 	using tile_key_type = std::string;
 	std::unordered_map<tile_key_type, std::weak_ptr<Bitmap>> cache_tiles;
 
-	// rect, flip_x, flip_y, tone, blend
-	using effect_key_type = std::tuple<std::string, bool, Rect, bool, bool, Tone, Color>;
-	std::map<effect_key_type, std::weak_ptr<Bitmap>> cache_effects;
+	// bitmap, transparent, rect, flip_x, flip_y, tone, blend
+	struct EffectKey {
+		const Bitmap* bitmap;
+		bool transparent;
+		Rect rect;
+		bool flip_x;
+		bool flip_y;
+		Tone tone;
+		Color blend;
+
+		bool operator==(const EffectKey& o) const {
+			return bitmap == o.bitmap && transparent == o.transparent && rect == o.rect
+				&& flip_x == o.flip_x && flip_y == o.flip_y && tone == o.tone && blend == o.blend;
+		}
+	};
+
+	struct EffectItem {
+		/** Detects a different bitmap that reuses the address of a freed one */
+		std::weak_ptr<Bitmap> source;
+		std::weak_ptr<Bitmap> effect;
+		/** Value of effect_clock at the last lookup, for evicting the least recently used */
+		uint64_t last_use;
+	};
+
+	uint64_t Mix(uint64_t h, uint64_t v) {
+		// splitmix64 finalizer
+		h ^= v + 0x9E3779B97F4A7C15ull + (h << 6) + (h >> 2);
+		h ^= h >> 30;
+		h *= 0xBF58476D1CE4E5B9ull;
+		h ^= h >> 27;
+		h *= 0x94D049BB133111EBull;
+		h ^= h >> 31;
+		return h;
+	}
+
+	uint64_t HashEffectKey(const EffectKey& key) {
+		uint64_t h = Mix(0, reinterpret_cast<uintptr_t>(key.bitmap));
+		h = Mix(h, (static_cast<uint64_t>(static_cast<uint16_t>(key.rect.x)) << 48)
+			| (static_cast<uint64_t>(static_cast<uint16_t>(key.rect.y)) << 32)
+			| (static_cast<uint64_t>(static_cast<uint16_t>(key.rect.width)) << 16)
+			| static_cast<uint64_t>(static_cast<uint16_t>(key.rect.height)));
+		h = Mix(h, (static_cast<uint64_t>(key.tone.red & 0xFF) << 56)
+			| (static_cast<uint64_t>(key.tone.green & 0xFF) << 48)
+			| (static_cast<uint64_t>(key.tone.blue & 0xFF) << 40)
+			| (static_cast<uint64_t>(key.tone.gray & 0xFF) << 32)
+			| (static_cast<uint64_t>(key.blend.red) << 24)
+			| (static_cast<uint64_t>(key.blend.green) << 16)
+			| (static_cast<uint64_t>(key.blend.blue) << 8)
+			| static_cast<uint64_t>(key.blend.alpha));
+		return Mix(h, (key.transparent ? 1 : 0) | (key.flip_x ? 2 : 0) | (key.flip_y ? 4 : 0));
+	}
+
+	struct EffectKeyHash {
+		size_t operator()(const EffectKey& key) const {
+			return static_cast<size_t>(HashEffectKey(key));
+		}
+	};
+
+	std::unordered_map<EffectKey, EffectItem, EffectKeyHash> cache_effects;
+	Cache::EffectStats effect_stats;
+	uint64_t effect_clock = 0;
+
+	/** Expired entries are purged after this amount of misses */
+	constexpr int effect_purge_interval = 64;
+	/** Entries that trigger a purge */
+	constexpr size_t effect_limit = 512;
+	/** Entries that are left after a purge of a full cache, gives room for misses until the next purge */
+	constexpr size_t effect_low_water = effect_limit * 3 / 4;
+	int effect_misses_since_purge = 0;
+
+	void PurgeEffects() {
+		for (auto it = cache_effects.begin(); it != cache_effects.end();) {
+			if (it->second.effect.expired() || it->second.source.expired()) {
+				it = cache_effects.erase(it);
+				++effect_stats.purged;
+			} else {
+				++it;
+			}
+		}
+
+		if (cache_effects.size() >= effect_limit) {
+			// Still referenced by sprites, dropping them only prevents sharing.
+			// Keep the most recently used ones.
+			std::vector<uint64_t> uses;
+			uses.reserve(cache_effects.size());
+			for (auto& kv : cache_effects) {
+				uses.push_back(kv.second.last_use);
+			}
+			auto nth = uses.end() - effect_low_water;
+			std::nth_element(uses.begin(), nth, uses.end());
+			const uint64_t min_use = *nth;
+
+			for (auto it = cache_effects.begin(); it != cache_effects.end();) {
+				if (it->second.last_use < min_use) {
+					it = cache_effects.erase(it);
+					++effect_stats.purged;
+				} else {
+					++it;
+				}
+			}
+		}
+
+		effect_misses_since_purge = 0;
+	}
 
 	std::string system_name;
 
@@ -463,16 +567,8 @@ BitmapRef Cache::Tile(StringView filename, int tile_id) {
 }
 
 BitmapRef Cache::SpriteEffect(const BitmapRef& src_bitmap, const Rect& rect, bool flip_x, bool flip_y, const Tone& tone, const Color& blend) {
-	std::string id = ToString(src_bitmap->GetId());
-
-	if (id.empty()) {
-		// assert caused too many regressions, use the pointer as the unique key and log instead
-		Output::Debug("Bitmap has no ID. Please report a bug!");
-		id = fmt::format("{}", (void*)(src_bitmap.get()));
-	}
-
-	const effect_key_type key {
-		id,
+	const EffectKey key {
+		src_bitmap.get(),
 		src_bitmap->GetTransparent(),
 		rect,
 		flip_x,
@@ -481,44 +577,70 @@ BitmapRef Cache::SpriteEffect(const BitmapRef& src_bitmap, const Rect& rect, boo
 		blend
 	};
 
-	const auto it = cache_effects.find(key);
+	auto it = cache_effects.find(key);
+	if (it != cache_effects.end()) {
+		auto& item = it->second;
+		// owner_before compares the control block: same object and not a reused address
+		bool same_source = !item.source.owner_before(src_bitmap) && !src_bitmap.owner_before(item.source);
+		if (same_source) {
+			if (auto bitmap_effects = item.effect.lock()) {
+				item.last_use = ++effect_clock;
+				++effect_stats.hits;
+				return bitmap_effects;
+			}
+		}
+	}
 
-	if (it == cache_effects.end() || it->second.expired()) {
-		BitmapRef bitmap_effects;
+	++effect_stats.misses;
+	if (++effect_misses_since_purge >= effect_purge_interval || cache_effects.size() >= effect_limit) {
+		PurgeEffects();
+	}
 
-		auto create = [&rect] () -> BitmapRef {
-			return Bitmap::Create(rect.width, rect.height, true);
-		};
+	BitmapRef bitmap_effects;
+
+	auto create = [&rect] () -> BitmapRef {
+		return Bitmap::Create(rect.width, rect.height, true);
+	};
 
-		if (tone != Tone()) {
+	if (tone != Tone()) {
+		bitmap_effects = create();
+		bitmap_effects->ToneBlit(0, 0, *src_bitmap, rect, tone, Opacity::Opaque());
+	}
+
+	if (blend != Color()) {
+		if (bitmap_effects) {
+			// Tone blit was applied
+			bitmap_effects->BlendBlit(0, 0, *bitmap_effects, bitmap_effects->GetRect(), blend, Opacity::Opaque());
+		} else {
 			bitmap_effects = create();
-			bitmap_effects->ToneBlit(0, 0, *src_bitmap, rect, tone, Opacity::Opaque());
+			bitmap_effects->BlendBlit(0, 0, *src_bitmap, rect, blend, Opacity::Opaque());
 		}
+	}
 
-		if (blend != Color()) {
-			if (bitmap_effects) {
-				// Tone blit was applied
-				bitmap_effects->BlendBlit(0, 0, *bitmap_effects, bitmap_effects->GetRect(), blend, Opacity::Opaque());
-			} else {
-				bitmap_effects = create();
-				bitmap_effects->BlendBlit(0, 0, *src_bitmap, rect, blend, Opacity::Opaque());
-			}
+	if (flip_x || flip_y) {
+		if (bitmap_effects) {
+			// Tone or blend blit was applied
+			bitmap_effects->Flip(flip_x, flip_y);
+		} else {
+			bitmap_effects = create();
+			bitmap_effects->FlipBlit(0, 0, *src_bitmap, rect, flip_x, flip_y, Opacity::Opaque());
 		}
+	}
 
-		if (flip_x || flip_y) {
-			if (bitmap_effects) {
-				// Tone or blend blit was applied
-				bitmap_effects->Flip(flip_x, flip_y);
-			} else {
-				bitmap_effects = create();
-				bitmap_effects->FlipBlit(0, 0, *src_bitmap, rect, flip_x, flip_y, Opacity::Opaque());
-			}
-		}
+	assert(bitmap_effects && "Effect cache used but no effect applied!");
+
+	cache_effects[key] = EffectItem{ src_bitmap, bitmap_effects, ++effect_clock };
+	return bitmap_effects;
+}
 
-		assert(bitmap_effects && "Effect cache used but no effect applied!");
+Cache::EffectStats Cache::GetSpriteEffectStats() {
+	auto stats = effect_stats;
+	stats.entries = cache_effects.size();
+	return stats;
+}
 
-		return(cache_effects[key] = bitmap_effects).lock();
-	} else { return it->second.lock(); }
+void Cache::ResetSpriteEffectStats() {
+	effect_stats = {};
 }
 
 void Cache::Clear() {
@@ -540,6 +662,7 @@ void Cache::Clear() {
 
 void Cache::ClearAll() {
 	Cache::Clear();
+	TextRunCache::Clear();
 
 	system_name.clear();
 	system2_name.clear();
@@ -58,6 +58,22 @@ namespace Cache {
 	BitmapRef Tile(StringView filename, int tile_id);
 	BitmapRef SpriteEffect(const BitmapRef& src_bitmap, const Rect& rect, bool flip_x, bool flip_y, const Tone& tone, const Color& blend);
 
+	/** Lookup statistics of the SpriteEffect cache */
+	struct EffectStats {
+		int64_t hits = 0;
+		int64_t misses = 0;
+		/** Entries removed because they expired or the cache was full */
+		int64_t purged = 0;
+		/** Current amount of entries */
+		size_t entries = 0;
+	};
+
+	/** @return SpriteEffect cache statistics */
+	EffectStats GetSpriteEffectStats();
+
+	/** Clears the SpriteEffect cache statistics */
+	void ResetSpriteEffectStats();
+
 	void Clear();
 	void ClearAll();
 
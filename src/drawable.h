@@ -57,6 +57,14 @@ public:
 
 	virtual void Draw(Bitmap& dst) = 0;
 
+	/**
+	 * Drawables which only draw through Sprite::BlitScreen can have their blits
+	 * batched with the blits of the following drawables.
+	 *
+	 * @return true if the draw calls of this drawable can be deferred
+	 */
+	virtual bool IsBatchable() const;
+
 	Z_t GetZ() const;
 
 	void SetZ(Z_t z);
@@ -142,6 +150,10 @@ inline Drawable::Drawable(Z_t z, Flags flags)
 {
 }
 
+inline bool Drawable::IsBatchable() const {
+	return false;
+}
+
 inline Drawable::Z_t Drawable::GetZ() const {
 	return _z;
 }
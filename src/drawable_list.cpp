@@ -18,6 +18,7 @@
 // Headers
 #include "drawable_list.h"
 #include "drawable_mgr.h"
+#include "sprite_batch.h"
 #include <algorithm>
 #include <cassert>
 
@@ -97,6 +98,9 @@ void DrawableList::Draw(Bitmap& dst, Drawable::Z_t min_z, Drawable::Z_t max_z) {
 		assert(IsSorted());
 	}
 
+	// Consecutive sprites sharing a bitmap are drawn together
+	SpriteBatch batch;
+
 	for (auto* drawable : _list) {
 		auto z = drawable->GetZ();
 		if (z < min_z) {
@@ -105,7 +109,13 @@ void DrawableList::Draw(Bitmap& dst, Drawable::Z_t min_z, Drawable::Z_t max_z) {
 		if (z > max_z) {
 			break;
 		}
-		if (drawable->IsVisible()) {
+		if (!drawable->IsVisible()) {
+			continue;
+		}
+		if (drawable->IsBatchable()) {
+			batch.Draw(*drawable, dst);
+		} else {
+			batch.Flush();
 			drawable->Draw(dst);
 		}
 	}
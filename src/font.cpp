@@ -50,6 +50,7 @@
 #include "cache.h"
 #include "player.h"
 #include "compiler.h"
+#include "text_run_cache.h"
 
 // Static variables.
 namespace {
@@ -658,6 +659,8 @@ FontRef Font::CreateFtFont(Filesystem_Stream::InputStream is, int size, bool bol
 }
 
 void Font::ResetDefault() {
+	TextRunCache::Clear();
+
 	SetDefault(nullptr, true);
 	SetDefault(nullptr, false);
 
@@ -892,6 +895,8 @@ std::vector<Font::ShapeRet> Font::Shape(U32StringView text) const {
 
 void Font::SetFallbackFont(FontRef fallback_font) {
 	this->fallback_font = fallback_font;
+	// Rendering of this font changed
+	TextRunCache::Clear();
 }
 
 bool Font::IsStyleApplied() const {
@@ -38,6 +38,28 @@
 constexpr int max_level_2k = 50;
 constexpr int max_level_2k3 = 99;
 
+namespace {
+	uint32_t equipment_revision = 0;
+}
+
+uint32_t Game_Actor::GetEquipmentRevision() {
+	return equipment_revision;
+}
+
+template <typename F>
+int Game_Actor::GetCachedStat(int slot, F&& f) const {
+	const uint32_t bit = 1u << slot;
+	if ((stat_cache_valid & bit) == 0) {
+		stat_cache[slot] = f();
+		stat_cache_valid |= bit;
+	}
+	return stat_cache[slot];
+}
+
+void Game_Actor::InvalidateStatCache() {
+	stat_cache_valid = 0;
+}
+
 int Game_Actor::MaxHpValue() const {
 	auto& val = lcf::Data::system.easyrpg_max_actor_hp;
 	if (val == -1) {
@@ -135,6 +157,8 @@ void Game_Actor::SetSaveData(lcf::rpg::SaveActor save) {
 	}
 
 	data = std::move(save);
+	++equipment_revision;
+	InvalidateStatCache();
 
 	if (Player::IsRPG2k()) {
 		data.two_weapon = dbActor->two_weapon;
@@ -149,6 +173,7 @@ void Game_Actor::SetSaveData(lcf::rpg::SaveActor save) {
 
 void Game_Actor::ReloadDbActor() {
 	dbActor = lcf::ReaderUtil::GetElement(lcf::Data::actors, GetId());
+	InvalidateStatCache();
 }
 
 lcf::rpg::SaveActor Game_Actor::GetSaveData() const {
@@ -347,6 +372,8 @@ int Game_Actor::SetEquipment(int equip_type, int new_item_id) {
 	}
 
 	data.equipped[equip_type - 1] = (short)new_item_id;
+	++equipment_revision;
+	InvalidateStatCache();
 
 	AdjustEquipmentStates(old_item, false, false);
 	AdjustEquipmentStates(new_item, true, false);
@@ -438,7 +465,7 @@ int Game_Actor::GetBaseMaxHp(bool mod) const {
 }
 
 int Game_Actor::GetBaseMaxHp() const {
-	return GetBaseMaxHp(true);
+	return GetCachedStat(CachedStat_MaxHp, [this]() { return GetBaseMaxHp(true); });
 }
 
 int Game_Actor::GetBaseMaxSp(bool mod) const {
@@ -456,7 +483,7 @@ int Game_Actor::GetBaseMaxSp(bool mod) const {
 }
 
 int Game_Actor::GetBaseMaxSp() const {
-	return GetBaseMaxSp(true);
+	return GetCachedStat(CachedStat_MaxSp, [this]() { return GetBaseMaxSp(true); });
 }
 
 static bool IsArmorType(const lcf::rpg::Item* item) {
@@ -515,7 +542,7 @@ int Game_Actor::GetBaseAtk(Weapon weapon, bool mod, bool equip) const {
 }
 
 int Game_Actor::GetBaseAtk(Weapon weapon) const {
-	return GetBaseAtk(weapon, true, true);
+	return GetCachedStat(CachedStat_Atk + (weapon + 1), [&]() { return GetBaseAtk(weapon, true, true); });
 }
 
 int Game_Actor::GetBaseDef(Weapon weapon, bool mod, bool equip) const {
@@ -538,7 +565,7 @@ int Game_Actor::GetBaseDef(Weapon weapon, bool mod, bool equip) const {
 }
 
 int Game_Actor::GetBaseDef(Weapon weapon) const {
-	return GetBaseDef(weapon, true, true);
+	return GetCachedStat(CachedStat_Def + (weapon + 1), [&]() { return GetBaseDef(weapon, true, true); });
 }
 
 int Game_Actor::GetBaseSpi(Weapon weapon, bool mod, bool equip) const {
@@ -561,7 +588,7 @@ int Game_Actor::GetBaseSpi(Weapon weapon, bool mod, bool equip) const {
 }
 
 int Game_Actor::GetBaseSpi(Weapon weapon) const {
-	return GetBaseSpi(weapon, true, true);
+	return GetCachedStat(CachedStat_Spi + (weapon + 1), [&]() { return GetBaseSpi(weapon, true, true); });
 }
 
 int Game_Actor::GetBaseAgi(Weapon weapon, bool mod, bool equip) const {
@@ -584,7 +611,7 @@ int Game_Actor::GetBaseAgi(Weapon weapon, bool mod, bool equip) const {
 }
 
 int Game_Actor::GetBaseAgi(Weapon weapon) const {
-	return GetBaseAgi(weapon, true, true);
+	return GetCachedStat(CachedStat_Agi + (weapon + 1), [&]() { return GetBaseAgi(weapon, true, true); });
 }
 
 int Game_Actor::CalculateExp(int level) const {
@@ -784,6 +811,7 @@ void Game_Actor::ChangeExp(int exp, PendingMessage* pm) {
 
 void Game_Actor::SetLevel(int _level) {
 	data.level = Utils::Clamp(_level, 1, GetMaxLevel());
+	InvalidateStatCache();
 	// Ensure current HP/SP remain clamped if new Max HP/SP is less.
 	SetHp(GetHp());
 	SetSp(GetSp());
@@ -1062,6 +1090,7 @@ void Game_Actor::ChangeClass(int new_class_id,
 	data.agility_mod = 0;
 
 	data.class_id = new_class_id;
+	InvalidateStatCache();
 	data.changed_battle_commands = true; // Any change counts as a battle commands change.
 
 	// The class settings are not applied when the actor has a class on startup
@@ -1171,6 +1200,7 @@ static int ClampStatMod(int value, const Game_Actor* actor) {
 void Game_Actor::SetBaseMaxHp(int maxhp) {
 	int new_hp_mod = data.hp_mod + (maxhp - GetBaseMaxHp());
 	data.hp_mod = ClampMaxHpMod(new_hp_mod, this);
+	InvalidateStatCache();
 
 	SetHp(data.current_hp);
 }
@@ -1178,6 +1208,7 @@ void Game_Actor::SetBaseMaxHp(int maxhp) {
 void Game_Actor::SetBaseMaxSp(int maxsp) {
 	int new_sp_mod = data.sp_mod + (maxsp - GetBaseMaxSp());
 	data.sp_mod = ClampMaxSpMod(new_sp_mod, this);
+	InvalidateStatCache();
 
 	SetSp(data.current_sp);
 }
@@ -1195,21 +1226,25 @@ int Game_Actor::SetSp(int sp) {
 void Game_Actor::SetBaseAtk(int atk) {
 	int new_attack_mod = data.attack_mod + (atk - GetBaseAtk());
 	data.attack_mod = ClampStatMod(new_attack_mod, this);
+	InvalidateStatCache();
 }
 
 void Game_Actor::SetBaseDef(int def) {
 	int new_defense_mod = data.defense_mod + (def - GetBaseDef());
 	data.defense_mod = ClampStatMod(new_defense_mod, this);
+	InvalidateStatCache();
 }
 
 void Game_Actor::SetBaseSpi(int spi) {
 	int new_spirit_mod = data.spirit_mod + (spi - GetBaseSpi());
 	data.spirit_mod = ClampStatMod(new_spirit_mod, this);
+	InvalidateStatCache();
 }
 
 void Game_Actor::SetBaseAgi(int agi) {
 	int new_agility_mod = data.agility_mod + (agi - GetBaseAgi());
 	data.agility_mod = ClampStatMod(new_agility_mod, this);
+	InvalidateStatCache();
 }
 
 Game_Actor::RowType Game_Actor::GetBattleRow() const {
@@ -19,6 +19,7 @@
 #define EP_GAME_ACTOR_H
 
 // Headers
+#include <array>
 #include <string>
 #include <vector>
 #include <cstdint>
@@ -526,6 +527,14 @@ public:
 	 */
 	const std::vector<int16_t>& GetWholeEquipment() const;
 
+	/**
+	 * Counter increased whenever the equipment of any actor changes.
+	 * Used to invalidate cached equipment totals.
+	 *
+	 * @return equipment revision
+	 */
+	static uint32_t GetEquipmentRevision();
+
 	/**
 	 * Checks if the actor has a specific item equipped.
 	 *
@@ -988,9 +997,38 @@ private:
 	 */
 	void RemoveInvalidData();
 
+	/** Slots of the cached stat block, Atk to Agi have one slot per Weapon mode starting at WeaponAll */
+	enum CachedStat {
+		CachedStat_MaxHp = 0,
+		CachedStat_MaxSp,
+		CachedStat_Atk,
+		CachedStat_Def = CachedStat_Atk + 4,
+		CachedStat_Spi = CachedStat_Def + 4,
+		CachedStat_Agi = CachedStat_Spi + 4,
+		CachedStat_Count = CachedStat_Agi + 4
+	};
+
+	/**
+	 * Returns the cached value of a stat slot, computing it with f on a miss.
+	 *
+	 * @param slot CachedStat slot
+	 * @param f functor returning the uncached value
+	 * @return stat value
+	 */
+	template <typename F>
+	int GetCachedStat(int slot, F&& f) const;
+
+	/**
+	 * Drops all cached base stats.
+	 * Must be called whenever level, class, equipment or a modifier changes.
+	 */
+	void InvalidateStatCache();
+
 	lcf::rpg::SaveActor data;
 	const lcf::rpg::Actor* dbActor = nullptr;
 	std::vector<int> exp_list;
+	mutable std::array<int, CachedStat_Count> stat_cache = {};
+	mutable uint32_t stat_cache_valid = 0;
 };
 
 inline Game_Battler::BattlerType Game_Actor::GetType() const {
@@ -31,6 +31,9 @@
 #include "game_pictures.h"
 #include "battle_animation.h"
 #include "game_battle.h"
+#include "game_battlealgorithm.h"
+#include "game_enemy.h"
+#include "enemyai.h"
 #include <lcf/reader_util.h>
 #include "spriteset_battle.h"
 #include "output.h"
@@ -63,7 +66,7 @@ namespace {
 	lcf::rpg::System::BattleFormation battle_form = lcf::rpg::System::BattleFormation_terrain;
 }
 
-void Game_Battle::Init(int troop_id) {
+void Game_Battle::Init(int troop_id, bool create_spriteset) {
 	// troop_id is guaranteed to be valid
 	troop = lcf::ReaderUtil::GetElement(lcf::Data::troops, troop_id);
 	assert(troop);
@@ -75,8 +78,11 @@ void Game_Battle::Init(int troop_id) {
 
 	interpreter.reset(new Game_Interpreter_Battle(troop->pages));
 	interpreter_pp.reset(new Game_Interpreter_Battle(troop->pages));
-	spriteset.reset(new Spriteset_Battle(background_name, terrain_id));
-	spriteset->Update();
+	spriteset.reset();
+	if (create_spriteset) {
+		spriteset.reset(new Spriteset_Battle(background_name, terrain_id));
+		spriteset->Update();
+	}
 	animation_actors.reset();
 	animation_enemies.reset();
 
@@ -133,6 +139,67 @@ void Game_Battle::UpdateGraphics() {
 	spriteset->Update();
 }
 
+void Game_Battle::PrepareBattleAction(Game_Battler* battler) {
+	if (battler->GetBattleAlgorithm() == nullptr) {
+		return;
+	}
+
+	if (!battler->CanAct()) {
+		if (battler->GetBattleAlgorithm()->GetType() != Game_BattleAlgorithm::Type::None) {
+			battler->SetBattleAlgorithm(std::make_shared<Game_BattleAlgorithm::None>(battler));
+		}
+		return;
+	}
+
+	if (battler->GetSignificantRestriction() == lcf::rpg::State::Restriction_attack_ally) {
+		Game_Battler *target = battler->GetType() == Game_Battler::Type_Enemy ?
+			Main_Data::game_enemyparty->GetRandomActiveBattler() :
+			Main_Data::game_party->GetRandomActiveBattler();
+
+		battler->SetBattleAlgorithm(std::make_shared<Game_BattleAlgorithm::Normal>(battler, target));
+		return;
+	}
+
+	if (battler->GetSignificantRestriction() == lcf::rpg::State::Restriction_attack_enemy) {
+		Game_Battler *target = battler->GetType() == Game_Battler::Type_Ally ?
+			Main_Data::game_enemyparty->GetRandomActiveBattler() :
+			Main_Data::game_party->GetRandomActiveBattler();
+
+		battler->SetBattleAlgorithm(std::make_shared<Game_BattleAlgorithm::Normal>(battler, target));
+		return;
+	}
+
+	// If we can no longer perform the action (no more items, ran out of SP, etc..)
+	if (!battler->GetBattleAlgorithm()->ActionIsPossible()) {
+		battler->SetBattleAlgorithm(std::make_shared<Game_BattleAlgorithm::None>(battler));
+	}
+}
+
+void Game_Battle::SelectEnemyAction(Game_Enemy& enemy, const std::vector<std::unique_ptr<EnemyAi::AlgorithmBase>>& algos, int default_algo) {
+	if (EnemyAi::SetStateRestrictedAction(enemy)) {
+		return;
+	}
+
+	const int algo = enemy.GetEnemyAi() == -1 ? default_algo : enemy.GetEnemyAi();
+	algos[algo]->SetEnemyAiAction(enemy);
+}
+
+void Game_Battle::CreateExecutionOrder(std::deque<Game_Battler*>& battlers) {
+	// Define random Agility. Must be done outside of the sort function because of the "strict weak ordering" property, so the sort is consistent
+	for (auto* battler : battlers) {
+		int battle_order = battler->GetAgi() + Rand::GetRandomNumber(0, battler->GetAgi() / 4 + 3);
+		if (battler->GetBattleAlgorithm()->GetType() == Game_BattleAlgorithm::Type::Normal && battler->HasPreemptiveAttack()) {
+			// RPG_RT sets this value
+			battle_order += 9999;
+		}
+		battler->SetBattleOrderAgi(battle_order);
+	}
+	std::sort(battlers.begin(), battlers.end(),
+			[](Game_Battler* l, Game_Battler* r) {
+			return l->GetBattleOrderAgi() > r->GetBattleOrderAgi();
+			});
+}
+
 bool Game_Battle::CheckWin() {
 	return !Main_Data::game_enemyparty->IsAnyActive();
 }
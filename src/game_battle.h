@@ -18,7 +18,10 @@
 #ifndef EP_GAME_BATTLE_H
 #define EP_GAME_BATTLE_H
 
+#include <deque>
 #include <functional>
+#include <memory>
+#include <vector>
 #include <lcf/rpg/fwd.h>
 #include <lcf/rpg/system.h>
 #include <lcf/rpg/troop.h>
@@ -35,6 +38,10 @@ class Game_Interpreter;
 class Game_Interpreter_Battle;
 class Spriteset_Battle;
 
+namespace EnemyAi {
+class AlgorithmBase;
+}
+
 enum class BattleResult {
 	Victory,
 	Escape,
@@ -46,8 +53,11 @@ enum class BattleResult {
 namespace Game_Battle {
 	/**
 	 * Initialize Game_Battle.
+	 *
+	 * @param troop_id troop to fight against
+	 * @param create_spriteset false for battles without graphics
 	 */
-	void Init(int troop_id);
+	void Init(int troop_id, bool create_spriteset = true);
 
 	/** @return true if a battle is currently running */
 	bool IsBattleRunning();
@@ -81,6 +91,33 @@ namespace Game_Battle {
 	 */
 	bool CheckLose();
 
+	/**
+	 * Adjusts the pending action of a battler right before it is executed.
+	 * Battlers which cannot act do nothing, confused and provoked battlers
+	 * attack a random target and actions which became impossible are dropped.
+	 *
+	 * @param battler battler about to act
+	 */
+	void PrepareBattleAction(Game_Battler* battler);
+
+	/**
+	 * Selects the action of an enemy with its EnemyAi algorithm.
+	 * Enemies restricted by a state get the action of the state instead.
+	 *
+	 * @param enemy enemy to select the action for
+	 * @param algos EnemyAi algorithms indexed by their ID
+	 * @param default_algo algorithm of enemies without an own algorithm
+	 */
+	void SelectEnemyAction(Game_Enemy& enemy, const std::vector<std::unique_ptr<EnemyAi::AlgorithmBase>>& algos, int default_algo);
+
+	/**
+	 * Sorts the battlers by their agility plus a random bonus, the turn order
+	 * of the RPG Maker 2000 battle system. Preemptive attacks come first.
+	 *
+	 * @param battlers battlers with a selected action
+	 */
+	void CreateExecutionOrder(std::deque<Game_Battler*>& battlers);
+
 	Spriteset_Battle& GetSpriteset();
 
 	/**
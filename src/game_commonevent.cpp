@@ -140,6 +140,17 @@ std::vector<lcf::rpg::EventCommand>& Game_CommonEvent::GetList() {
 	return lcf::ReaderUtil::GetElement(lcf::Data::commonevents, common_event_id)->event_commands;
 }
 
+Game_Interpreter::CommandList Game_CommonEvent::GetCommandList() {
+	if (!commands) {
+		InterpreterProfiler::Source source;
+		source.type = InterpreterProfiler::SourceType::CommonEvent;
+		source.event_id = common_event_id;
+
+		commands = std::make_shared<const Game_Interpreter::SharedCommands>(GetList(), source);
+	}
+	return commands;
+}
+
 lcf::rpg::SaveEventExecState Game_CommonEvent::GetSaveData() {
 	lcf::rpg::SaveEventExecState state;
 	if (interpreter) {
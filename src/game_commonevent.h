@@ -108,6 +108,14 @@ public:
 	 */
 	std::vector<lcf::rpg::EventCommand>& GetList();
 
+	/**
+	 * Gets the shared event commands list executed by interpreters.
+	 * Created from the database on first use.
+	 *
+	 * @return event commands list.
+	 */
+	Game_Interpreter::CommandList GetCommandList();
+
 	lcf::rpg::SaveEventExecState GetSaveData();
 
 	/** @return true if waiting for foreground execution */
@@ -129,6 +137,8 @@ public:
 private:
 	int common_event_id;
 
+	Game_Interpreter::CommandList commands;
+
 	/** Interpreter for parallel common events. */
 	std::unique_ptr<Game_Interpreter_Map> interpreter;
 	std::unique_ptr<Game_Interpreter_Battle> interpreter_pp;
@@ -151,12 +151,12 @@ void Game_Destiny::Terminate()
 	// TODO [XGB]: Clear ClientSocket container
 }
 
-bool Game_Destiny::Main(SaveEventExecFrame& frame)
+bool Game_Destiny::Main(SaveEventExecFrame& frame, const std::vector<EventCommand>& cmdList)
 {
 	const char* script;
 	InterpretFlag flag;
 
-	script = _interpreter.MakeString(frame);
+	script = _interpreter.MakeString(frame, cmdList);
 	flag = InterpretFlag::IF_EXIT;
 
 	_interpreter.CleanUpData();
@@ -213,12 +213,11 @@ Interpreter::Interpreter()
 	_scriptPtr = nullptr;
 }
 
-const char* Interpreter::MakeString(SaveEventExecFrame& frame)
+const char* Interpreter::MakeString(SaveEventExecFrame& frame, const std::vector<EventCommand>& cmdList)
 {
 	std::string code;
 
 	int32_t& current = frame.current_command;
-	const std::vector<EventCommand>& cmdList = frame.commands;
 	std::vector<EventCommand>::const_iterator it = cmdList.begin() + current++;
 
 	code = ToString((*it++).string);
@@ -215,9 +215,10 @@ namespace Destiny
 			 * Generates a DestinyScript code.
 			 *
 			 * @param frame		The event script data.
+			 * @param cmdList	The commands executed by the frame.
 			 * @return			A DestinyScript code.
 			 */
-			const char* MakeString(lcf::rpg::SaveEventExecFrame& frame);
+			const char* MakeString(lcf::rpg::SaveEventExecFrame& frame, const std::vector<lcf::rpg::EventCommand>& cmdList);
 
 			/**
 			 * Releases the DestinyScript code.
@@ -421,9 +422,10 @@ public:
 	 * Call the Destiny Interpreter and run the received code.
 	 *
 	 * @param frame		The event script data.
+	 * @param cmdList	The commands executed by the frame.
 	 * @return			Whether evaluation is successful.
 	 */
-	bool Main(lcf::rpg::SaveEventExecFrame& frame);
+	bool Main(lcf::rpg::SaveEventExecFrame& frame, const std::vector<lcf::rpg::EventCommand>& cmdList);
 
 
 	// Inline functions
@@ -263,8 +263,7 @@ bool Game_Event::AreConditionsMet(const lcf::rpg::EventPage& page) {
 	}
 
 	// Item in possession?
-	if (page.condition.flags.item && !(Main_Data::game_party->GetItemCount(page.condition.item_id)
-		+ Main_Data::game_party->GetEquippedItemCount(page.condition.item_id))) {
+	if (page.condition.flags.item && Main_Data::game_party->GetItemTotalCount(page.condition.item_id) == 0) {
 			return false;
 	}
 
@@ -340,6 +339,27 @@ const std::vector<lcf::rpg::EventCommand>& Game_Event::GetList() const {
 	return page ? page->event_commands : _empty_list;
 }
 
+Game_Interpreter::CommandList Game_Event::GetCommandList(const lcf::rpg::EventPage* page) {
+	assert(page >= event->pages.data() && page < event->pages.data() + event->pages.size());
+	const size_t idx = page - event->pages.data();
+
+	if (page_commands.size() < event->pages.size()) {
+		page_commands.resize(event->pages.size());
+	}
+
+	auto& commands = page_commands[idx];
+	if (!commands) {
+		InterpreterProfiler::Source source;
+		source.type = InterpreterProfiler::SourceType::MapEvent;
+		source.map_id = GetMapId();
+		source.event_id = GetId();
+		source.page_id = page->ID;
+
+		commands = std::make_shared<const Game_Interpreter::SharedCommands>(page->event_commands, source);
+	}
+	return commands;
+}
+
 void Game_Event::OnFinishForegroundEvent() {
 	UpdateFacing();
 	SetPaused(false);
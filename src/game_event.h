@@ -107,6 +107,15 @@ public:
 	 */
 	const std::vector<lcf::rpg::EventCommand>& GetList() const;
 
+	/**
+	 * Gets the shared event commands list of a page executed by interpreters.
+	 * Created on first use and kept for the lifetime of the event.
+	 *
+	 * @param page page of this event
+	 * @return event commands list.
+	 */
+	Game_Interpreter::CommandList GetCommandList(const lcf::rpg::EventPage* page);
+
 	/**
 	 * Event returns to its original direction before talking to the hero.
 	 */
@@ -216,6 +225,8 @@ private:
 
 	const lcf::rpg::Event* event = nullptr;
 	const lcf::rpg::EventPage* page = nullptr;
+	/** Shared command lists indexed by page */
+	std::vector<Game_Interpreter::CommandList> page_commands;
 	std::unique_ptr<Game_Interpreter_Map> interpreter;
 
 	friend class Scene_Debug;
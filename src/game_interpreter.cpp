@@ -57,6 +57,7 @@
 #include "scene.h"
 #include "game_clock.h"
 #include "input.h"
+#include "interpreter_profiler.h"
 #include "main_data.h"
 #include "output.h"
 #include "player.h"
@@ -80,6 +81,36 @@ enum BranchSubcommand {
 	eOptionBranchElse = 1
 };
 
+namespace {
+	/**
+	 * Invokes f with std::integral_constant<int, value>.
+	 * Turns a code decoded at runtime into a template argument.
+	 *
+	 * @tparam N amount of codes, value must be in [0, N)
+	 */
+	template<int N, int I = 0, typename F>
+	auto DispatchCode(int value, F&& f) {
+		if constexpr (I + 1 < N) {
+			if (value != I) {
+				return DispatchCode<N, I + 1>(value, std::forward<F>(f));
+			}
+		}
+		return f(std::integral_constant<int, I>());
+	}
+
+	/** Value of an operand with a mode that does not depend on patches, @see Game_Interpreter_Shared::ValueOrVariable */
+	template<int mode>
+	int OperandValue(int val) {
+		static_assert(mode == eValueEval_Constant || mode == eValueEval_Variable, "Unsupported mode");
+
+		if constexpr (mode == eValueEval_Constant) {
+			return val;
+		} else {
+			return Main_Data::game_variables->Get(val);
+		}
+	}
+}
+
 Game_Interpreter::Game_Interpreter(bool _main_flag) {
 	main_flag = _main_flag;
 
@@ -92,6 +123,7 @@ Game_Interpreter::~Game_Interpreter() {
 // Clear.
 void Game_Interpreter::Clear() {
 	_state = {};
+	_frame_commands.clear();
 	_keyinput = {};
 	_async_op = {};
 }
@@ -103,12 +135,12 @@ bool Game_Interpreter::IsRunning() const {
 
 // Setup.
 void Game_Interpreter::Push(
-	std::vector<lcf::rpg::EventCommand> _list,
+	CommandList _list,
 	int event_id,
 	bool started_by_decision_key,
 	int event_page_id
 ) {
-	if (_list.empty()) {
+	if (!_list || _list->empty()) {
 		return;
 	}
 
@@ -117,9 +149,9 @@ void Game_Interpreter::Push(
 		Output::Error("Call Event limit ({}) has been exceeded", call_stack_limit);
 	}
 
+	// The commands are not stored in the frame, they are only copied into it when saving.
 	lcf::rpg::SaveEventExecFrame frame;
 	frame.ID = _state.stack.size() + 1;
-	frame.commands = std::move(_list);
 	frame.current_command = 0;
 	frame.triggered_by_decision_key = started_by_decision_key;
 	frame.event_id = event_id;
@@ -133,6 +165,25 @@ void Game_Interpreter::Push(
 	}
 
 	_state.stack.push_back(std::move(frame));
+	const auto& decoded = GetDecodedList(*_list);
+	_frame_commands.push_back({ std::move(_list), &decoded });
+}
+
+void Game_Interpreter::Push(
+	std::vector<lcf::rpg::EventCommand> _list,
+	int event_id,
+	bool started_by_decision_key,
+	int event_page_id
+) {
+	if (_list.empty()) {
+		return;
+	}
+
+	InterpreterProfiler::Source source;
+	source.event_id = event_id;
+	source.page_id = event_page_id;
+
+	Push(std::make_shared<const SharedCommands>(std::move(_list), source), event_id, started_by_decision_key, event_page_id);
 }
 
 
@@ -287,10 +338,59 @@ const lcf::rpg::SaveEventExecState& Game_Interpreter::GetState() const {
 
 lcf::rpg::SaveEventExecState Game_Interpreter::GetSaveState() {
 	auto save = _state;
+	for (size_t i = 0; i < save.stack.size(); ++i) {
+		save.stack[i].commands = _frame_commands[i].list->commands;
+	}
 	_keyinput.toSave(save);
 	return save;
 }
 
+void Game_Interpreter::ShareStateCommands() {
+	_frame_commands.clear();
+	_frame_commands.reserve(_state.stack.size());
+	for (auto& frame: _state.stack) {
+		InterpreterProfiler::Source source;
+		source.event_id = frame.event_id;
+		source.page_id = frame.maniac_event_page_id;
+
+		auto list = std::make_shared<const SharedCommands>(std::move(frame.commands), source);
+		frame.commands.clear();
+		const auto& decoded = GetDecodedList(*list);
+		_frame_commands.push_back({ std::move(list), &decoded });
+	}
+}
+
+const Game_Interpreter::DecodedList& Game_Interpreter::GetDecodedList(const SharedCommands& list) const {
+	const auto& type = typeid(*this);
+	for (const auto& decoded: list.decoded) {
+		if (*decoded->type == type) {
+			return *decoded;
+		}
+	}
+
+	auto decoded = std::make_unique<DecodedList>();
+	decoded->type = &type;
+	decoded->commands.reserve(list.commands.size());
+
+	for (const auto& com: list.commands) {
+		auto entry = DecodeCommand(com);
+		const lcf::rpg::EventCommand* dcom = &com;
+
+		if (entry.handler && com.parameters.size() < entry.min_size) {
+			// Only happens for malformed commands
+			auto& ncom = decoded->padded.emplace_back(com);
+			ncom.parameters = lcf::DBArray<int32_t>(entry.min_size);
+			std::copy(com.parameters.begin(), com.parameters.end(), ncom.parameters.begin());
+			dcom = &ncom;
+		}
+
+		decoded->commands.push_back({ entry.handler, dcom });
+	}
+
+	list.decoded.push_back(std::move(decoded));
+	return *list.decoded.back();
+}
+
 
 void Game_Interpreter::SetupWait(int duration) {
 	if (duration == 0) {
@@ -385,6 +485,8 @@ void Game_Interpreter::Update(bool reset_loop_count) {
 		return;
 	}
 
+	const bool profile = InterpreterProfiler::IsEnabled();
+
 	for (; loop_count < loop_limit; ++loop_count) {
 		// If something is calling a menu, we're allowed to execute only 1 command per interpreter. So we pass through if loop_count == 0, and stop at 1 or greater.
 		// RPG_RT compatible behavior.
@@ -487,7 +589,7 @@ void Game_Interpreter::Update(bool reset_loop_count) {
 		}
 
 		// Pop any completed stack frames
-		if (frame->current_command >= (int)frame->commands.size()) {
+		if (frame->current_command >= (int)GetFrameCommands().size()) {
 			if (!OnFinishStackFrame()) {
 				break;
 			}
@@ -498,7 +600,19 @@ void Game_Interpreter::Update(bool reset_loop_count) {
 		int current_frame_idx = _state.stack.size() - 1;
 
 		const int index_before_exec = frame->current_command;
-		if (!ExecuteCommand()) {
+		bool keep_running;
+		if (profile) {
+			// The command can pop the frame, fetch everything before executing
+			const auto source = _frame_commands.back().list->source;
+			const int code = GetFrameCommands()[index_before_exec].code;
+			const auto start = Game_Clock::now();
+			keep_running = ExecuteCommand();
+			InterpreterProfiler::Record(source, index_before_exec, code,
+				std::chrono::duration_cast<std::chrono::nanoseconds>(Game_Clock::now() - start));
+		} else {
+			keep_running = ExecuteCommand();
+		}
+		if (!keep_running) {
 			break;
 		}
 
@@ -537,15 +651,19 @@ void Game_Interpreter::Update(bool reset_loop_count) {
 
 // Setup Starting Event
 void Game_Interpreter::Push(Game_Event* ev) {
-	Push(ev->GetList(), ev->GetId(), ev->WasStartedByDecisionKey(), ev->GetActivePage() ? ev->GetActivePage()->ID : 0);
+	auto* page = ev->GetActivePage();
+	if (!page) {
+		return;
+	}
+	Push(ev->GetCommandList(page), ev->GetId(), ev->WasStartedByDecisionKey(), page->ID);
 }
 
 void Game_Interpreter::Push(Game_Event* ev, const lcf::rpg::EventPage* page, bool triggered_by_decision_key) {
-	Push(page->event_commands, ev->GetId(), triggered_by_decision_key, page->ID);
+	Push(ev->GetCommandList(page), ev->GetId(), triggered_by_decision_key, page->ID);
 }
 
 void Game_Interpreter::Push(Game_CommonEvent* ev) {
-	Push(ev->GetList(), 0, false);
+	Push(ev->GetCommandList(), 0, false);
 }
 
 bool Game_Interpreter::CheckGameOver() {
@@ -561,7 +679,7 @@ bool Game_Interpreter::CheckGameOver() {
 
 void Game_Interpreter::SkipToNextConditional(std::initializer_list<Cmd> codes, int indent) {
 	auto& frame = GetFrame();
-	const auto& list = frame.commands;
+	const auto& list = GetFrameCommands();
 	auto& index = frame.current_command;
 
 	if (index >= static_cast<int>(list.size())) {
@@ -582,234 +700,312 @@ void Game_Interpreter::SkipToNextConditional(std::initializer_list<Cmd> codes, i
 // Execute Command.
 bool Game_Interpreter::ExecuteCommand() {
 	auto& frame = GetFrame();
-	const auto& com = frame.commands[frame.current_command];
-	return ExecuteCommand(com);
+	const auto& decoded = _frame_commands.back().decoded->commands[frame.current_command];
+	if (!decoded.handler) {
+		return true;
+	}
+	return decoded.handler(*this, *decoded.com);
 }
 
-bool Game_Interpreter::ExecuteCommand(lcf::rpg::EventCommand const& com) {
+Game_Interpreter::CommandEntry Game_Interpreter::DecodeCommand(lcf::rpg::EventCommand const& com) const {
 	switch (static_cast<Cmd>(com.code)) {
 		case Cmd::ShowMessage:
-			return CmdSetup<&Game_Interpreter::CommandShowMessage, 0>(com);
+			return CmdDecode<&Game_Interpreter::CommandShowMessage, 0>();
 		case Cmd::MessageOptions:
-			return CmdSetup<&Game_Interpreter::CommandMessageOptions, 4>(com);
+			return CmdDecode<&Game_Interpreter::CommandMessageOptions, 4>();
 		case Cmd::ChangeFaceGraphic:
-			return CmdSetup<&Game_Interpreter::CommandChangeFaceGraphic, 3>(com);
+			return CmdDecode<&Game_Interpreter::CommandChangeFaceGraphic, 3>();
 		case Cmd::ShowChoice:
-			return CmdSetup<&Game_Interpreter::CommandShowChoices, 1>(com);
+			return CmdDecode<&Game_Interpreter::CommandShowChoices, 1>();
 		case Cmd::ShowChoiceOption:
-			return CmdSetup<&Game_Interpreter::CommandShowChoiceOption, 1>(com);
+			return CmdDecode<&Game_Interpreter::CommandShowChoiceOption, 1>();
 		case Cmd::ShowChoiceEnd:
-			return CmdSetup<&Game_Interpreter::CommandShowChoiceEnd, 0>(com);
+			return CmdDecode<&Game_Interpreter::CommandShowChoiceEnd, 0>();
 		case Cmd::InputNumber:
-			return CmdSetup<&Game_Interpreter::CommandInputNumber, 2>(com);
+			return CmdDecode<&Game_Interpreter::CommandInputNumber, 2>();
 		case Cmd::ControlSwitches:
-			return CmdSetup<&Game_Interpreter::CommandControlSwitches, 4>(com);
+			return CmdDecode<&Game_Interpreter::CommandControlSwitches, 4>();
 		case Cmd::ControlVars:
-			return CmdSetup<&Game_Interpreter::CommandControlVariables, 7>(com);
+			if (auto handler = DecodeControlVariablesSpecialized(com)) {
+				return { handler, 7 };
+			}
+			return CmdDecode<&Game_Interpreter::CommandControlVariables, 7>();
 		case Cmd::TimerOperation:
-			return CmdSetup<&Game_Interpreter::CommandTimerOperation, 5>(com);
+			return CmdDecode<&Game_Interpreter::CommandTimerOperation, 5>();
 		case Cmd::ChangeGold:
-			return CmdSetup<&Game_Interpreter::CommandChangeGold, 3>(com);
+			return CmdDecode<&Game_Interpreter::CommandChangeGold, 3>();
 		case Cmd::ChangeItems:
-			return CmdSetup<&Game_Interpreter::CommandChangeItems, 5>(com);
+			return CmdDecode<&Game_Interpreter::CommandChangeItems, 5>();
 		case Cmd::ChangePartyMembers:
-			return CmdSetup<&Game_Interpreter::CommandChangePartyMember, 3>(com);
+			return CmdDecode<&Game_Interpreter::CommandChangePartyMember, 3>();
 		case Cmd::ChangeExp:
-			return CmdSetup<&Game_Interpreter::CommandChangeExp, 6>(com);
+			return CmdDecode<&Game_Interpreter::CommandChangeExp, 6>();
 		case Cmd::ChangeLevel:
-			return CmdSetup<&Game_Interpreter::CommandChangeLevel, 6>(com);
+			return CmdDecode<&Game_Interpreter::CommandChangeLevel, 6>();
 		case Cmd::ChangeParameters:
-			return CmdSetup<&Game_Interpreter::CommandChangeParameters, 6>(com);
+			return CmdDecode<&Game_Interpreter::CommandChangeParameters, 6>();
 		case Cmd::ChangeSkills:
-			return CmdSetup<&Game_Interpreter::CommandChangeSkills, 5>(com);
+			return CmdDecode<&Game_Interpreter::CommandChangeSkills, 5>();
 		case Cmd::ChangeEquipment:
-			return CmdSetup<&Game_Interpreter::CommandChangeEquipment, 5>(com);
+			return CmdDecode<&Game_Interpreter::CommandChangeEquipment, 5>();
 		case Cmd::ChangeHP:
-			return CmdSetup<&Game_Interpreter::CommandChangeHP, 6>(com);
+			return CmdDecode<&Game_Interpreter::CommandChangeHP, 6>();
 		case Cmd::ChangeSP:
-			return CmdSetup<&Game_Interpreter::CommandChangeSP, 5>(com);
+			return CmdDecode<&Game_Interpreter::CommandChangeSP, 5>();
 		case Cmd::ChangeCondition:
-			return CmdSetup<&Game_Interpreter::CommandChangeCondition, 4>(com);
+			return CmdDecode<&Game_Interpreter::CommandChangeCondition, 4>();
 		case Cmd::FullHeal:
-			return CmdSetup<&Game_Interpreter::CommandFullHeal, 2>(com);
+			return CmdDecode<&Game_Interpreter::CommandFullHeal, 2>();
 		case Cmd::SimulatedAttack:
-			return CmdSetup<&Game_Interpreter::CommandSimulatedAttack, 8>(com);
+			return CmdDecode<&Game_Interpreter::CommandSimulatedAttack, 8>();
 		case Cmd::Wait:
-			return CmdSetup<&Game_Interpreter::CommandWait, 1>(com);
+			return CmdDecode<&Game_Interpreter::CommandWait, 1>();
 		case Cmd::PlayBGM:
-			return CmdSetup<&Game_Interpreter::CommandPlayBGM, 4>(com);
+			return CmdDecode<&Game_Interpreter::CommandPlayBGM, 4>();
 		case Cmd::FadeOutBGM:
-			return CmdSetup<&Game_Interpreter::CommandFadeOutBGM, 1>(com);
+			return CmdDecode<&Game_Interpreter::CommandFadeOutBGM, 1>();
 		case Cmd::PlaySound:
-			return CmdSetup<&Game_Interpreter::CommandPlaySound, 3>(com);
+			return CmdDecode<&Game_Interpreter::CommandPlaySound, 3>();
 		case Cmd::EndEventProcessing:
-			return CmdSetup<&Game_Interpreter::CommandEndEventProcessing, 0>(com);
+			return CmdDecode<&Game_Interpreter::CommandEndEventProcessing, 0>();
 		case Cmd::Comment:
 		case Cmd::Comment_2:
-			return CmdSetup<&Game_Interpreter::CommandComment, 0>(com);
+			return CmdDecode<&Game_Interpreter::CommandComment, 0>();
 		case Cmd::GameOver:
-			return CmdSetup<&Game_Interpreter::CommandGameOver, 0>(com);
+			return CmdDecode<&Game_Interpreter::CommandGameOver, 0>();
 		case Cmd::ChangeHeroName:
-			return CmdSetup<&Game_Interpreter::CommandChangeHeroName, 1>(com);
+			return CmdDecode<&Game_Interpreter::CommandChangeHeroName, 1>();
 		case Cmd::ChangeHeroTitle:
-			return CmdSetup<&Game_Interpreter::CommandChangeHeroTitle, 1>(com);
+			return CmdDecode<&Game_Interpreter::CommandChangeHeroTitle, 1>();
 		case Cmd::ChangeSpriteAssociation:
-			return CmdSetup<&Game_Interpreter::CommandChangeSpriteAssociation, 3>(com);
+			return CmdDecode<&Game_Interpreter::CommandChangeSpriteAssociation, 3>();
 		case Cmd::ChangeActorFace:
-			return CmdSetup<&Game_Interpreter::CommandChangeActorFace, 2>(com);
+			return CmdDecode<&Game_Interpreter::CommandChangeActorFace, 2>();
 		case Cmd::ChangeVehicleGraphic:
-			return CmdSetup<&Game_Interpreter::CommandChangeVehicleGraphic, 2>(com);
+			return CmdDecode<&Game_Interpreter::CommandChangeVehicleGraphic, 2>();
 		case Cmd::ChangeSystemBGM:
-			return CmdSetup<&Game_Interpreter::CommandChangeSystemBGM, 5>(com);
+			return CmdDecode<&Game_Interpreter::CommandChangeSystemBGM, 5>();
 		case Cmd::ChangeSystemSFX:
-			return CmdSetup<&Game_Interpreter::CommandChangeSystemSFX, 4>(com);
+			return CmdDecode<&Game_Interpreter::CommandChangeSystemSFX, 4>();
 		case Cmd::ChangeSystemGraphics:
-			return CmdSetup<&Game_Interpreter::CommandChangeSystemGraphics, 2>(com);
+			return CmdDecode<&Game_Interpreter::CommandChangeSystemGraphics, 2>();
 		case Cmd::ChangeScreenTransitions:
-			return CmdSetup<&Game_Interpreter::CommandChangeScreenTransitions, 2>(com);
+			return CmdDecode<&Game_Interpreter::CommandChangeScreenTransitions, 2>();
 		case Cmd::MemorizeLocation:
-			return CmdSetup<&Game_Interpreter::CommandMemorizeLocation, 3>(com);
+			return CmdDecode<&Game_Interpreter::CommandMemorizeLocation, 3>();
 		case Cmd::SetVehicleLocation:
-			return CmdSetup<&Game_Interpreter::CommandSetVehicleLocation, 5>(com);
+			return CmdDecode<&Game_Interpreter::CommandSetVehicleLocation, 5>();
 		case Cmd::ChangeEventLocation:
-			return CmdSetup<&Game_Interpreter::CommandChangeEventLocation, 4>(com);
+			return CmdDecode<&Game_Interpreter::CommandChangeEventLocation, 4>();
 		case Cmd::TradeEventLocations:
-			return CmdSetup<&Game_Interpreter::CommandTradeEventLocations, 2>(com);
+			return CmdDecode<&Game_Interpreter::CommandTradeEventLocations, 2>();
 		case Cmd::StoreTerrainID:
-			return CmdSetup<&Game_Interpreter::CommandStoreTerrainID, 4>(com);
+			return CmdDecode<&Game_Interpreter::CommandStoreTerrainID, 4>();
 		case Cmd::StoreEventID:
-			return CmdSetup<&Game_Interpreter::CommandStoreEventID, 4>(com);
+			return CmdDecode<&Game_Interpreter::CommandStoreEventID, 4>();
 		case Cmd::EraseScreen:
-			return CmdSetup<&Game_Interpreter::CommandEraseScreen, 1>(com);
+			return CmdDecode<&Game_Interpreter::CommandEraseScreen, 1>();
 		case Cmd::ShowScreen:
-			return CmdSetup<&Game_Interpreter::CommandShowScreen, 1>(com);
+			return CmdDecode<&Game_Interpreter::CommandShowScreen, 1>();
 		case Cmd::TintScreen:
-			return CmdSetup<&Game_Interpreter::CommandTintScreen, 6>(com);
+			return CmdDecode<&Game_Interpreter::CommandTintScreen, 6>();
 		case Cmd::FlashScreen:
-			return CmdSetup<&Game_Interpreter::CommandFlashScreen, 6>(com);
+			return CmdDecode<&Game_Interpreter::CommandFlashScreen, 6>();
 		case Cmd::ShakeScreen:
-			return CmdSetup<&Game_Interpreter::CommandShakeScreen, 4>(com);
+			return CmdDecode<&Game_Interpreter::CommandShakeScreen, 4>();
 		case Cmd::WeatherEffects:
-			return CmdSetup<&Game_Interpreter::CommandWeatherEffects, 2>(com);
+			return CmdDecode<&Game_Interpreter::CommandWeatherEffects, 2>();
 		case Cmd::ShowPicture:
-			return CmdSetup<&Game_Interpreter::CommandShowPicture, 14>(com);
+			return CmdDecode<&Game_Interpreter::CommandShowPicture, 14>();
 		case Cmd::MovePicture:
-			return CmdSetup<&Game_Interpreter::CommandMovePicture, 16>(com);
+			return CmdDecode<&Game_Interpreter::CommandMovePicture, 16>();
 		case Cmd::ErasePicture:
-			return CmdSetup<&Game_Interpreter::CommandErasePicture, 1>(com);
+			return CmdDecode<&Game_Interpreter::CommandErasePicture, 1>();
 		case Cmd::PlayerVisibility:
-			return CmdSetup<&Game_Interpreter::CommandPlayerVisibility, 1>(com);
+			return CmdDecode<&Game_Interpreter::CommandPlayerVisibility, 1>();
 		case Cmd::MoveEvent:
-			return CmdSetup<&Game_Interpreter::CommandMoveEvent, 4>(com);
+			return CmdDecode<&Game_Interpreter::CommandMoveEvent, 4>();
 		case Cmd::MemorizeBGM:
-			return CmdSetup<&Game_Interpreter::CommandMemorizeBGM, 0>(com);
+			return CmdDecode<&Game_Interpreter::CommandMemorizeBGM, 0>();
 		case Cmd::PlayMemorizedBGM:
-			return CmdSetup<&Game_Interpreter::CommandPlayMemorizedBGM, 0>(com);
+			return CmdDecode<&Game_Interpreter::CommandPlayMemorizedBGM, 0>();
 		case Cmd::KeyInputProc:
-			return CmdSetup<&Game_Interpreter::CommandKeyInputProc, 5>(com);
+			return CmdDecode<&Game_Interpreter::CommandKeyInputProc, 5>();
 		case Cmd::ChangeMapTileset:
-			return CmdSetup<&Game_Interpreter::CommandChangeMapTileset, 1>(com);
+			return CmdDecode<&Game_Interpreter::CommandChangeMapTileset, 1>();
 		case Cmd::ChangePBG:
-			return CmdSetup<&Game_Interpreter::CommandChangePBG, 6>(com);
+			return CmdDecode<&Game_Interpreter::CommandChangePBG, 6>();
 		case Cmd::ChangeEncounterSteps:
-			return CmdSetup<&Game_Interpreter::CommandChangeEncounterSteps, 1>(com);
+			return CmdDecode<&Game_Interpreter::CommandChangeEncounterSteps, 1>();
 		case Cmd::TileSubstitution:
-			return CmdSetup<&Game_Interpreter::CommandTileSubstitution, 3>(com);
+			return CmdDecode<&Game_Interpreter::CommandTileSubstitution, 3>();
 		case Cmd::TeleportTargets:
-			return CmdSetup<&Game_Interpreter::CommandTeleportTargets, 6>(com);
+			return CmdDecode<&Game_Interpreter::CommandTeleportTargets, 6>();
 		case Cmd::ChangeTeleportAccess:
-			return CmdSetup<&Game_Interpreter::CommandChangeTeleportAccess, 1>(com);
+			return CmdDecode<&Game_Interpreter::CommandChangeTeleportAccess, 1>();
 		case Cmd::EscapeTarget:
-			return CmdSetup<&Game_Interpreter::CommandEscapeTarget, 5>(com);
+			return CmdDecode<&Game_Interpreter::CommandEscapeTarget, 5>();
 		case Cmd::ChangeEscapeAccess:
-			return CmdSetup<&Game_Interpreter::CommandChangeEscapeAccess, 1>(com);
+			return CmdDecode<&Game_Interpreter::CommandChangeEscapeAccess, 1>();
 		case Cmd::ChangeSaveAccess:
-			return CmdSetup<&Game_Interpreter::CommandChangeSaveAccess, 1>(com);
+			return CmdDecode<&Game_Interpreter::CommandChangeSaveAccess, 1>();
 		case Cmd::ChangeMainMenuAccess:
-			return CmdSetup<&Game_Interpreter::CommandChangeMainMenuAccess, 1>(com);
+			return CmdDecode<&Game_Interpreter::CommandChangeMainMenuAccess, 1>();
 		case Cmd::ConditionalBranch:
-			return CmdSetup<&Game_Interpreter::CommandConditionalBranch, 6>(com);
+			if (auto handler = DecodeConditionalBranchSpecialized(com)) {
+				return { handler, 6 };
+			}
+			return CmdDecode<&Game_Interpreter::CommandConditionalBranch, 6>();
 		case Cmd::Label:
-			return true;
+			return {};
 		case Cmd::JumpToLabel:
-			return CmdSetup<&Game_Interpreter::CommandJumpToLabel, 1>(com);
+			return CmdDecode<&Game_Interpreter::CommandJumpToLabel, 1>();
 		case Cmd::Loop:
-			return CmdSetup<&Game_Interpreter::CommandLoop, 0>(com);
+			return CmdDecode<&Game_Interpreter::CommandLoop, 0>();
 		case Cmd::BreakLoop:
-			return CmdSetup<&Game_Interpreter::CommandBreakLoop, 0>(com);
+			return CmdDecode<&Game_Interpreter::CommandBreakLoop, 0>();
 		case Cmd::EndLoop:
-			return CmdSetup<&Game_Interpreter::CommandEndLoop, 0>(com);
+			if (auto handler = DecodeEndLoopSpecialized(com)) {
+				return { handler, 5 };
+			}
+			return CmdDecode<&Game_Interpreter::CommandEndLoop, 0>();
 		case Cmd::EraseEvent:
-			return CmdSetup<&Game_Interpreter::CommandEraseEvent, 0>(com);
+			return CmdDecode<&Game_Interpreter::CommandEraseEvent, 0>();
 		case Cmd::CallEvent:
-			return CmdSetup<&Game_Interpreter::CommandCallEvent, 3>(com);
+			return CmdDecode<&Game_Interpreter::CommandCallEvent, 3>();
 		case Cmd::ReturntoTitleScreen:
-			return CmdSetup<&Game_Interpreter::CommandReturnToTitleScreen, 0>(com);
+			return CmdDecode<&Game_Interpreter::CommandReturnToTitleScreen, 0>();
 		case Cmd::ChangeClass:
-			return CmdSetup<&Game_Interpreter::CommandChangeClass, 7>(com);
+			return CmdDecode<&Game_Interpreter::CommandChangeClass, 7>();
 		case Cmd::ChangeBattleCommands:
-			return CmdSetup<&Game_Interpreter::CommandChangeBattleCommands, 4>(com);
+			return CmdDecode<&Game_Interpreter::CommandChangeBattleCommands, 4>();
 		case Cmd::ElseBranch:
-			return CmdSetup<&Game_Interpreter::CommandElseBranch, 0>(com);
+			return CmdDecode<&Game_Interpreter::CommandElseBranch, 0>();
 		case Cmd::EndBranch:
-			return CmdSetup<&Game_Interpreter::CommandEndBranch, 0>(com);
+			return CmdDecode<&Game_Interpreter::CommandEndBranch, 0>();
 		case Cmd::ExitGame:
-			return CmdSetup<&Game_Interpreter::CommandExitGame, 0>(com);
+			return CmdDecode<&Game_Interpreter::CommandExitGame, 0>();
 		case Cmd::ToggleFullscreen:
-			return CmdSetup<&Game_Interpreter::CommandToggleFullscreen, 0>(com);
+			return CmdDecode<&Game_Interpreter::CommandToggleFullscreen, 0>();
 		case Cmd::OpenVideoOptions:
-			return CmdSetup<&Game_Interpreter::CommandOpenVideoOptions, 0>(com);
+			return CmdDecode<&Game_Interpreter::CommandOpenVideoOptions, 0>();
 		case Cmd::Maniac_GetSaveInfo:
-			return CmdSetup<&Game_Interpreter::CommandManiacGetSaveInfo, 12>(com);
+			return CmdDecode<&Game_Interpreter::CommandManiacGetSaveInfo, 12>();
 		case Cmd::Maniac_Load:
-			return CmdSetup<&Game_Interpreter::CommandManiacLoad, 3>(com);
+			return CmdDecode<&Game_Interpreter::CommandManiacLoad, 3>();
 		case Cmd::Maniac_Save:
-			return CmdSetup<&Game_Interpreter::CommandManiacSave, 3>(com);
+			return CmdDecode<&Game_Interpreter::CommandManiacSave, 3>();
 		case Cmd::Maniac_EndLoadProcess:
-			return CmdSetup<&Game_Interpreter::CommandManiacEndLoadProcess, 0>(com);
+			return CmdDecode<&Game_Interpreter::CommandManiacEndLoadProcess, 0>();
 		case Cmd::Maniac_GetMousePosition:
-			return CmdSetup<&Game_Interpreter::CommandManiacGetMousePosition, 2>(com);
+			return CmdDecode<&Game_Interpreter::CommandManiacGetMousePosition, 2>();
 		case Cmd::Maniac_SetMousePosition:
-			return CmdSetup<&Game_Interpreter::CommandManiacSetMousePosition, 3>(com);
+			return CmdDecode<&Game_Interpreter::CommandManiacSetMousePosition, 3>();
 		case Cmd::Maniac_ShowStringPicture:
-			return CmdSetup<&Game_Interpreter::CommandManiacShowStringPicture, 23>(com);
+			return CmdDecode<&Game_Interpreter::CommandManiacShowStringPicture, 23>();
 		case Cmd::Maniac_GetPictureInfo:
-			return CmdSetup<&Game_Interpreter::CommandManiacGetPictureInfo, 8>(com);
+			return CmdDecode<&Game_Interpreter::CommandManiacGetPictureInfo, 8>();
 		case Cmd::Maniac_ControlVarArray:
-			return CmdSetup<&Game_Interpreter::CommandManiacControlVarArray, 5>(com);
+			return CmdDecode<&Game_Interpreter::CommandManiacControlVarArray, 5>();
 		case Cmd::Maniac_KeyInputProcEx:
-			return CmdSetup<&Game_Interpreter::CommandManiacKeyInputProcEx, 4>(com);
+			return CmdDecode<&Game_Interpreter::CommandManiacKeyInputProcEx, 4>();
 		case Cmd::Maniac_RewriteMap:
-			return CmdSetup<&Game_Interpreter::CommandManiacRewriteMap, 9>(com);
+			return CmdDecode<&Game_Interpreter::CommandManiacRewriteMap, 9>();
 		case Cmd::Maniac_ControlGlobalSave:
-			return CmdSetup<&Game_Interpreter::CommandManiacControlGlobalSave, 6>(com);
+			return CmdDecode<&Game_Interpreter::CommandManiacControlGlobalSave, 6>();
 		case Cmd::Maniac_ChangePictureId:
-			return CmdSetup<&Game_Interpreter::CommandManiacChangePictureId, 6>(com);
+			return CmdDecode<&Game_Interpreter::CommandManiacChangePictureId, 6>();
 		case Cmd::Maniac_SetGameOption:
-			return CmdSetup<&Game_Interpreter::CommandManiacSetGameOption, 4>(com);
+			return CmdDecode<&Game_Interpreter::CommandManiacSetGameOption, 4>();
 		case Cmd::Maniac_ControlStrings:
-			return CmdSetup<&Game_Interpreter::CommandManiacControlStrings, 8>(com);
+			return CmdDecode<&Game_Interpreter::CommandManiacControlStrings, 8>();
 		case Cmd::Maniac_CallCommand:
-			return CommandManiacCallCommand(com);
+			return CmdDecode<&Game_Interpreter::CommandManiacCallCommand, 0>();
 		case Cmd::Maniac_ControlBattle:
-			return CommandManiacControlBattle(com);
+			return CmdDecode<&Game_Interpreter::CommandManiacControlBattle, 0>();
 		case Cmd::Maniac_ControlAtbGauge:
-			return CommandManiacControlAtbGauge(com);
+			return CmdDecode<&Game_Interpreter::CommandManiacControlAtbGauge, 0>();
 		case Cmd::Maniac_ChangeBattleCommandEx:
-			return CommandManiacChangeBattleCommandEx(com);
+			return CmdDecode<&Game_Interpreter::CommandManiacChangeBattleCommandEx, 0>();
 		case Cmd::Maniac_GetBattleInfo:
-			return CommandManiacGetBattleInfo(com);
+			return CmdDecode<&Game_Interpreter::CommandManiacGetBattleInfo, 0>();
 		case 2050:
-			return CommandPrint(com);
+			return CmdDecode<&Game_Interpreter::CommandPrint, 0>();
 		case 2055:
-			return CommandGetStringFromDB(com);
+			return CmdDecode<&Game_Interpreter::CommandGetStringFromDB, 0>();
 		case 2056:
-			return CommandCanUseItem(com);
+			return CmdDecode<&Game_Interpreter::CommandCanUseItem, 0>();
 		case 2057:
-			return CommandUseItem(com);
+			return CmdDecode<&Game_Interpreter::CommandUseItem, 0>();
 		default:
-			return true;
+			return {};
+	}
+}
+
+Game_Interpreter::CommandHandler Game_Interpreter::DecodeControlVariablesSpecialized(lcf::rpg::EventCommand const& com) {
+	// Single target with a constant or variable operand and an operation
+	// supported by all engines
+	if (com.parameters.size() < 7 || com.parameters[0] != eTargetEval_Single) {
+		return nullptr;
+	}
+	const int operation = com.parameters[3];
+	const int operand = com.parameters[4];
+	if (operation < 0 || operation > 5 || operand < 0 || operand > 1) {
+		return nullptr;
+	}
+
+	return DispatchCode<2>(operand, [operation](auto operand_c) {
+		using Operand = decltype(operand_c);
+		return DispatchCode<6>(operation, [](auto operation_c) -> CommandHandler {
+			using Operation = decltype(operation_c);
+			return &CmdCall<&Game_Interpreter::CommandControlVariablesSingle<Operand::value, Operation::value>>;
+		});
+	});
+}
+
+Game_Interpreter::CommandHandler Game_Interpreter::DecodeConditionalBranchSpecialized(lcf::rpg::EventCommand const& com) {
+	// Variable compared with a constant or a variable
+	if (com.parameters.size() < 6 || com.parameters[0] != 1) {
+		return nullptr;
 	}
+	const int mode = com.parameters[2];
+	const int op = com.parameters[4];
+	if (mode < 0 || mode > 1 || op < 0 || op > 5) {
+		return nullptr;
+	}
+
+	return DispatchCode<2>(mode, [op](auto mode_c) {
+		using Mode = decltype(mode_c);
+		return DispatchCode<6>(op, [](auto op_c) -> CommandHandler {
+			using Op = decltype(op_c);
+			return &CmdCall<&Game_Interpreter::CommandConditionalBranchVariable<Mode::value, Op::value>>;
+		});
+	});
+}
+
+Game_Interpreter::CommandHandler Game_Interpreter::DecodeEndLoopSpecialized(lcf::rpg::EventCommand const& com) {
+	// Maniac Patch While (4) and Do While (5) loops evaluate their condition
+	// on every iteration
+	if (com.parameters.size() < 5 || (com.parameters[0] != 4 && com.parameters[0] != 5)) {
+		return nullptr;
+	}
+	const int mode_l = com.parameters[1] & 15;
+	const int mode_r = (com.parameters[1] >> 4) & 15;
+	const int op = com.parameters[1] >> 8;
+	if (mode_l > 1 || mode_r > 1 || op < 0 || op > 5) {
+		return nullptr;
+	}
+
+	return DispatchCode<2>(mode_l, [mode_r, op](auto mode_l_c) {
+		using ModeL = decltype(mode_l_c);
+		return DispatchCode<2>(mode_r, [op](auto mode_r_c) {
+			using ModeR = decltype(mode_r_c);
+			return DispatchCode<6>(op, [](auto op_c) -> CommandHandler {
+				using Op = decltype(op_c);
+				return &CmdCall<&Game_Interpreter::CommandEndLoopWhile<ModeL::value, ModeR::value, Op::value>>;
+			});
+		});
+	});
 }
 
 bool Game_Interpreter::OnFinishStackFrame() {
@@ -840,6 +1036,7 @@ bool Game_Interpreter::OnFinishStackFrame() {
 	} else {
 		// If a called frame, or base frame of foreground interpreter, pop the stack.
 		_state.stack.pop_back();
+		_frame_commands.pop_back();
 	}
 
 	return !is_base_frame;
@@ -847,7 +1044,7 @@ bool Game_Interpreter::OnFinishStackFrame() {
 
 std::vector<std::string> Game_Interpreter::GetChoices(int max_num_choices) {
 	const auto& frame = GetFrame();
-	const auto& list = frame.commands;
+	const auto& list = GetFrameCommands();
 	auto& index = frame.current_command;
 
 	// Let's find the choices
@@ -884,7 +1081,7 @@ bool Game_Interpreter::CommandOptionGeneric(lcf::rpg::EventCommand const& com, i
 
 bool Game_Interpreter::CommandShowMessage(lcf::rpg::EventCommand const& com) { // code 10110
 	auto& frame = GetFrame();
-	const auto& list = frame.commands;
+	const auto& list = GetFrameCommands();
 	auto& index = frame.current_command;
 
 	if (!Game_Message::CanShowMessage(main_flag)) {
@@ -1471,6 +1668,30 @@ bool Game_Interpreter::CommandControlVariables(lcf::rpg::EventCommand const& com
 	return true;
 }
 
+template<int operand, int operation>
+bool Game_Interpreter::CommandControlVariablesSingle(lcf::rpg::EventCommand const& com) {
+	const int value = OperandValue<operand>(com.parameters[5]);
+	const int var_id = com.parameters[1];
+
+	if constexpr (operation == 0) {
+		Main_Data::game_variables->Set(var_id, value);
+	} else if constexpr (operation == 1) {
+		Main_Data::game_variables->Add(var_id, value);
+	} else if constexpr (operation == 2) {
+		Main_Data::game_variables->Sub(var_id, value);
+	} else if constexpr (operation == 3) {
+		Main_Data::game_variables->Mult(var_id, value);
+	} else if constexpr (operation == 4) {
+		Main_Data::game_variables->Div(var_id, value);
+	} else {
+		static_assert(operation == 5, "Unsupported operation");
+		Main_Data::game_variables->Mod(var_id, value);
+	}
+	Game_Map::SetNeedRefreshForVarChange(var_id);
+
+	return true;
+}
+
 int Game_Interpreter::OperateValue(int operation, int operand_type, int operand) {
 	int value = ValueOrVariable(operand_type, operand);
 
@@ -2034,7 +2255,7 @@ bool Game_Interpreter::CommandComment(const lcf::rpg::EventCommand &com) {
 		}
 
 		auto& frame = GetFrame();
-		const auto& list = frame.commands;
+		const auto& list = GetFrameCommands();
 		auto& index = frame.current_command;
 
 		std::string command = ToString(com.string);
@@ -2060,7 +2281,7 @@ bool Game_Interpreter::CommandComment(const lcf::rpg::EventCommand &com) {
 			return true;
 		}
 
-		return Main_Data::game_destiny->Main(GetFrame());
+		return Main_Data::game_destiny->Main(GetFrame(), GetFrameCommands());
 	}
 
 	return true;
@@ -2068,7 +2289,7 @@ bool Game_Interpreter::CommandComment(const lcf::rpg::EventCommand &com) {
 
 void Game_Interpreter::EndEventProcessing() {
 	auto& frame = GetFrame();
-	const auto& list = frame.commands;
+	const auto& list = GetFrameCommands();
 	auto& index = frame.current_command;
 
 	index = static_cast<int>(list.size());
@@ -3474,12 +3695,10 @@ bool Game_Interpreter::CommandConditionalBranch(lcf::rpg::EventCommand const& co
 
 		if (com.parameters[2] == 0) {
 			// Having
-			result = Main_Data::game_party->GetItemCount(item_id)
-				+ Main_Data::game_party->GetEquippedItemCount(item_id) > 0;
+			result = Main_Data::game_party->GetItemTotalCount(item_id) > 0;
 		} else {
 			// Not having
-			result = Main_Data::game_party->GetItemCount(item_id)
-				+ Main_Data::game_party->GetEquippedItemCount(item_id) == 0;
+			result = Main_Data::game_party->GetItemTotalCount(item_id) == 0;
 		}
 		break;
 	}
@@ -3663,9 +3882,8 @@ bool Game_Interpreter::CommandConditionalBranch(lcf::rpg::EventCommand const& co
 			int op = com.parameters[4] & 3;
 			int ignoreCase = com.parameters[4] >> 8 & 1;
 
-			std::string str_param = ToString(com.string);
-			StringView str_l = Main_Data::game_strings->GetWithMode(str_param, modes[0]+1, com.parameters[2], *Main_Data::game_variables);
-			StringView str_r = Main_Data::game_strings->GetWithMode(str_param, modes[1], com.parameters[3], *Main_Data::game_variables);
+			StringView str_l = Main_Data::game_strings->GetWithMode(com.string, modes[0]+1, com.parameters[2], *Main_Data::game_variables);
+			StringView str_r = Main_Data::game_strings->GetWithMode(com.string, modes[1], com.parameters[3], *Main_Data::game_variables);
 			result = ManiacPatch::CheckString(str_l, str_r, op, ignoreCase);
 		}
 		break;
@@ -3677,6 +3895,17 @@ bool Game_Interpreter::CommandConditionalBranch(lcf::rpg::EventCommand const& co
 		Output::Warning("ConditionalBranch: Branch {} unsupported", com.parameters[0]);
 	}
 
+	return ApplyConditionalBranchResult(com, result);
+}
+
+template<int mode, int op>
+bool Game_Interpreter::CommandConditionalBranchVariable(lcf::rpg::EventCommand const& com) {
+	const int value1 = Main_Data::game_variables->Get(com.parameters[1]);
+	const int value2 = OperandValue<mode>(com.parameters[3]);
+	return ApplyConditionalBranchResult(com, CheckOperator<op>(value1, value2));
+}
+
+bool Game_Interpreter::ApplyConditionalBranchResult(lcf::rpg::EventCommand const& com, bool result) {
 	int sub_idx = subcommand_sentinel;
 	if (!result) {
 		sub_idx = eOptionBranchElse;
@@ -3698,7 +3927,7 @@ bool Game_Interpreter::CommandEndBranch(lcf::rpg::EventCommand const& /* com */)
 
 bool Game_Interpreter::CommandJumpToLabel(lcf::rpg::EventCommand const& com) { // code 12120
 	auto& frame = GetFrame();
-	const auto& list = frame.commands;
+	const auto& list = GetFrameCommands();
 	auto& index = frame.current_command;
 
 	int label_id = com.parameters[0];
@@ -3779,7 +4008,7 @@ bool Game_Interpreter::CommandLoop(lcf::rpg::EventCommand const& com) { // code
 
 bool Game_Interpreter::CommandBreakLoop(lcf::rpg::EventCommand const& /* com */) { // code 12220
 	auto& frame = GetFrame();
-	const auto& list = frame.commands;
+	const auto& list = GetFrameCommands();
 	auto& index = frame.current_command;
 
 	// BreakLoop will jump to the end of the event if there is no loop.
@@ -3806,11 +4035,8 @@ bool Game_Interpreter::CommandBreakLoop(lcf::rpg::EventCommand const& /* com */)
 
 bool Game_Interpreter::CommandEndLoop(lcf::rpg::EventCommand const& com) { // code 22210
 	auto& frame = GetFrame();
-	const auto& list = frame.commands;
 	auto& index = frame.current_command;
 
-	int indent = com.indent;
-
 	if (Player::IsPatchManiac() && com.parameters.size() >= 5 && com.parameters[0] != 0) {
 		int type = com.parameters[0];
 		int offset = com.indent * 2;
@@ -3862,7 +4088,49 @@ bool Game_Interpreter::CommandEndLoop(lcf::rpg::EventCommand const& com) { // co
 		}
 	}
 
-	// Restart the loop
+	return RestartLoop(com);
+}
+
+template<int mode_l, int mode_r, int op>
+bool Game_Interpreter::CommandEndLoopWhile(lcf::rpg::EventCommand const& com) {
+	if (!Player::IsPatchManiac()) {
+		return CommandEndLoop(com);
+	}
+
+	auto& frame = GetFrame();
+	const int offset = com.indent * 2;
+
+	if (static_cast<int>(frame.maniac_loop_info.size()) < (offset + 1) * 2) {
+		frame.maniac_loop_info.resize((offset + 1) * 2);
+		frame.maniac_loop_info_size = frame.maniac_loop_info.size() / 2;
+	}
+
+	const int32_t cur_loop_val = ++frame.maniac_loop_info[offset];
+
+	if (!CheckOperator<op>(OperandValue<mode_l>(com.parameters[2]), OperandValue<mode_r>(com.parameters[3]))) {
+		// End loop
+		frame.maniac_loop_info.resize(offset);
+		frame.maniac_loop_info_size = offset / 2;
+		++frame.current_command;
+		return true;
+	}
+
+	const int loop_count_var = com.parameters[4];
+	if (loop_count_var > 0) {
+		Main_Data::game_variables->Set(loop_count_var, cur_loop_val);
+		Game_Map::SetNeedRefreshForVarChange(loop_count_var);
+	}
+
+	return RestartLoop(com);
+}
+
+bool Game_Interpreter::RestartLoop(lcf::rpg::EventCommand const& com) {
+	auto& frame = GetFrame();
+	const auto& list = GetFrameCommands();
+	auto& index = frame.current_command;
+
+	int indent = com.indent;
+
 	for (int idx = index; idx >= 0; idx--) {
 		if (list[idx].indent > indent)
 			continue;
@@ -3875,7 +4143,7 @@ bool Game_Interpreter::CommandEndLoop(lcf::rpg::EventCommand const& com) { // co
 	}
 
 	// Jump past the Cmd::Loop to the first command.
-	if (index < (int)frame.commands.size()) {
+	if (index < (int)list.size()) {
 		++index;
 	}
 
@@ -3972,7 +4240,7 @@ bool Game_Interpreter::CommandCallEvent(lcf::rpg::EventCommand const& com) { //
 		return true;
 	}
 
-	Push(page->event_commands, event->GetId(), false, page->ID);
+	Push(event->GetCommandList(page), event->GetId(), false, page->ID);
 
 	return true;
 }
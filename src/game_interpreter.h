@@ -19,13 +19,17 @@
 #define EP_GAME_INTERPRETER_H
 
 #include <cstdint>
+#include <deque>
 #include <map>
+#include <memory>
 #include <string>
+#include <typeinfo>
 #include <vector>
 #include "async_handler.h"
 #include "game_character.h"
 #include "game_actor.h"
 #include "game_interpreter_shared.h"
+#include "interpreter_profiler.h"
 #include <lcf/dbarray.h>
 #include <lcf/rpg/fwd.h>
 #include <lcf/rpg/eventcommand.h>
@@ -46,6 +50,49 @@ class Game_Interpreter : public Game_BaseInterpreterContext
 public:
 	using Cmd = lcf::rpg::EventCommand::Code;
 
+	/** Handler of an event command */
+	using CommandHandler = bool (*)(Game_Interpreter& interpreter, lcf::rpg::EventCommand const& com);
+
+	/** Result of DecodeCommand */
+	struct CommandEntry {
+		/** nullptr for commands without an effect */
+		CommandHandler handler = nullptr;
+		/** Amount of parameters the handler accesses unconditionally */
+		size_t min_size = 0;
+	};
+
+	/** Event command resolved to its handler, the parameters are validated */
+	struct DecodedCommand {
+		CommandHandler handler = nullptr;
+		/** Command of the list or a copy padded to the required parameter count */
+		const lcf::rpg::EventCommand* com = nullptr;
+	};
+
+	/** All commands of a list decoded by one interpreter type */
+	struct DecodedList {
+		const std::type_info* type = nullptr;
+		std::vector<DecodedCommand> commands;
+		/** Copies of malformed commands with missing parameters */
+		std::deque<lcf::rpg::EventCommand> padded;
+	};
+
+	/**
+	 * Immutable event command list shared between all frames executing it.
+	 * Owned by the event or common event, frames only hold a reference.
+	 * Each interpreter type decodes the list once, on first use.
+	 */
+	struct SharedCommands {
+		explicit SharedCommands(std::vector<lcf::rpg::EventCommand> commands, InterpreterProfiler::Source source = {})
+			: commands(std::move(commands)), source(source) {}
+
+		std::vector<lcf::rpg::EventCommand> commands;
+		/** Origin of the list, used by the profiler */
+		InterpreterProfiler::Source source;
+		mutable std::vector<std::unique_ptr<const DecodedList>> decoded;
+	};
+
+	using CommandList = std::shared_ptr<const SharedCommands>;
+
 	static Game_Interpreter& GetForegroundInterpreter();
 
 	Game_Interpreter(bool _main_flag = false);
@@ -64,6 +111,13 @@ public:
 
 	void Update(bool reset_loop_count=true);
 
+	void Push(
+			CommandList _list,
+			int _event_id,
+			bool started_by_decision_key = false,
+			int event_page_id = 0
+	);
+	/** Pushes a list that is not owned by an event, e.g. a troop page. The list is copied once. */
 	void Push(
 			std::vector<lcf::rpg::EventCommand> _list,
 			int _event_id,
@@ -78,11 +132,21 @@ public:
 	void SetupChoices(const std::vector<std::string>& choices, int indent, PendingMessage& pm);
 
 	bool ExecuteCommand();
-	virtual bool ExecuteCommand(lcf::rpg::EventCommand const& com);
+
+	/**
+	 * Resolves the handler of a command. Only called once per command list,
+	 * the interpreter dispatches to the decoded handlers afterwards.
+	 *
+	 * @param com command to decode
+	 * @return handler and required parameter count
+	 */
+	virtual CommandEntry DecodeCommand(lcf::rpg::EventCommand const& com) const;
 
 
 	/**
 	 * Returns the interpreters current state information.
+	 * The command lists of the frames are not filled in, they are
+	 * shared and only copied by GetSaveState.
 	 * For saving state into a save file, use GetSaveState instead.
 	 */
 	const lcf::rpg::SaveEventExecState& GetState() const;
@@ -131,6 +195,43 @@ protected:
 	const lcf::rpg::SaveEventExecFrame* GetFramePtr() const;
 	lcf::rpg::SaveEventExecFrame* GetFramePtr();
 
+	/** @return command list executed by the current frame */
+	const std::vector<lcf::rpg::EventCommand>& GetFrameCommands() const;
+
+	/**
+	 * Moves the command lists of the frames in _state into shared lists.
+	 * Must be called after _state was assigned from a save file.
+	 */
+	void ShareStateCommands();
+
+	/** @return decoded form of the list for this interpreter type, decoded on first use */
+	const DecodedList& GetDecodedList(const SharedCommands& list) const;
+
+	template<auto CMDFN>
+	static bool CmdCall(Game_Interpreter& interpreter, lcf::rpg::EventCommand const& com);
+
+	/**
+	 * Decode result for a command handler.
+	 *
+	 * @tparam CMDFN member function handling the command
+	 * @tparam MIN_SIZE minimum amount of parameters, shorter commands are padded with 0
+	 */
+	template<auto CMDFN, size_t MIN_SIZE>
+	static constexpr CommandEntry CmdDecode() {
+		return { &CmdCall<CMDFN>, MIN_SIZE };
+	}
+
+	/**
+	 * Handlers specialized on the operand modes and operators of a command.
+	 * The runtime switches over these codes are done once when decoding.
+	 *
+	 * @param com command to decode
+	 * @return specialized handler or nullptr when the generic handler must be used
+	 */
+	static CommandHandler DecodeControlVariablesSpecialized(lcf::rpg::EventCommand const& com);
+	static CommandHandler DecodeConditionalBranchSpecialized(lcf::rpg::EventCommand const& com);
+	static CommandHandler DecodeEndLoopSpecialized(lcf::rpg::EventCommand const& com);
+
 	bool main_flag;
 
 	int loop_count = 0;
@@ -206,6 +307,9 @@ protected:
 	bool CommandInputNumber(lcf::rpg::EventCommand const& com);
 	bool CommandControlSwitches(lcf::rpg::EventCommand const& com);
 	bool CommandControlVariables(lcf::rpg::EventCommand const& com);
+	/** ControlVariables with a single target, @see DecodeControlVariablesSpecialized */
+	template<int operand, int operation>
+	bool CommandControlVariablesSingle(lcf::rpg::EventCommand const& com);
 	bool CommandTimerOperation(lcf::rpg::EventCommand const& com);
 	bool CommandChangeGold(lcf::rpg::EventCommand const& com);
 	bool CommandChangeItems(lcf::rpg::EventCommand const& com);
@@ -267,12 +371,22 @@ protected:
 	bool CommandChangeSaveAccess(lcf::rpg::EventCommand const& com);
 	bool CommandChangeMainMenuAccess(lcf::rpg::EventCommand const& com);
 	bool CommandConditionalBranch(lcf::rpg::EventCommand const& com);
+	/** ConditionalBranch comparing a variable, @see DecodeConditionalBranchSpecialized */
+	template<int mode, int op>
+	bool CommandConditionalBranchVariable(lcf::rpg::EventCommand const& com);
+	/** Skips to the else branch when result is false */
+	bool ApplyConditionalBranchResult(lcf::rpg::EventCommand const& com, bool result);
 	bool CommandElseBranch(lcf::rpg::EventCommand const& com);
 	bool CommandEndBranch(lcf::rpg::EventCommand const& com);
 	bool CommandJumpToLabel(lcf::rpg::EventCommand const& com);
 	bool CommandLoop(lcf::rpg::EventCommand const& com);
 	bool CommandBreakLoop(lcf::rpg::EventCommand const& com);
 	bool CommandEndLoop(lcf::rpg::EventCommand const& com);
+	/** EndLoop of a Maniac Patch While and Do While loop, @see DecodeEndLoopSpecialized */
+	template<int mode_l, int mode_r, int op>
+	bool CommandEndLoopWhile(lcf::rpg::EventCommand const& com);
+	/** Jumps back to the first command of the loop ending with com */
+	bool RestartLoop(lcf::rpg::EventCommand const& com);
 	bool CommandEraseEvent(lcf::rpg::EventCommand const& com);
 	bool CommandCallEvent(lcf::rpg::EventCommand const& com);
 	bool CommandReturnToTitleScreen(lcf::rpg::EventCommand const& com);
@@ -362,6 +476,13 @@ protected:
 	int ManiacBitmask(int value, int mask) const;
 
 	lcf::rpg::SaveEventExecState _state;
+	struct FrameCommands {
+		CommandList list;
+		const DecodedList* decoded = nullptr;
+	};
+
+	/** Command lists of the frames in _state.stack, same order */
+	std::vector<FrameCommands> _frame_commands;
 	KeyInputState _keyinput;
 	AsyncOp _async_op = {};
 
@@ -376,6 +497,20 @@ inline lcf::rpg::SaveEventExecFrame* Game_Interpreter::GetFramePtr() {
 	return !_state.stack.empty() ? &_state.stack.back() : nullptr;
 }
 
+inline const std::vector<lcf::rpg::EventCommand>& Game_Interpreter::GetFrameCommands() const {
+	assert(!_frame_commands.empty());
+	return _frame_commands.back().list->commands;
+}
+
+template<auto CMDFN>
+inline bool Game_Interpreter::CmdCall(Game_Interpreter& interpreter, lcf::rpg::EventCommand const& com) {
+	using ClassType = typename Game_Interpreter_Shared::MemFnTraits<decltype(CMDFN)>::ClassType;
+
+	static_assert(std::is_base_of<Game_Interpreter, ClassType>::value, "ClassType must inherit from Game_Interpreter");
+
+	return (static_cast<ClassType&>(interpreter).*CMDFN)(com);
+}
+
 inline const lcf::rpg::SaveEventExecFrame& Game_Interpreter::GetFrame() const {
 	auto* frame = GetFramePtr();
 	assert(frame);
@@ -225,36 +225,36 @@ int Game_Interpreter_Battle::ScheduleNextPage(lcf::rpg::TroopPageCondition::Flag
 }
 
 // Execute Command.
-bool Game_Interpreter_Battle::ExecuteCommand(lcf::rpg::EventCommand const& com) {
+Game_Interpreter::CommandEntry Game_Interpreter_Battle::DecodeCommand(lcf::rpg::EventCommand const& com) const {
 	switch (static_cast<Cmd>(com.code)) {
 		case Cmd::CallCommonEvent:
-			return CmdSetup<&Game_Interpreter_Battle::CommandCallCommonEvent, 1>(com);
+			return CmdDecode<&Game_Interpreter_Battle::CommandCallCommonEvent, 1>();
 		case Cmd::ForceFlee:
-			return CmdSetup<&Game_Interpreter_Battle::CommandForceFlee, 3>(com);
+			return CmdDecode<&Game_Interpreter_Battle::CommandForceFlee, 3>();
 		case Cmd::EnableCombo:
-			return CmdSetup<&Game_Interpreter_Battle::CommandEnableCombo, 3>(com);
+			return CmdDecode<&Game_Interpreter_Battle::CommandEnableCombo, 3>();
 		case Cmd::ChangeMonsterHP:
-			return CmdSetup<&Game_Interpreter_Battle::CommandChangeMonsterHP, 5>(com);
+			return CmdDecode<&Game_Interpreter_Battle::CommandChangeMonsterHP, 5>();
 		case Cmd::ChangeMonsterMP:
-			return CmdSetup<&Game_Interpreter_Battle::CommandChangeMonsterMP, 4>(com);
+			return CmdDecode<&Game_Interpreter_Battle::CommandChangeMonsterMP, 4>();
 		case Cmd::ChangeMonsterCondition:
-			return CmdSetup<&Game_Interpreter_Battle::CommandChangeMonsterCondition, 3>(com);
+			return CmdDecode<&Game_Interpreter_Battle::CommandChangeMonsterCondition, 3>();
 		case Cmd::ShowHiddenMonster:
-			return CmdSetup<&Game_Interpreter_Battle::CommandShowHiddenMonster, 1>(com);
+			return CmdDecode<&Game_Interpreter_Battle::CommandShowHiddenMonster, 1>();
 		case Cmd::ChangeBattleBG:
-			return CmdSetup<&Game_Interpreter_Battle::CommandChangeBattleBG, 0>(com);
+			return CmdDecode<&Game_Interpreter_Battle::CommandChangeBattleBG, 0>();
 		case Cmd::ShowBattleAnimation_B:
-			return CmdSetup<&Game_Interpreter_Battle::CommandShowBattleAnimation, 3>(com);
+			return CmdDecode<&Game_Interpreter_Battle::CommandShowBattleAnimation, 3>();
 		case Cmd::TerminateBattle:
-			return CmdSetup<&Game_Interpreter_Battle::CommandTerminateBattle, 0>(com);
+			return CmdDecode<&Game_Interpreter_Battle::CommandTerminateBattle, 0>();
 		case Cmd::ConditionalBranch_B:
-			return CmdSetup<&Game_Interpreter_Battle::CommandConditionalBranchBattle, 5>(com);
+			return CmdDecode<&Game_Interpreter_Battle::CommandConditionalBranchBattle, 5>();
 		case Cmd::ElseBranch_B:
-			return CmdSetup<&Game_Interpreter_Battle::CommandElseBranchBattle, 0>(com);
+			return CmdDecode<&Game_Interpreter_Battle::CommandElseBranchBattle, 0>();
 		case Cmd::EndBranch_B:
-			return CmdSetup<&Game_Interpreter_Battle::CommandEndBranchBattle, 0>(com);
+			return CmdDecode<&Game_Interpreter_Battle::CommandEndBranchBattle, 0>();
 		default:
-			return Game_Interpreter::ExecuteCommand(com);
+			return Game_Interpreter::DecodeCommand(com);
 	}
 }
 
@@ -649,7 +649,8 @@ void Game_Interpreter_Battle::RemoveCommonEventID(int eventID) {
 
 		//Output::Debug("S {} C {}", _state.stack[j].event_id, eventID);
 		if (_state.stack[j].event_id == -eventID) {
-			_state.stack.erase(std::remove(_state.stack.begin(), _state.stack.end(), _state.stack[j]), _state.stack.end());
+			_state.stack.erase(_state.stack.begin() + j);
+			_frame_commands.erase(_frame_commands.begin() + j);
 		}
 	}
 }
@@ -756,7 +757,7 @@ bool Game_Interpreter_Battle::ManiacBattleHook(ManiacBattleHookType hook_type, i
 	}
 
 	// Push is actually "push_back", so this gets added before other events.
-	maniac_interpreter->Push(pre_commands, 0);
+	maniac_interpreter->Push(std::move(pre_commands), 0);
 
 	// Necessary to start the sub-event.
 	maniac_interpreter->Update();
@@ -776,6 +777,6 @@ bool Game_Interpreter_Battle::ProcessManiacSubEvents() {
 
 
 void Game_Interpreter_Battle::PushCommonEvent(Game_CommonEvent* ev) {
-	Push(ev->GetList(), -ev->GetIndex(), false);
+	Push(ev->GetCommandList(), -ev->GetIndex(), false);
 	//Push(ev->GetList(), 0, false);
 }
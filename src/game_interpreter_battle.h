@@ -67,7 +67,7 @@ public:
 	void PushCommonEvent(Game_CommonEvent* ev);
 	void RemoveCommonEventID(int eventID);
 
-	bool ExecuteCommand(lcf::rpg::EventCommand const& com) override;
+	CommandEntry DecodeCommand(lcf::rpg::EventCommand const& com) const override;
 
 	static void InitBattle();
 
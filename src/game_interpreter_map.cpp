@@ -84,6 +84,7 @@ using namespace Game_Interpreter_Shared;
 void Game_Interpreter_Map::SetState(const lcf::rpg::SaveEventExecState& save) {
 	Clear();
 	_state = save;
+	ShareStateCommands();
 	_keyinput.fromSave(save);
 }
 
@@ -180,72 +181,72 @@ bool Game_Interpreter_Map::RequestMainMenuScene(int subscreen_id, int actor_inde
 /**
  * Execute Command.
  */
-bool Game_Interpreter_Map::ExecuteCommand(lcf::rpg::EventCommand const& com) {
+Game_Interpreter::CommandEntry Game_Interpreter_Map::DecodeCommand(lcf::rpg::EventCommand const& com) const {
 	switch (static_cast<Cmd>(com.code)) {
 		case Cmd::RecallToLocation:
-			return CmdSetup<&Game_Interpreter_Map::CommandRecallToLocation, 3>(com);
+			return CmdDecode<&Game_Interpreter_Map::CommandRecallToLocation, 3>();
 		case Cmd::EnemyEncounter:
 			if (Player::IsRPG2k()) {
-				return CmdSetup<&Game_Interpreter_Map::CommandEnemyEncounter, 6>(com);
+				return CmdDecode<&Game_Interpreter_Map::CommandEnemyEncounter, 6>();
 			} else {
-				return CmdSetup<&Game_Interpreter_Map::CommandEnemyEncounter, 10>(com);
+				return CmdDecode<&Game_Interpreter_Map::CommandEnemyEncounter, 10>();
 			}
 		case Cmd::VictoryHandler:
-			return CmdSetup<&Game_Interpreter_Map::CommandVictoryHandler, 0>(com);
+			return CmdDecode<&Game_Interpreter_Map::CommandVictoryHandler, 0>();
 		case Cmd::EscapeHandler:
-			return CmdSetup<&Game_Interpreter_Map::CommandEscapeHandler, 0>(com);
+			return CmdDecode<&Game_Interpreter_Map::CommandEscapeHandler, 0>();
 		case Cmd::DefeatHandler:
-			return CmdSetup<&Game_Interpreter_Map::CommandDefeatHandler, 0>(com);
+			return CmdDecode<&Game_Interpreter_Map::CommandDefeatHandler, 0>();
 		case Cmd::EndBattle:
-			return CmdSetup<&Game_Interpreter_Map::CommandEndBattle, 0>(com);
+			return CmdDecode<&Game_Interpreter_Map::CommandEndBattle, 0>();
 		case Cmd::OpenShop:
-			return CmdSetup<&Game_Interpreter_Map::CommandOpenShop, 4>(com);
+			return CmdDecode<&Game_Interpreter_Map::CommandOpenShop, 4>();
 		case Cmd::Transaction:
-			return CmdSetup<&Game_Interpreter_Map::CommandTransaction, 0>(com);
+			return CmdDecode<&Game_Interpreter_Map::CommandTransaction, 0>();
 		case Cmd::NoTransaction:
-			return CmdSetup<&Game_Interpreter_Map::CommandNoTransaction, 0>(com);
+			return CmdDecode<&Game_Interpreter_Map::CommandNoTransaction, 0>();
 		case Cmd::EndShop:
-			return CmdSetup<&Game_Interpreter_Map::CommandEndShop, 0>(com);
+			return CmdDecode<&Game_Interpreter_Map::CommandEndShop, 0>();
 		case Cmd::ShowInn:
-			return CmdSetup<&Game_Interpreter_Map::CommandShowInn, 3>(com);
+			return CmdDecode<&Game_Interpreter_Map::CommandShowInn, 3>();
 		case Cmd::Stay:
-			return CmdSetup<&Game_Interpreter_Map::CommandStay, 0>(com);
+			return CmdDecode<&Game_Interpreter_Map::CommandStay, 0>();
 		case Cmd::NoStay:
-			return CmdSetup<&Game_Interpreter_Map::CommandNoStay, 0>(com);
+			return CmdDecode<&Game_Interpreter_Map::CommandNoStay, 0>();
 		case Cmd::EndInn:
-			return CmdSetup<&Game_Interpreter_Map::CommandEndInn, 0>(com);
+			return CmdDecode<&Game_Interpreter_Map::CommandEndInn, 0>();
 		case Cmd::EnterHeroName:
-			return CmdSetup<&Game_Interpreter_Map::CommandEnterHeroName, 3>(com);
+			return CmdDecode<&Game_Interpreter_Map::CommandEnterHeroName, 3>();
 		case Cmd::Teleport:
-			return CmdSetup<&Game_Interpreter_Map::CommandTeleport, 3>(com);
+			return CmdDecode<&Game_Interpreter_Map::CommandTeleport, 3>();
 		case Cmd::EnterExitVehicle:
-			return CmdSetup<&Game_Interpreter_Map::CommandEnterExitVehicle, 0>(com);
+			return CmdDecode<&Game_Interpreter_Map::CommandEnterExitVehicle, 0>();
 		case Cmd::PanScreen:
-			return CmdSetup<&Game_Interpreter_Map::CommandPanScreen, 5>(com);
+			return CmdDecode<&Game_Interpreter_Map::CommandPanScreen, 5>();
 		case Cmd::ShowBattleAnimation:
-			return CmdSetup<&Game_Interpreter_Map::CommandShowBattleAnimation, 4>(com);
+			return CmdDecode<&Game_Interpreter_Map::CommandShowBattleAnimation, 4>();
 		case Cmd::FlashSprite:
-			return CmdSetup<&Game_Interpreter_Map::CommandFlashSprite, 7>(com);
+			return CmdDecode<&Game_Interpreter_Map::CommandFlashSprite, 7>();
 		case Cmd::ProceedWithMovement:
-			return CmdSetup<&Game_Interpreter_Map::CommandProceedWithMovement, 0>(com);
+			return CmdDecode<&Game_Interpreter_Map::CommandProceedWithMovement, 0>();
 		case Cmd::HaltAllMovement:
-			return CmdSetup<&Game_Interpreter_Map::CommandHaltAllMovement, 0>(com);
+			return CmdDecode<&Game_Interpreter_Map::CommandHaltAllMovement, 0>();
 		case Cmd::PlayMovie:
-			return CmdSetup<&Game_Interpreter_Map::CommandPlayMovie, 5>(com);
+			return CmdDecode<&Game_Interpreter_Map::CommandPlayMovie, 5>();
 		case Cmd::OpenSaveMenu:
-			return CmdSetup<&Game_Interpreter_Map::CommandOpenSaveMenu, 0>(com);
+			return CmdDecode<&Game_Interpreter_Map::CommandOpenSaveMenu, 0>();
 		case Cmd::OpenMainMenu:
-			return CmdSetup<&Game_Interpreter_Map::CommandOpenMainMenu, 0>(com);
+			return CmdDecode<&Game_Interpreter_Map::CommandOpenMainMenu, 0>();
 		case Cmd::OpenLoadMenu:
-			return CmdSetup<&Game_Interpreter_Map::CommandOpenLoadMenu, 0>(com);
+			return CmdDecode<&Game_Interpreter_Map::CommandOpenLoadMenu, 0>();
 		case Cmd::ToggleAtbMode:
-			return CmdSetup<&Game_Interpreter_Map::CommandToggleAtbMode, 0>(com);
+			return CmdDecode<&Game_Interpreter_Map::CommandToggleAtbMode, 0>();
 		case Cmd::EasyRpg_TriggerEventAt:
-			return CmdSetup<&Game_Interpreter_Map::CommandEasyRpgTriggerEventAt, 4>(com);
+			return CmdDecode<&Game_Interpreter_Map::CommandEasyRpgTriggerEventAt, 4>();
 		case Cmd::EasyRpg_WaitForSingleMovement:
-			return CmdSetup<&Game_Interpreter_Map::CommandEasyRpgWaitForSingleMovement, 6>(com);
+			return CmdDecode<&Game_Interpreter_Map::CommandEasyRpgWaitForSingleMovement, 6>();
 		default:
-			return Game_Interpreter::ExecuteCommand(com);
+			return Game_Interpreter::DecodeCommand(com);
 	}
 }
 
@@ -53,7 +53,7 @@ public:
 
 	bool RequestMainMenuScene(int subscreen_id = -1, int actor_index = 0, bool is_db_actor = false);
 
-	bool ExecuteCommand(lcf::rpg::EventCommand const& com) override;
+	CommandEntry DecodeCommand(lcf::rpg::EventCommand const& com) const override;
 
 private:
 	bool CommandRecallToLocation(lcf::rpg::EventCommand const& com);
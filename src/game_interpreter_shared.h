@@ -98,27 +98,64 @@ namespace Game_Interpreter_Shared {
 
 	bool CheckOperator(int val, int val2, int op);
 
+	/**
+	 * CheckOperator with the operator known at compile time.
+	 * Used by command handlers specialized when the command is decoded.
+	 *
+	 * @tparam op comparison operator (0: ==, 1: >=, 2: <=, 3: >, 4: <, 5: !=)
+	 */
+	template<int op>
+	constexpr bool CheckOperator(int val, int val2);
+
 	int DecodeInt(lcf::DBArray<int32_t>::const_iterator& it);
 	const std::string DecodeString(lcf::DBArray<int32_t>::const_iterator& it);
 	lcf::rpg::MoveCommand DecodeMove(lcf::DBArray<int32_t>::const_iterator& it);
 
 	bool ManiacCheckContinueLoop(int val, int val2, int type, int op);
+
+	/** Extracts the class of a command handler member function */
+	template<typename T>
+	struct MemFnTraits;
+
+	template<typename RetType, typename ClsType, typename... Args>
+	struct MemFnTraits<RetType(ClsType::*)(Args...)> {
+		using ClassType = ClsType;
+	};
+}
+
+template<int op>
+constexpr bool Game_Interpreter_Shared::CheckOperator(int val, int val2) {
+	static_assert(op >= 0 && op <= 5, "Invalid operator");
+
+	if constexpr (op == 0) {
+		return val == val2;
+	} else if constexpr (op == 1) {
+		return val >= val2;
+	} else if constexpr (op == 2) {
+		return val <= val2;
+	} else if constexpr (op == 3) {
+		return val > val2;
+	} else if constexpr (op == 4) {
+		return val < val2;
+	} else {
+		return val != val2;
+	}
 }
 
 inline bool Game_Interpreter_Shared::CheckOperator(int val, int val2, int op) {
 	switch (op) {
 		case 0:
-			return val == val2;
+			return CheckOperator<0>(val, val2);
 		case 1:
-			return val >= val2;
+			return CheckOperator<1>(val, val2);
 		case 2:
-			return val <= val2;
+			return CheckOperator<2>(val, val2);
 		case 3:
-			return val > val2;
+			return CheckOperator<3>(val, val2);
 		case 4:
-			return val < val2;
+			return CheckOperator<4>(val, val2);
 		case 5:
-			return val != val2;
+			return CheckOperator<5>(val, val2);
 		default:
 			return false;
 	}
@@ -169,12 +206,13 @@ protected:
 		return Game_Interpreter_Shared::ValueOrVariableBitfield<validate_patches, support_indirect_and_switch, support_scopes, support_named>(com, mode_idx, shift, val_idx, *this);
 	}
 
-	template<typename RetType, typename ClsType, typename... Args>
-	ClsType MemFnCls(RetType(ClsType::*)(Args...));
-
+	/**
+	 * Invokes a command handler and pads the parameters when there are less than MIN_SIZE.
+	 * Used by handlers which forward to another handler depending on runtime state.
+	 */
 	template<auto CMDFN, size_t MIN_SIZE>
 	bool CmdSetup(lcf::rpg::EventCommand const& com) {
-		using ClassType = decltype(MemFnCls(CMDFN));
+		using ClassType = typename Game_Interpreter_Shared::MemFnTraits<decltype(CMDFN)>::ClassType;
 
 		static_assert(std::is_base_of<Game_BaseInterpreterContext, ClassType>::value, "ClassType must inherit from Game_BaseInterpreterContext");
 
@@ -144,14 +144,41 @@ int Game_Party::GetItemCount(int item_id) const {
 }
 
 int Game_Party::GetEquippedItemCount(int item_id) const {
-	int number = 0;
-	if (item_id >= 0) {
-		for (int i = 0; i < (int) data.party.size(); i++) {
-			Game_Actor* actor = Main_Data::game_actors->GetActor(data.party[i]);
-			number += actor->GetItemCount(item_id);
+	// quirk: 0 is "no item in slot", see Game_Actor::GetItemCount
+	if (item_id < 0) {
+		return 0;
+	}
+
+	UpdateEquippedItemCounts();
+	return item_id < static_cast<int>(equipped_counts.size()) ? equipped_counts[item_id] : 0;
+}
+
+void Game_Party::UpdateEquippedItemCounts() const {
+	const auto revision = Game_Actor::GetEquipmentRevision();
+	if (equipped_counts_valid && equipped_counts_revision == revision && equipped_counts_party == data.party) {
+		return;
+	}
+
+	std::fill(equipped_counts.begin(), equipped_counts.end(), 0);
+	for (auto actor_id: data.party) {
+		const Game_Actor* actor = Main_Data::game_actors->GetActor(actor_id);
+		if (!actor) {
+			continue;
+		}
+		for (int16_t item_id: actor->GetWholeEquipment()) {
+			if (item_id < 0) {
+				continue;
+			}
+			if (item_id >= static_cast<int>(equipped_counts.size())) {
+				equipped_counts.resize(std::max<size_t>(item_id + 1, lcf::Data::items.size() + 1), 0);
+			}
+			++equipped_counts[item_id];
 		}
 	}
-	return number;
+
+	equipped_counts_party = data.party;
+	equipped_counts_revision = revision;
+	equipped_counts_valid = true;
 }
 
 int Game_Party::GetItemTotalCount(int item_id) const {
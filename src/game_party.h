@@ -417,7 +417,17 @@ public:
 private:
 	std::pair<int,bool> GetItemIndex(int item_id) const;
 
+	/** Rebuilds equipped_counts when the party or any equipment changed */
+	void UpdateEquippedItemCounts() const;
+
 	lcf::rpg::SaveInventory data;
+
+	/** Equipped items of the party indexed by item ID, index 0 counts the empty slots */
+	mutable std::vector<int> equipped_counts;
+	/** Party members and equipment revision equipped_counts was built from */
+	mutable std::vector<int16_t> equipped_counts_party;
+	mutable uint32_t equipped_counts_revision = 0;
+	mutable bool equipped_counts_valid = false;
 };
 
 // ------ INLINES --------
@@ -204,7 +204,7 @@ void Game_Screen::InitParticles(int num_particles) {
 	// RPG_RT initializes all particles on new game / load game.
 	// We do it lazily instead. That way for games which don't use
 	// weather effects, we never consume memory for those effects.
-	auto sz = static_cast<int>(particles.size());
+	auto sz = particles.size();
 
 	if (num_particles <= sz) {
 		return;
@@ -213,47 +213,69 @@ void Game_Screen::InitParticles(int num_particles) {
 	particles.resize(num_particles);
 
 	for (int i = sz; i < num_particles; ++i) {
-		auto& p = particles[i];
 		// RPG_RT always initializes all particles to these values on startup.
 		// This can cause minor visual glitches for the first few frames the
 		// first time you start the sandstorm effect. We're bug compatible with RPG_RT.
-		p.t = Rand::GetRandomNumber(0, 39);
-		p.x = Rand::GetRandomNumber(0, GetPanLimitX() / 16 - 1);
-		p.y = Rand::GetRandomNumber(0, GetPanLimitY() / 16 - 1);
+		particles.t[i] = Rand::GetRandomNumber(0, 39);
+		particles.x[i] = Rand::GetRandomNumber(0, GetPanLimitX() / 16 - 1);
+		particles.y[i] = Rand::GetRandomNumber(0, GetPanLimitY() / 16 - 1);
 	}
 }
 
 void Game_Screen::UpdateRain() {
-	for (auto& p: particles) {
-		if (p.t > 0) {
-			--p.t;
-			p.y += 4;
-			p.x -= 1;
-		} else if (Rand::PercentChance(10)) {
-			p.t = 12;
-			p.x = Rand::GetRandomNumber(0, GetPanLimitX() / 16 - 1);
-			p.y = Rand::GetRandomNumber(0, GetPanLimitY() / 16 - 1);
+	const int n = particles.size();
+	auto* t = particles.t.data();
+	auto* x = particles.x.data();
+	auto* y = particles.y.data();
+
+	// Moving and respawning are separate passes so that the move loop is
+	// branchless. Random numbers are consumed in the same order as RPG_RT.
+	particle_spawns.clear();
+	for (int i = 0; i < n; ++i) {
+		if (t[i] <= 0) {
+			particle_spawns.push_back(i);
+		}
+	}
+
+	for (int i = 0; i < n; ++i) {
+		const int16_t m = t[i] > 0;
+		t[i] -= m;
+		y[i] += 4 * m;
+		x[i] -= m;
+	}
+
+	for (int i: particle_spawns) {
+		if (Rand::PercentChance(10)) {
+			t[i] = 12;
+			x[i] = Rand::GetRandomNumber(0, GetPanLimitX() / 16 - 1);
+			y[i] = Rand::GetRandomNumber(0, GetPanLimitY() / 16 - 1);
 		}
 	}
 }
 
 void Game_Screen::UpdateSnow() {
-	for (auto& p: particles) {
-		if (p.t > 0) {
-			--p.t;
-			p.x -= Rand::GetRandomNumber(0, 1);
-			p.y += Rand::GetRandomNumber(2, 3);
+	const int n = particles.size();
+	auto* t = particles.t.data();
+	auto* x = particles.x.data();
+	auto* y = particles.y.data();
+
+	// Moving consumes random numbers too, the order must match RPG_RT
+	for (int i = 0; i < n; ++i) {
+		if (t[i] > 0) {
+			--t[i];
+			x[i] -= Rand::GetRandomNumber(0, 1);
+			y[i] += Rand::GetRandomNumber(2, 3);
 		} else if (Rand::PercentChance(5)) {
-			p.t = 30;
-			p.x = Rand::GetRandomNumber(0, GetPanLimitX() / 16 - 1);
-			p.y = Rand::GetRandomNumber(0, GetPanLimitY() / 16 - 1);
+			t[i] = 30;
+			x[i] = Rand::GetRandomNumber(0, GetPanLimitX() / 16 - 1);
+			y[i] = Rand::GetRandomNumber(0, GetPanLimitY() / 16 - 1);
 		}
 	}
 }
 
 void Game_Screen::UpdateFog() {
-	++particles[0].x;
-	++particles[1].x;
+	++particles.x[0];
+	++particles.x[1];
 }
 
 void Game_Screen::UpdateSandstorm() {
@@ -267,30 +289,51 @@ void Game_Screen::UpdateSandstorm() {
 
 	UpdateFog();
 
-	for (size_t i = 2; i < particles.size(); ++i) {
-		auto& p = particles[i];
-		if (p.t > 0) {
-			--p.t;
-			p.alpha += 2;
-			p.x += static_cast<int>(p.vx);
-			p.y += static_cast<int>(p.vy);
-			p.vx += p.ax;
-			p.vy += p.ay;
-		} else if (Rand::PercentChance(10)) {
-			p.t = 80;
+	const int n = particles.size();
+	auto* t = particles.t.data();
+	auto* x = particles.x.data();
+	auto* y = particles.y.data();
+	auto* alpha = particles.alpha.data();
+	auto* vx = particles.vx.data();
+	auto* vy = particles.vy.data();
+	auto* ax = particles.ax.data();
+	auto* ay = particles.ay.data();
+
+	// See UpdateRain
+	particle_spawns.clear();
+	for (int i = 2; i < n; ++i) {
+		if (t[i] <= 0) {
+			particle_spawns.push_back(i);
+		}
+	}
+
+	for (int i = 2; i < n; ++i) {
+		if (t[i] > 0) {
+			--t[i];
+			alpha[i] += 2;
+			x[i] += static_cast<int>(vx[i]);
+			y[i] += static_cast<int>(vy[i]);
+			vx[i] += ax[i];
+			vy[i] += ay[i];
+		}
+	}
+
+	for (int i: particle_spawns) {
+		if (Rand::PercentChance(10)) {
+			t[i] = 80;
 
 			auto c = std::cos(dist(rng));
 			auto s = std::sin(dist(rng));
 			auto d = Rand::GetRandomNumber(16, 95);
 
-			p.x = static_cast<int>(d * c * 2.0f) * Player::screen_width / 320 + Player::screen_width / 2;
-			p.y = static_cast<int>(d * s) * Player::screen_height / 240;
+			x[i] = static_cast<int>(d * c * 2.0f) * Player::screen_width / 320 + Player::screen_width / 2;
+			y[i] = static_cast<int>(d * s) * Player::screen_height / 240;
 
-			p.alpha = 180;
-			p.vx = 0.0;
-			p.vy = 0.0;
-			p.ax = c * 2.0f * Player::screen_width / 320;
-			p.ay = s * 2.0f * Player::screen_height / 240;
+			alpha[i] = 180;
+			vx[i] = 0.0;
+			vy[i] = 0.0;
+			ax[i] = c * 2.0f * Player::screen_width / 320;
+			ay[i] = s * 2.0f * Player::screen_height / 240;
 		}
 	}
 }
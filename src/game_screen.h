@@ -87,20 +87,27 @@ public:
 	 */
 	int GetWeatherStrength();
 
-	struct Particle {
-		int16_t t = 0;
-		int16_t x = 0;
-		int16_t y = 0;
+	/**
+	 * Weather particles stored as one array per attribute.
+	 * The update loops then run over contiguous values and can be vectorized.
+	 */
+	struct Particles {
+		std::vector<int16_t> t;
+		std::vector<int16_t> x;
+		std::vector<int16_t> y;
 		// These are only used for sandstorm particles.
 		// RPG_RT uses double. We use float to save space.
-		int16_t alpha = 0;
-		float vx = 0.0;
-		float vy = 0.0;
-		float ax = 0.0;
-		float ay = 0.0;
+		std::vector<int16_t> alpha;
+		std::vector<float> vx;
+		std::vector<float> vy;
+		std::vector<float> ax;
+		std::vector<float> ay;
+
+		int size() const;
+		void resize(int n);
 	};
 
-	const std::vector<Particle>& GetParticles();
+	const Particles& GetParticles();
 
 	enum WeatherType {
 		Weather_None,
@@ -192,7 +199,9 @@ private:
 	int movie_res_y;
 
 protected:
-	std::vector<Particle> particles;
+	Particles particles;
+	/** Particles that were inactive at the start of the update */
+	std::vector<int> particle_spawns;
 
 	void StopWeather();
 	void UpdateRain();
@@ -255,10 +264,25 @@ inline int Game_Screen::GetWeatherStrength() {
 	return data.weather_strength;
 }
 
-inline const std::vector<Game_Screen::Particle>& Game_Screen::GetParticles() {
+inline const Game_Screen::Particles& Game_Screen::GetParticles() {
 	return particles;
 }
 
+inline int Game_Screen::Particles::size() const {
+	return static_cast<int>(t.size());
+}
+
+inline void Game_Screen::Particles::resize(int n) {
+	t.resize(n);
+	x.resize(n);
+	y.resize(n);
+	alpha.resize(n);
+	vx.resize(n);
+	vy.resize(n);
+	ax.resize(n);
+	ay.resize(n);
+}
+
 inline bool Game_Screen::IsBattleAnimationWaiting() {
 	return (bool)animation;
 }
@@ -26,6 +26,7 @@
 #include "game_variables.h"
 #include "output.h"
 #include "player.h"
+#include "regex_cache.h"
 #include "utils.h"
 
 #ifdef HAVE_NLOHMANN_JSON
@@ -66,13 +67,13 @@ StringView Game_Strings::Cat(Str_Params params, StringView string) {
 		return {};
 	}
 
-	auto it = _strings.find(params.string_id);
-	if (it == _strings.end()) {
+	if (!IsAssigned(params.string_id)) {
 		Set(params, string);
 		return Get(params.string_id);
 	}
-	it->second += ToString(string);
-	return it->second;
+	auto& str = _strings[params.string_id - 1];
+	str.append(string.data(), string.size());
+	return str;
 }
 
 int Game_Strings::ToNum(Str_Params params, int var_id, Game_Variables& variables) {
@@ -80,16 +81,16 @@ int Game_Strings::ToNum(Str_Params params, int var_id, Game_Variables& variables
 		return -1;
 	}
 
-	auto it = _strings.find(params.string_id);
-	if (it == _strings.end()) {
+	if (!IsAssigned(params.string_id)) {
 		return 0;
 	}
 
+	const auto& str = _strings[params.string_id - 1];
 	int num;
 	if (params.hex)
-		num = static_cast<int>(std::strtol(it->second.c_str(), nullptr, 16));
+		num = static_cast<int>(std::strtol(str.c_str(), nullptr, 16));
 	else
-		num = static_cast<int>(std::strtol(it->second.c_str(), nullptr, 0));
+		num = static_cast<int>(std::strtol(str.c_str(), nullptr, 0));
 
 	variables.Set(var_id, num);
 
@@ -136,7 +137,9 @@ int Game_Strings::Split(Str_Params params, const std::string& delimiter, int str
 		return -1;
 	}
 
-	std::string str = ToString(Get(params.string_id));
+	// Copy because the outputs can overwrite the source
+	const std::string str = ToString(Get(params.string_id));
+	StringView rest = str;
 
 	params.string_id = string_out_id;
 
@@ -157,7 +160,7 @@ int Game_Strings::Split(Str_Params params, const std::string& delimiter, int str
 				break;
 			}
 
-			Set(params, std::string(start_copy, iter - start_copy));
+			Set(params, StringView(start_copy, iter - start_copy));
 
 			params.string_id++;
 			components++;
@@ -166,24 +169,19 @@ int Game_Strings::Split(Str_Params params, const std::string& delimiter, int str
 	else {
 		components = 1;
 
-		if (str.find(delimiter) == std::string::npos) {
-			// token not found
-		}
-		else {
-			// This works for UTF-8
-			std::string token;
-			for (auto index = str.find(delimiter); index != std::string::npos; index = str.find(delimiter)) {
-				token = str.substr(0, index);
-				Set(params, token);
-				params.string_id++;
-				components++;
-				str.erase(0, index + delimiter.length());
-			}
+		// This works for UTF-8
+		size_t pos = 0;
+		for (auto index = str.find(delimiter); index != std::string::npos; index = str.find(delimiter, pos)) {
+			Set(params, rest.substr(pos, index - pos));
+			params.string_id++;
+			components++;
+			pos = index + delimiter.length();
 		}
+		rest = rest.substr(pos);
 	}
 
 	// set the remaining string
-	Set(params, str);
+	Set(params, rest);
 	variables.Set(var_id, components);
 
 	Game_Map::SetNeedRefreshForVarChange(var_id);
@@ -273,24 +271,46 @@ StringView Game_Strings::PopLine(Str_Params params, int offset, int string_out_i
 		return {};
 	}
 
-	std::string result;
-	StringView str = Get(params.string_id);
-
-	std::stringstream ss(ToString(str));
-
-	while (offset >= 0 && Utils::ReadLine(ss, result)) { offset--; }
+	// Grow first, views into the storage stay valid while writing
+	Reserve(string_out_id);
 
-	offset = ss.rdbuf()->in_avail();
-
-	Set(params, ss.str().substr(str.length() - offset));
+	StringView str = Get(params.string_id);
+	StringView line;
+	size_t pos = 0;
+
+	// Splits the lines like Utils::ReadLine
+	while (offset >= 0) {
+		if (pos == str.size()) {
+			line = {};
+			break;
+		}
+		auto end = str.find_first_of("\r\n", pos);
+		if (end == StringView::npos) {
+			line = str.substr(pos);
+			pos = str.size();
+		} else {
+			line = str.substr(pos, end - pos);
+			pos = end + 1;
+			if (str[end] == '\r' && pos < str.size() && str[pos] == '\n') {
+				++pos;
+			}
+		}
+		offset--;
+	}
 
 	// the maniacs implementation is to always preserve the mutated base string
 	// so in the case where the out_id matches the base string id, the popped line is discarded.
-	if (string_out_id != params.string_id) {
+	// The line is written first, it points into the base string.
+	const int base_id = params.string_id;
+	if (string_out_id != base_id) {
 		params.string_id = string_out_id;
-		Set(params, result);
+		Set(params, line);
 	}
-	return Get(params.string_id);
+
+	params.string_id = base_id;
+	Set(params, str.substr(pos));
+
+	return Get(string_out_id);
 }
 
 StringView Game_Strings::ExMatch(Str_Params params, std::string expr, int var_id, int begin, int string_out_id, Game_Variables& variables) {
@@ -310,7 +330,7 @@ StringView Game_Strings::ExMatch(Str_Params params, std::string expr, int var_id
 	auto wbase = Utils::ToWideString(base);
 	auto wexpr = Utils::ToWideString(expr);
 
-	std::wregex r(wexpr);
+	const auto& r = RegexCache::Get(wexpr);
 
 	std::regex_search(wbase, match, r);
 	str_result = Utils::FromWideString(match.str());
@@ -460,7 +480,7 @@ std::string Game_Strings::RegExReplace(StringView str, StringView search, String
 	auto wsearch = Utils::ToWideString(search);
 	auto wreplace = Utils::ToWideString(replace);
 
-	std::wregex rexp(wsearch);
+	const auto& rexp = RegexCache::Get(wsearch);
 
 	auto result = std::regex_replace(wstr, rexp, wreplace, flags);
 
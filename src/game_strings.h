@@ -19,6 +19,7 @@
 #include "system.h"
 #include <cstdint>
 #include <string>
+#include <vector>
 #include <lcf/data.h>
 #include "compiler.h"
 #include "game_variables.h"
@@ -47,7 +48,8 @@
  */
 class Game_Strings {
 public:
-	using Strings_t = std::unordered_map<int, std::string>;
+	/** Indexed by string id - 1 */
+	using Strings_t = std::vector<std::string>;
 
 	// currently only warns when ID <= 0
 	static constexpr int max_warnings = 10;
@@ -110,8 +112,17 @@ private:
 	//void Set(Str_Params params, StringView string);
 	bool ShouldWarn(int id) const;
 	void WarnGet(int id) const;
-
+	bool IsAssigned(int id) const;
+	void Reserve(int id);
+
+	/**
+	 * Dense storage, a slot keeps its capacity when it is reassigned.
+	 * Growing moves the strings, a StringView into the storage must not be
+	 * used after a write to a new id.
+	 */
 	Strings_t _strings;
+	/** Whether a string was ever assigned, Cat and ToNum treat unassigned strings differently */
+	std::vector<bool> _assigned;
 	mutable int _warnings = max_warnings;
 
 #ifdef HAVE_NLOHMANN_JSON
@@ -124,21 +135,28 @@ inline void Game_Strings::Set(Str_Params params, StringView string) {
 		return;
 	}
 
-	std::string ins_string = ToString(string);
+	std::string extracted;
 	if (params.extract) {
-		ins_string = Extract(ins_string, params.hex);
+		extracted = Extract(string, params.hex);
+		string = extracted;
+	}
+
+	if (!IsAssigned(params.string_id) && string.empty()) {
+		return;
 	}
 
-	auto it = _strings.find(params.string_id);
-	if (it == _strings.end()) {
-		if (ins_string.empty()) {
-			return;
-		} else {
-			_strings[params.string_id] = ins_string;
+	auto idx = params.string_id - 1;
+	if (params.string_id > static_cast<int>(_strings.size())) {
+		// string can point into the storage which is moved when growing
+		if (!params.extract) {
+			extracted = ToString(string);
 		}
+		Reserve(params.string_id);
+		_strings[idx] = std::move(extracted);
 	} else {
-		it->second = ins_string;
+		_strings[idx].assign(string.data(), string.size());
 	}
+	_assigned[idx] = true;
 
 #ifdef HAVE_NLOHMANN_JSON
 	_json_cache.erase(params.string_id);
@@ -147,6 +165,7 @@ inline void Game_Strings::Set(Str_Params params, StringView string) {
 
 inline void Game_Strings::SetData(Strings_t s) {
 	_strings = std::move(s);
+	_assigned.assign(_strings.size(), true);
 
 #ifdef HAVE_NLOHMANN_JSON
 	_json_cache.clear();
@@ -154,12 +173,10 @@ inline void Game_Strings::SetData(Strings_t s) {
 }
 
 inline void Game_Strings::SetData(const std::vector<lcf::DBString>& s) {
-	int i = 1;
-	for (const auto& string: s) {
-		if (!s.empty()) {
-			_strings[i] = ToString(string);
-		}
-		++i;
+	Reserve(static_cast<int>(s.size()));
+	for (size_t i = 0; i < s.size(); ++i) {
+		_strings[i] = ToString(s[i]);
+		_assigned[i] = true;
 	}
 
 #ifdef HAVE_NLOHMANN_JSON
@@ -174,12 +191,15 @@ inline const Game_Strings::Strings_t& Game_Strings::GetData() const {
 inline std::vector<lcf::DBString> Game_Strings::GetLcfData() const {
 	std::vector<lcf::DBString> lcf_data;
 
-	for (auto& [index, value]: _strings) {
-		assert(index > 0);
-		if (index >= static_cast<int>(lcf_data.size())) {
-			lcf_data.resize(index + 1);
-		}
-		lcf_data[index - 1] = lcf::DBString(value);
+	// Trailing unassigned strings are not saved
+	auto size = _assigned.size();
+	while (size > 0 && !_assigned[size - 1]) {
+		--size;
+	}
+
+	lcf_data.reserve(size);
+	for (size_t i = 0; i < size; ++i) {
+		lcf_data.emplace_back(_strings[i]);
 	}
 
 	return lcf_data;
@@ -189,15 +209,25 @@ inline bool Game_Strings::ShouldWarn(int id) const {
 	return id <= 0 && _warnings > 0;
 }
 
+inline bool Game_Strings::IsAssigned(int id) const {
+	return id > 0 && id <= static_cast<int>(_assigned.size()) && _assigned[id - 1];
+}
+
+inline void Game_Strings::Reserve(int id) {
+	if (id > static_cast<int>(_strings.size())) {
+		_strings.resize(id);
+		_assigned.resize(id, false);
+	}
+}
+
 inline StringView Game_Strings::Get(int id) const {
 	if (EP_UNLIKELY(ShouldWarn(id))) {
 		WarnGet(id);
 	}
-	auto it = _strings.find(id);
-	if (it == _strings.end()) {
+	if (id <= 0 || id > static_cast<int>(_strings.size())) {
 		return {};
 	}
-	return it->second;
+	return _strings[id - 1];
 }
 
 inline StringView Game_Strings::GetIndirect(int id, const Game_Variables& variables) const {
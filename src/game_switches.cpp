@@ -20,6 +20,56 @@
 #include "output.h"
 #include <lcf/reader_util.h>
 #include <lcf/data.h>
+#include <algorithm>
+#include <bitset>
+
+template <typename W, typename F>
+void Game_Switches::ForEachWord(W* words, int begin, int end, F&& op) {
+	if (begin >= end) {
+		return;
+	}
+	constexpr Word_t all_bits = ~Word_t(0);
+	const int first = begin / word_bits;
+	const int last = (end - 1) / word_bits;
+	const Word_t first_mask = all_bits << (begin % word_bits);
+	const Word_t last_mask = all_bits >> (word_bits - 1 - (end - 1) % word_bits);
+
+	if (first == last) {
+		op(words[first], first_mask & last_mask);
+		return;
+	}
+	op(words[first], first_mask);
+	for (int i = first + 1; i < last; ++i) {
+		op(words[i], all_bits);
+	}
+	op(words[last], last_mask);
+}
+
+void Game_Switches::SetData(const Switches_t& s) {
+	_size = static_cast<int>(s.size());
+	_words.assign((_size + word_bits - 1) / word_bits, 0);
+	for (int i = 0; i < _size; ++i) {
+		if (s[i]) {
+			_words[i / word_bits] |= Word_t(1) << (i % word_bits);
+		}
+	}
+}
+
+Game_Switches::Switches_t Game_Switches::GetData() const {
+	Switches_t s(_size);
+	for (int i = 0; i < _size; ++i) {
+		s[i] = (_words[i / word_bits] >> (i % word_bits)) & 1;
+	}
+	return s;
+}
+
+void Game_Switches::Resize(int size) {
+	if (size > _size) {
+		// New words are 0 and the bits after the old size are already 0
+		_words.resize((size + word_bits - 1) / word_bits, 0);
+		_size = size;
+	}
+}
 
 void Game_Switches::WarnGet(int variable_id) const {
 	Output::Debug("Invalid read sw[{}]!", variable_id);
@@ -34,11 +84,11 @@ bool Game_Switches::Set(int switch_id, bool value) {
 	if (switch_id <= 0) {
 		return false;
 	}
-	auto& ss = _switches;
-	if (switch_id > static_cast<int>(ss.size())) {
-		ss.resize(switch_id);
-	}
-	ss[switch_id - 1] = value;
+	Resize(switch_id);
+	const int bit = switch_id - 1;
+	auto& w = _words[bit / word_bits];
+	const Word_t mask = Word_t(1) << (bit % word_bits);
+	w = value ? (w | mask) : (w & ~mask);
 	return value;
 }
 
@@ -47,12 +97,12 @@ void Game_Switches::SetRange(int first_id, int last_id, bool value) {
 		Output::Debug("Invalid write sw[{},{}] = {}!", first_id, last_id, value);
 		--_warnings;
 	}
-	auto& ss = _switches;
-	if (last_id > static_cast<int>(ss.size())) {
-		ss.resize(last_id, false);
-	}
-	for (int i = std::max(0, first_id - 1); i < last_id; ++i) {
-		ss[i] = value;
+	Resize(last_id);
+	const int begin = std::max(0, first_id - 1);
+	if (value) {
+		ForEachWord(_words.data(), begin, last_id, [](Word_t& w, Word_t mask) { w |= mask; });
+	} else {
+		ForEachWord(_words.data(), begin, last_id, [](Word_t& w, Word_t mask) { w &= ~mask; });
 	}
 }
 
@@ -64,12 +114,11 @@ bool Game_Switches::Flip(int switch_id) {
 	if (switch_id <= 0) {
 		return false;
 	}
-	auto& ss = _switches;
-	if (switch_id > static_cast<int>(ss.size())) {
-		ss.resize(switch_id);
-	}
-	ss[switch_id - 1].flip();
-	return ss[switch_id - 1];
+	Resize(switch_id);
+	const int bit = switch_id - 1;
+	auto& w = _words[bit / word_bits];
+	w ^= Word_t(1) << (bit % word_bits);
+	return (w >> (bit % word_bits)) & 1;
 }
 
 void Game_Switches::FlipRange(int first_id, int last_id) {
@@ -77,13 +126,21 @@ void Game_Switches::FlipRange(int first_id, int last_id) {
 		Output::Debug("Invalid flip sw[{},{}]!", first_id, last_id);
 		--_warnings;
 	}
-	auto& ss = _switches;
-	if (last_id > static_cast<int>(ss.size())) {
-		ss.resize(last_id);
-	}
-	for (int i = std::max(0, first_id - 1); i < last_id; ++i) {
-		ss[i].flip();
+	Resize(last_id);
+	ForEachWord(_words.data(), std::max(0, first_id - 1), last_id, [](Word_t& w, Word_t mask) { w ^= mask; });
+}
+
+int Game_Switches::CountRange(int first_id, int last_id) const {
+	if (EP_UNLIKELY(ShouldWarn(first_id, last_id))) {
+		Output::Debug("Invalid read count(sw[{},{}])!", first_id, last_id);
+		--_warnings;
 	}
+	int count = 0;
+	// Switches after the end are OFF
+	ForEachWord(_words.data(), std::max(0, first_id - 1), std::min(last_id, _size), [&count](const Word_t& w, Word_t mask) {
+		count += static_cast<int>(std::bitset<word_bits>(w & mask).count());
+	});
+	return count;
 }
 
 StringView Game_Switches::GetName(int _id) const {
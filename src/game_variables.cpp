@@ -22,6 +22,8 @@
 #include <lcf/data.h>
 #include "utils.h"
 #include "rand.h"
+#include <algorithm>
+#include <array>
 #include <cmath>
 
 namespace {
@@ -32,48 +34,22 @@ constexpr Var_t VarSet(Var_t o, Var_t n) {
 	return n;
 }
 
-constexpr Var_t VarAdd(Var_t l, Var_t r) {
-	Var_t res = 0;
-
-#ifdef _MSC_VER
-	res = l + r;
-	if (res < 0 && l > 0 && r > 0) {
-		return std::numeric_limits<Var_t>::max();
-	} else if (res > 0 && l < 0 && r < 0) {
-		return std::numeric_limits<Var_t>::min();
-	}
-#else
-	if (EP_UNLIKELY(__builtin_add_overflow(l, r, &res))) {
-		if (l >= 0 && r >= 0) {
-			return std::numeric_limits<Var_t>::max();
-		}
-		return std::numeric_limits<Var_t>::min();
-	}
-#endif
+// Add and Sub are branch-free so that the range and array loops vectorize.
+// On overflow the result saturates to the limit with the sign of l.
+constexpr Var_t VarSaturate(Var_t l) {
+	return static_cast<Var_t>((static_cast<uint32_t>(l) >> 31) + static_cast<uint32_t>(std::numeric_limits<Var_t>::max()));
+}
 
-	return res;
+constexpr Var_t VarAdd(Var_t l, Var_t r) {
+	const auto res = static_cast<Var_t>(static_cast<uint32_t>(l) + static_cast<uint32_t>(r));
+	// Overflow when the sign of the result differs from the sign of both operands
+	return ((l ^ res) & (r ^ res)) < 0 ? VarSaturate(l) : res;
 }
 
 constexpr Var_t VarSub(Var_t l, Var_t r) {
-	Var_t res = 0;
-
-#ifdef _MSC_VER
-	res = l - r;
-	if (res < 0 && l > 0 && r < 0) {
-		return std::numeric_limits<Var_t>::max();
-	} else if (res > 0 && l < 0 && r > 0) {
-		return std::numeric_limits<Var_t>::min();
-	}
-#else
-	if (EP_UNLIKELY(__builtin_sub_overflow(l, r, &res))) {
-		if (r < 0) {
-			return std::numeric_limits<Var_t>::max();
-		}
-		return std::numeric_limits<Var_t>::min();
-	}
-#endif
-
-	return res;
+	const auto res = static_cast<Var_t>(static_cast<uint32_t>(l) - static_cast<uint32_t>(r));
+	// Overflow when the operands have a different sign and the result has the sign of r
+	return ((l ^ r) & (l ^ res)) < 0 ? VarSaturate(l) : res;
 }
 
 constexpr Var_t VarMult(Var_t l, Var_t r) {
@@ -101,11 +77,15 @@ constexpr Var_t VarMult(Var_t l, Var_t r) {
 }
 
 constexpr Var_t VarDiv(Var_t n, Var_t d) {
+	if (EP_UNLIKELY(d == -1)) {
+		// min / -1 does not fit
+		return VarSub(0, n);
+	}
 	return EP_LIKELY(d != 0) ? n / d : n;
 };
 
 constexpr Var_t VarMod(Var_t n, Var_t d) {
-	return EP_LIKELY(d != 0) ? n % d : 0;
+	return EP_LIKELY(d != 0 && d != -1) ? n % d : 0;
 };
 
 constexpr Var_t VarBitOr(Var_t n, Var_t d) {
@@ -128,6 +108,75 @@ constexpr Var_t VarBitShiftRight(Var_t n, Var_t d) {
 	return n >> d;
 };
 
+constexpr Var_t VarClamp(Var_t v, Var_t minval, Var_t maxval) {
+	// min/max instead of Utils::Clamp, maps to conditional moves or vector min/max
+	return std::min(std::max(v, minval), maxval);
+}
+
+template <Var_t (*Op)(Var_t, Var_t)>
+void RangeKernel(Var_t* first, Var_t* last, const Var_t value, const Var_t minval, const Var_t maxval) {
+	for (; first != last; ++first) {
+		*first = VarClamp(Op(*first, value), minval, maxval);
+	}
+}
+
+template <Var_t (*Op)(Var_t, Var_t)>
+void ArrayKernel(Var_t* first_a, Var_t* last_a, const Var_t* first_b, const Var_t minval, const Var_t maxval) {
+	// a and b may overlap, the compiler only vectorizes when the distance allows it
+	for (; first_a != last_a; ++first_a, ++first_b) {
+		*first_a = VarClamp(Op(*first_a, *first_b), minval, maxval);
+	}
+}
+
+/** Ranges shorter than this are sorted with std::sort */
+constexpr int radix_sort_threshold = 256;
+
+/**
+ * LSD radix sort with 8 bit digits. Digits which are equal for all values are
+ * skipped, the upper bytes of game variables rarely differ.
+ */
+void RadixSort(Var_t* first, Var_t* last) {
+	const size_t n = static_cast<size_t>(last - first);
+	std::vector<uint32_t> keys(n);
+	std::vector<uint32_t> tmp(n);
+
+	// Flipping the sign bit maps the signed order to the unsigned order
+	constexpr uint32_t sign = 0x80000000u;
+	std::array<std::array<size_t, 256>, 4> counts = {};
+	for (size_t i = 0; i < n; ++i) {
+		const uint32_t k = static_cast<uint32_t>(first[i]) ^ sign;
+		keys[i] = k;
+		++counts[0][k & 0xFF];
+		++counts[1][(k >> 8) & 0xFF];
+		++counts[2][(k >> 16) & 0xFF];
+		++counts[3][k >> 24];
+	}
+
+	for (int d = 0; d < 4; ++d) {
+		const int shift = d * 8;
+		auto& count = counts[d];
+		if (count[(keys[0] >> shift) & 0xFF] == n) {
+			continue;
+		}
+
+		size_t offset = 0;
+		for (auto& c: count) {
+			const size_t next = offset + c;
+			c = offset;
+			offset = next;
+		}
+
+		for (const auto k: keys) {
+			tmp[count[(k >> shift) & 0xFF]++] = k;
+		}
+		keys.swap(tmp);
+	}
+
+	for (size_t i = 0; i < n; ++i) {
+		first[i] = static_cast<Var_t>(keys[i] ^ sign);
+	}
+}
+
 }
 
 Game_Variables::Game_Variables(Var_t minval, Var_t maxval)
@@ -189,23 +238,30 @@ void Game_Variables::PrepareArray(const int first_id_a, const int last_id_a, con
 	}
 }
 
-template <typename V, typename F>
-void Game_Variables::WriteRange(const int first_id, const int last_id, V&& value, F&& op) {
+template <Game_Variables::Var_t (*Op)(Game_Variables::Var_t, Game_Variables::Var_t), typename V>
+void Game_Variables::WriteRange(const int first_id, const int last_id, V&& value) {
 	auto& vv = _variables;
 	for (int i = std::max(0, first_id - 1); i < last_id; ++i) {
 		auto& v = vv[i];
-		v = Utils::Clamp(op(v, value()), _min, _max);
+		v = VarClamp(Op(v, value()), _min, _max);
 	}
 }
 
-template <typename F>
-void Game_Variables::WriteArray(const int first_id_a, const int last_id_a, const int first_id_b, F&& op) {
-	auto& vv = _variables;
-	int out_b = std::max(0, first_id_b - 1);
-	for (int i = std::max(0, first_id_a - 1); i < last_id_a; ++i) {
-		auto& v_a = vv[i];
-		auto v_b = vv[out_b++];
-		v_a = Utils::Clamp(op(v_a, v_b), _min, _max);
+template <Game_Variables::Var_t (*Op)(Game_Variables::Var_t, Game_Variables::Var_t)>
+void Game_Variables::WriteRangeValue(const int first_id, const int last_id, Var_t value) {
+	const int begin = std::max(0, first_id - 1);
+	if (begin < last_id) {
+		auto* data = _variables.data();
+		RangeKernel<Op>(data + begin, data + last_id, value, _min, _max);
+	}
+}
+
+template <Game_Variables::Var_t (*Op)(Game_Variables::Var_t, Game_Variables::Var_t)>
+void Game_Variables::WriteArray(const int first_id_a, const int last_id_a, const int first_id_b) {
+	const int begin = std::max(0, first_id_a - 1);
+	if (begin < last_id_a) {
+		auto* data = _variables.data();
+		ArrayKernel<Op>(data + begin, data + last_id_a, data + std::max(0, first_id_b - 1), _min, _max);
 	}
 }
 
@@ -255,240 +311,237 @@ Game_Variables::Var_t Game_Variables::BitShiftRight(int variable_id, Var_t value
 
 void Game_Variables::SetRange(int first_id, int last_id, Var_t value) {
 	PrepareRange(first_id, last_id, "Invalid write var[{},{}] = {}!", value);
-	WriteRange(first_id, last_id, [value](){ return value; }, VarSet);
+	WriteRangeValue<VarSet>(first_id, last_id, value);
 }
 
 void Game_Variables::AddRange(int first_id, int last_id, Var_t value) {
 	PrepareRange(first_id, last_id, "Invalid write var[{},{}] += {}!", value);
-	WriteRange(first_id, last_id, [value](){ return value; }, VarAdd);
+	WriteRangeValue<VarAdd>(first_id, last_id, value);
 }
 
 void Game_Variables::SubRange(int first_id, int last_id, Var_t value) {
 	PrepareRange(first_id, last_id, "Invalid write var[{},{}] -= {}!", value);
-	WriteRange(first_id, last_id, [value](){ return value; }, VarSub);
+	WriteRangeValue<VarSub>(first_id, last_id, value);
 }
 
 void Game_Variables::MultRange(int first_id, int last_id, Var_t value) {
 	PrepareRange(first_id, last_id, "Invalid write var[{},{}] *= {}!", value);
-	WriteRange(first_id, last_id, [value](){ return value; }, VarMult);
+	WriteRangeValue<VarMult>(first_id, last_id, value);
 }
 
 void Game_Variables::DivRange(int first_id, int last_id, Var_t value) {
 	PrepareRange(first_id, last_id, "Invalid write var[{},{}] /= {}!", value);
-	WriteRange(first_id, last_id, [value](){ return value; }, VarDiv);
+	WriteRangeValue<VarDiv>(first_id, last_id, value);
 }
 
 void Game_Variables::ModRange(int first_id, int last_id, Var_t value) {
 	PrepareRange(first_id, last_id, "Invalid write var[{},{}] %= {}!", value);
-	WriteRange(first_id, last_id, [value](){ return value; }, VarMod);
+	WriteRangeValue<VarMod>(first_id, last_id, value);
 }
 
 void Game_Variables::BitOrRange(int first_id, int last_id, Var_t value) {
 	PrepareRange(first_id, last_id, "Invalid write var[{},{}] |= {}!", value);
-	WriteRange(first_id, last_id, [value](){ return value; }, VarBitOr);
+	WriteRangeValue<VarBitOr>(first_id, last_id, value);
 }
 
 void Game_Variables::BitAndRange(int first_id, int last_id, Var_t value) {
 	PrepareRange(first_id, last_id, "Invalid write var[{},{}] &= {}!", value);
-	WriteRange(first_id, last_id, [value](){ return value; }, VarBitAnd);
+	WriteRangeValue<VarBitAnd>(first_id, last_id, value);
 }
 
 void Game_Variables::BitXorRange(int first_id, int last_id, Var_t value) {
 	PrepareRange(first_id, last_id, "Invalid write var[{},{}] ^= {}!", value);
-	WriteRange(first_id, last_id, [value](){ return value; }, VarBitXor);
+	WriteRangeValue<VarBitXor>(first_id, last_id, value);
 }
 
 void Game_Variables::BitShiftLeftRange(int first_id, int last_id, Var_t value) {
 	PrepareRange(first_id, last_id, "Invalid write var[{},{}] <<= {}!", value);
-	WriteRange(first_id, last_id, [value](){ return value; }, VarBitShiftLeft);
+	WriteRangeValue<VarBitShiftLeft>(first_id, last_id, value);
 }
 
 void Game_Variables::BitShiftRightRange(int first_id, int last_id, Var_t value) {
 	PrepareRange(first_id, last_id, "Invalid write var[{},{}] >>= {}!", value);
-	WriteRange(first_id, last_id, [value](){ return value; }, VarBitShiftRight);
+	WriteRangeValue<VarBitShiftRight>(first_id, last_id, value);
 }
 
-template <typename F>
-void Game_Variables::WriteRangeVariable(int first_id, const int last_id, const int var_id, F&& op) {
+template <Game_Variables::Var_t (*Op)(Game_Variables::Var_t, Game_Variables::Var_t)>
+void Game_Variables::WriteRangeVariable(int first_id, const int last_id, const int var_id) {
 	if (var_id >= first_id && var_id <= last_id) {
-		auto value = Get(var_id);
-		WriteRange(first_id, var_id, [value](){ return value; }, std::forward<F>(op));
+		WriteRangeValue<Op>(first_id, var_id, Get(var_id));
 		first_id = var_id + 1;
 	}
-	auto value = Get(var_id);
-	WriteRange(first_id, last_id, [value](){ return value; }, std::forward<F>(op));
+	WriteRangeValue<Op>(first_id, last_id, Get(var_id));
 }
 
-
 void Game_Variables::SetRangeVariable(int first_id, int last_id, int var_id) {
 	PrepareRange(first_id, last_id, "Invalid write var[{},{}] = Var({})!", var_id);
-	WriteRangeVariable(first_id, last_id, var_id, VarSet);
+	WriteRangeVariable<VarSet>(first_id, last_id, var_id);
 }
 
 void Game_Variables::AddRangeVariable(int first_id, int last_id, int var_id) {
 	PrepareRange(first_id, last_id, "Invalid write var[{},{}] += var[{}]!", var_id);
-	WriteRangeVariable(first_id, last_id, var_id, VarAdd);
+	WriteRangeVariable<VarAdd>(first_id, last_id, var_id);
 }
 
 void Game_Variables::SubRangeVariable(int first_id, int last_id, int var_id) {
 	PrepareRange(first_id, last_id, "Invalid write var[{},{}] -= var[{}]!", var_id);
-	WriteRangeVariable(first_id, last_id, var_id, VarSub);
+	WriteRangeVariable<VarSub>(first_id, last_id, var_id);
 }
 
 void Game_Variables::MultRangeVariable(int first_id, int last_id, int var_id) {
 	PrepareRange(first_id, last_id, "Invalid write var[{},{}] *= var[{}]!", var_id);
-	WriteRangeVariable(first_id, last_id, var_id, VarMult);
+	WriteRangeVariable<VarMult>(first_id, last_id, var_id);
 }
 
 void Game_Variables::DivRangeVariable(int first_id, int last_id, int var_id) {
 	PrepareRange(first_id, last_id, "Invalid write var[{},{}] /= var[{}]!", var_id);
-	WriteRangeVariable(first_id, last_id, var_id, VarDiv);
+	WriteRangeVariable<VarDiv>(first_id, last_id, var_id);
 }
 
 void Game_Variables::ModRangeVariable(int first_id, int last_id, int var_id) {
 	PrepareRange(first_id, last_id, "Invalid write var[{},{}] /= var[{}]!", var_id);
-	WriteRangeVariable(first_id, last_id, var_id, VarMod);
+	WriteRangeVariable<VarMod>(first_id, last_id, var_id);
 }
 
 void Game_Variables::BitOrRangeVariable(int first_id, int last_id, int var_id) {
 	PrepareRange(first_id, last_id, "Invalid write var[{},{}] |= var[{}]!", var_id);
-	WriteRangeVariable(first_id, last_id, var_id, VarBitOr);
+	WriteRangeVariable<VarBitOr>(first_id, last_id, var_id);
 }
 
 void Game_Variables::BitAndRangeVariable(int first_id, int last_id, int var_id) {
 	PrepareRange(first_id, last_id, "Invalid write var[{},{}] &= var[{}]!", var_id);
-	WriteRangeVariable(first_id, last_id, var_id, VarBitAnd);
+	WriteRangeVariable<VarBitAnd>(first_id, last_id, var_id);
 }
 
 void Game_Variables::BitXorRangeVariable(int first_id, int last_id, int var_id) {
 	PrepareRange(first_id, last_id, "Invalid write var[{},{}] ^= var[{}]!", var_id);
-	WriteRangeVariable(first_id, last_id, var_id, VarBitXor);
+	WriteRangeVariable<VarBitXor>(first_id, last_id, var_id);
 }
 
 void Game_Variables::BitShiftLeftRangeVariable(int first_id, int last_id, int var_id) {
 	PrepareRange(first_id, last_id, "Invalid write var[{},{}] <<= var[{}]!", var_id);
-	WriteRangeVariable(first_id, last_id, var_id, VarBitShiftLeft);
+	WriteRangeVariable<VarBitShiftLeft>(first_id, last_id, var_id);
 }
 
 void Game_Variables::BitShiftRightRangeVariable(int first_id, int last_id, int var_id) {
 	PrepareRange(first_id, last_id, "Invalid write var[{},{}] >>= var[{}]!", var_id);
-	WriteRangeVariable(first_id, last_id, var_id, VarBitShiftRight);
+	WriteRangeVariable<VarBitShiftRight>(first_id, last_id, var_id);
 }
 
 void Game_Variables::SetRangeVariableIndirect(int first_id, int last_id, int var_id) {
 	PrepareRange(first_id, last_id, "Invalid write var[{},{}] = var[var[{}]]!", var_id);
-	WriteRange(first_id, last_id, [this,var_id](){ return Get(Get(var_id)); }, VarSet);
+	WriteRange<VarSet>(first_id, last_id, [this,var_id](){ return Get(Get(var_id)); });
 }
 
 void Game_Variables::AddRangeVariableIndirect(int first_id, int last_id, int var_id) {
 	PrepareRange(first_id, last_id, "Invalid write var[{},{}] += var[var[{}]]!", var_id);
-	WriteRange(first_id, last_id, [this,var_id](){ return Get(Get(var_id)); }, VarAdd);
+	WriteRange<VarAdd>(first_id, last_id, [this,var_id](){ return Get(Get(var_id)); });
 }
 
 void Game_Variables::SubRangeVariableIndirect(int first_id, int last_id, int var_id) {
 	PrepareRange(first_id, last_id, "Invalid write var[{},{}] -= var[var[{}]]!", var_id);
-	WriteRange(first_id, last_id, [this,var_id](){ return Get(Get(var_id)); }, VarSub);
+	WriteRange<VarSub>(first_id, last_id, [this,var_id](){ return Get(Get(var_id)); });
 }
 
 void Game_Variables::MultRangeVariableIndirect(int first_id, int last_id, int var_id) {
 	PrepareRange(first_id, last_id, "Invalid write var[{},{}] *= var[var[{}]]!", var_id);
-	WriteRange(first_id, last_id, [this,var_id](){ return Get(Get(var_id)); }, VarMult);
+	WriteRange<VarMult>(first_id, last_id, [this,var_id](){ return Get(Get(var_id)); });
 }
 
 void Game_Variables::DivRangeVariableIndirect(int first_id, int last_id, int var_id) {
 	PrepareRange(first_id, last_id, "Invalid write var[{},{}] /= var[var[{}]]!", var_id);
-	WriteRange(first_id, last_id, [this,var_id](){ return Get(Get(var_id)); }, VarDiv);
+	WriteRange<VarDiv>(first_id, last_id, [this,var_id](){ return Get(Get(var_id)); });
 }
 
 void Game_Variables::ModRangeVariableIndirect(int first_id, int last_id, int var_id) {
 	PrepareRange(first_id, last_id, "Invalid write var[{},{}] %= var[var[{}]]!", var_id);
-	WriteRange(first_id, last_id, [this,var_id](){ return Get(Get(var_id)); }, VarMod);
+	WriteRange<VarMod>(first_id, last_id, [this,var_id](){ return Get(Get(var_id)); });
 }
 
 void Game_Variables::BitOrRangeVariableIndirect(int first_id, int last_id, int var_id) {
 	PrepareRange(first_id, last_id, "Invalid write var[{},{}] |= var[var[{}]]!", var_id);
-	WriteRange(first_id, last_id, [this,var_id](){ return Get(Get(var_id)); }, VarBitOr);
+	WriteRange<VarBitOr>(first_id, last_id, [this,var_id](){ return Get(Get(var_id)); });
 }
 
 void Game_Variables::BitAndRangeVariableIndirect(int first_id, int last_id, int var_id) {
 	PrepareRange(first_id, last_id, "Invalid write var[{},{}] &= var[var[{}]]!", var_id);
-	WriteRange(first_id, last_id, [this,var_id](){ return Get(Get(var_id)); }, VarBitAnd);
+	WriteRange<VarBitAnd>(first_id, last_id, [this,var_id](){ return Get(Get(var_id)); });
 }
 
 void Game_Variables::BitXorRangeVariableIndirect(int first_id, int last_id, int var_id) {
 	PrepareRange(first_id, last_id, "Invalid write var[{},{}] ^= var[var[{}]]!", var_id);
-	WriteRange(first_id, last_id, [this,var_id](){ return Get(Get(var_id)); }, VarBitXor);
+	WriteRange<VarBitXor>(first_id, last_id, [this,var_id](){ return Get(Get(var_id)); });
 }
 
 void Game_Variables::BitShiftLeftRangeVariableIndirect(int first_id, int last_id, int var_id) {
 	PrepareRange(first_id, last_id, "Invalid write var[{},{}] <<= var[var[{}]]!", var_id);
-	WriteRange(first_id, last_id, [this,var_id](){ return Get(Get(var_id)); }, VarBitShiftLeft);
+	WriteRange<VarBitShiftLeft>(first_id, last_id, [this,var_id](){ return Get(Get(var_id)); });
 }
 
 void Game_Variables::BitShiftRightRangeVariableIndirect(int first_id, int last_id, int var_id) {
 	PrepareRange(first_id, last_id, "Invalid write var[{},{}] >>= var[var[{}]]!", var_id);
-	WriteRange(first_id, last_id, [this,var_id](){ return Get(Get(var_id)); }, VarBitShiftRight);
+	WriteRange<VarBitShiftRight>(first_id, last_id, [this,var_id](){ return Get(Get(var_id)); });
 }
 
 void Game_Variables::SetRangeRandom(int first_id, int last_id, Var_t minval, Var_t maxval) {
 	PrepareRange(first_id, last_id, "Invalid write var[{},{}] = rand({},{})!", minval, maxval);
-	WriteRange(first_id, last_id, [minval,maxval](){ return Rand::GetRandomNumber(minval, maxval); }, VarSet);
+	WriteRange<VarSet>(first_id, last_id, [minval,maxval](){ return Rand::GetRandomNumber(minval, maxval); });
 }
 
 void Game_Variables::AddRangeRandom(int first_id, int last_id, Var_t minval, Var_t maxval) {
 	PrepareRange(first_id, last_id, "Invalid write var[{},{}] += rand({},{})!", minval, maxval);
-	WriteRange(first_id, last_id, [minval,maxval](){ return Rand::GetRandomNumber(minval, maxval); }, VarAdd);
+	WriteRange<VarAdd>(first_id, last_id, [minval,maxval](){ return Rand::GetRandomNumber(minval, maxval); });
 }
 
 void Game_Variables::SubRangeRandom(int first_id, int last_id, Var_t minval, Var_t maxval) {
 	PrepareRange(first_id, last_id, "Invalid write var[{},{}] -= rand({},{})!", minval, maxval);
-	WriteRange(first_id, last_id, [minval,maxval](){ return Rand::GetRandomNumber(minval, maxval); }, VarSub);
+	WriteRange<VarSub>(first_id, last_id, [minval,maxval](){ return Rand::GetRandomNumber(minval, maxval); });
 }
 
 void Game_Variables::MultRangeRandom(int first_id, int last_id, Var_t minval, Var_t maxval) {
 	PrepareRange(first_id, last_id, "Invalid write var[{},{}] *= rand({},{})!", minval, maxval);
-	WriteRange(first_id, last_id, [minval,maxval](){ return Rand::GetRandomNumber(minval, maxval); }, VarMult);
+	WriteRange<VarMult>(first_id, last_id, [minval,maxval](){ return Rand::GetRandomNumber(minval, maxval); });
 }
 
 void Game_Variables::DivRangeRandom(int first_id, int last_id, Var_t minval, Var_t maxval) {
 	PrepareRange(first_id, last_id, "Invalid write var[{},{}] /= rand({},{})!", minval, maxval);
-	WriteRange(first_id, last_id, [minval,maxval](){ return Rand::GetRandomNumber(minval, maxval); }, VarDiv);
+	WriteRange<VarDiv>(first_id, last_id, [minval,maxval](){ return Rand::GetRandomNumber(minval, maxval); });
 }
 
 void Game_Variables::ModRangeRandom(int first_id, int last_id, Var_t minval, Var_t maxval) {
 	PrepareRange(first_id, last_id, "Invalid write var[{},{}] %= rand({},{})!", minval, maxval);
-	WriteRange(first_id, last_id, [minval,maxval](){ return Rand::GetRandomNumber(minval, maxval); }, VarMod);
+	WriteRange<VarMod>(first_id, last_id, [minval,maxval](){ return Rand::GetRandomNumber(minval, maxval); });
 }
 
 void Game_Variables::BitOrRangeRandom(int first_id, int last_id, Var_t minval, Var_t maxval) {
 	PrepareRange(first_id, last_id, "Invalid write var[{},{}] |= rand({},{})!", minval, maxval);
-	WriteRange(first_id, last_id, [minval,maxval](){ return Rand::GetRandomNumber(minval, maxval); }, VarBitOr);
+	WriteRange<VarBitOr>(first_id, last_id, [minval,maxval](){ return Rand::GetRandomNumber(minval, maxval); });
 }
 
 void Game_Variables::BitAndRangeRandom(int first_id, int last_id, Var_t minval, Var_t maxval) {
 	PrepareRange(first_id, last_id, "Invalid write var[{},{}] &= rand({},{})!", minval, maxval);
-	WriteRange(first_id, last_id, [minval,maxval](){ return Rand::GetRandomNumber(minval, maxval); }, VarBitAnd);
+	WriteRange<VarBitAnd>(first_id, last_id, [minval,maxval](){ return Rand::GetRandomNumber(minval, maxval); });
 }
 
 void Game_Variables::BitXorRangeRandom(int first_id, int last_id, Var_t minval, Var_t maxval) {
 	PrepareRange(first_id, last_id, "Invalid write var[{},{}] ^= rand({},{})!", minval, maxval);
-	WriteRange(first_id, last_id, [minval,maxval](){ return Rand::GetRandomNumber(minval, maxval); }, VarBitXor);
+	WriteRange<VarBitXor>(first_id, last_id, [minval,maxval](){ return Rand::GetRandomNumber(minval, maxval); });
 }
 
 void Game_Variables::BitShiftLeftRangeRandom(int first_id, int last_id, Var_t minval, Var_t maxval) {
 	PrepareRange(first_id, last_id, "Invalid write var[{},{}] <<= rand({},{})!", minval, maxval);
-	WriteRange(first_id, last_id, [minval,maxval](){ return Rand::GetRandomNumber(minval, maxval); }, VarBitShiftLeft);
+	WriteRange<VarBitShiftLeft>(first_id, last_id, [minval,maxval](){ return Rand::GetRandomNumber(minval, maxval); });
 }
 
 void Game_Variables::BitShiftRightRangeRandom(int first_id, int last_id, Var_t minval, Var_t maxval) {
 	PrepareRange(first_id, last_id, "Invalid write var[{},{}] >>= rand({},{})!", minval, maxval);
-	WriteRange(first_id, last_id, [minval,maxval](){ return Rand::GetRandomNumber(minval, maxval); }, VarBitShiftRight);
+	WriteRange<VarBitShiftRight>(first_id, last_id, [minval,maxval](){ return Rand::GetRandomNumber(minval, maxval); });
 }
 
 void Game_Variables::EnumerateRange(int first_id, int last_id, Var_t value) {
 	PrepareRange(first_id, last_id, "Invalid write enumerate(var[{},{}])!");
 	Var_t out_value = value;
-	WriteRange(first_id, last_id, [&out_value](){ return out_value++; }, VarSet);
+	WriteRange<VarSet>(first_id, last_id, [&out_value](){ return out_value++; });
 }
 
 void Game_Variables::SortRange(int first_id, int last_id, bool asc) {
@@ -496,13 +549,18 @@ void Game_Variables::SortRange(int first_id, int last_id, bool asc) {
 	auto& vv = _variables;
 	int i = std::max(0, first_id - 1);
 	if (i < last_id) {
-		auto sorter = [&](auto&& fn) {
-			std::stable_sort(vv.begin() + i, vv.begin() + last_id, fn);
-		};
-		if (asc) {
-			sorter(std::less<>());
+		// Equal integers are indistinguishable, a stable sort is not required
+		auto* first = vv.data() + i;
+		auto* last = vv.data() + last_id;
+		if (last_id - i >= radix_sort_threshold) {
+			RadixSort(first, last);
+			if (!asc) {
+				std::reverse(first, last);
+			}
+		} else if (asc) {
+			std::sort(first, last, std::less<>());
 		} else {
-			sorter(std::greater<>());
+			std::sort(first, last, std::greater<>());
 		}
 	}
 }
@@ -521,7 +579,7 @@ void Game_Variables::SetArray(int first_id_a, int last_id_a, int first_id_b) {
 	// Maniac Patch uses memcpy which is actually a memmove
 	// This ensures overlapping areas are copied properly
 	if (first_id_a < first_id_b) {
-		WriteArray(first_id_a, last_id_a, first_id_b, VarSet);
+		WriteArray<VarSet>(first_id_a, last_id_a, first_id_b);
 	} else {
 		auto& vv = _variables;
 		const int steps = std::max(0, last_id_a - first_id_a + 1);
@@ -537,52 +595,52 @@ void Game_Variables::SetArray(int first_id_a, int last_id_a, int first_id_b) {
 
 void Game_Variables::AddArray(int first_id_a, int last_id_a, int first_id_b) {
 	PrepareArray(first_id_a, last_id_a, first_id_b, "Invalid write var[{},{}] += var[{},{}]!");
-	WriteArray(first_id_a, last_id_a, first_id_b, VarAdd);
+	WriteArray<VarAdd>(first_id_a, last_id_a, first_id_b);
 }
 
 void Game_Variables::SubArray(int first_id_a, int last_id_a, int first_id_b) {
 	PrepareArray(first_id_a, last_id_a, first_id_b, "Invalid write var[{},{}] -= var[{},{}]!");
-	WriteArray(first_id_a, last_id_a, first_id_b, VarSub);
+	WriteArray<VarSub>(first_id_a, last_id_a, first_id_b);
 }
 
 void Game_Variables::MultArray(int first_id_a, int last_id_a, int first_id_b) {
 	PrepareArray(first_id_a, last_id_a, first_id_b, "Invalid write var[{},{}] *= var[{},{}]!");
-	WriteArray(first_id_a, last_id_a, first_id_b, VarMult);
+	WriteArray<VarMult>(first_id_a, last_id_a, first_id_b);
 }
 
 void Game_Variables::DivArray(int first_id_a, int last_id_a, int first_id_b) {
 	PrepareArray(first_id_a, last_id_a, first_id_b, "Invalid write var[{},{}] /= var[{},{}]!");
-	WriteArray(first_id_a, last_id_a, first_id_b, VarDiv);
+	WriteArray<VarDiv>(first_id_a, last_id_a, first_id_b);
 }
 
 void Game_Variables::ModArray(int first_id_a, int last_id_a, int first_id_b) {
 	PrepareArray(first_id_a, last_id_a, first_id_b, "Invalid write var[{},{}] %= var[{},{}]!");
-	WriteArray(first_id_a, last_id_a, first_id_b, VarMod);
+	WriteArray<VarMod>(first_id_a, last_id_a, first_id_b);
 }
 
 void Game_Variables::BitOrArray(int first_id_a, int last_id_a, int first_id_b) {
 	PrepareArray(first_id_a, last_id_a, first_id_b, "Invalid write var[{},{}] |= var[{},{}]!");
-	WriteArray(first_id_a, last_id_a, first_id_b, VarBitOr);
+	WriteArray<VarBitOr>(first_id_a, last_id_a, first_id_b);
 }
 
 void Game_Variables::BitAndArray(int first_id_a, int last_id_a, int first_id_b) {
 	PrepareArray(first_id_a, last_id_a, first_id_b, "Invalid write var[{},{}] &= var[{},{}]!");
-	WriteArray(first_id_a, last_id_a, first_id_b, VarBitAnd);
+	WriteArray<VarBitAnd>(first_id_a, last_id_a, first_id_b);
 }
 
 void Game_Variables::BitXorArray(int first_id_a, int last_id_a, int first_id_b) {
 	PrepareArray(first_id_a, last_id_a, first_id_b, "Invalid write var[{},{}] ^= var[{},{}]!");
-	WriteArray(first_id_a, last_id_a, first_id_b, VarBitXor);
+	WriteArray<VarBitXor>(first_id_a, last_id_a, first_id_b);
 }
 
 void Game_Variables::BitShiftLeftArray(int first_id_a, int last_id_a, int first_id_b) {
 	PrepareArray(first_id_a, last_id_a, first_id_b, "Invalid write var[{},{}] <<= var[{},{}]!");
-	WriteArray(first_id_a, last_id_a, first_id_b, VarBitShiftLeft);
+	WriteArray<VarBitShiftLeft>(first_id_a, last_id_a, first_id_b);
 }
 
 void Game_Variables::BitShiftRightArray(int first_id_a, int last_id_a, int first_id_b) {
 	PrepareArray(first_id_a, last_id_a, first_id_b, "Invalid write var[{},{}] >>= var[{},{}]!");
-	WriteArray(first_id_a, last_id_a, first_id_b, VarBitShiftRight);
+	WriteArray<VarBitShiftRight>(first_id_a, last_id_a, first_id_b);
 }
 
 void Game_Variables::SwapArray(int first_id_a, int last_id_a, int first_id_b) {
@@ -149,12 +149,14 @@ private:
 		void PrepareRange(const int first_id, const int last_id, const char* warn, Args... args);
 	template <typename... Args>
 		void PrepareArray(const int first_id_a, const int last_id_a, const int first_id_b, const char* warn, Args... args);
-	template <typename V, typename F>
-		void WriteRange(const int first_id, const int last_id, V&& value, F&& op);
-	template <typename F>
-		void WriteRangeVariable(const int first_id, const int last_id, int var_id, F&& op);
-	template <typename F>
-		void WriteArray(const int first_id_a, const int last_id_a, const int first_id_b, F&& op);
+	template <Var_t (*Op)(Var_t, Var_t), typename V>
+		void WriteRange(const int first_id, const int last_id, V&& value);
+	template <Var_t (*Op)(Var_t, Var_t)>
+		void WriteRangeValue(const int first_id, const int last_id, Var_t value);
+	template <Var_t (*Op)(Var_t, Var_t)>
+		void WriteRangeVariable(const int first_id, const int last_id, int var_id);
+	template <Var_t (*Op)(Var_t, Var_t)>
+		void WriteArray(const int first_id_a, const int last_id_a, const int first_id_b);
 
 	Variables_t _variables;
 	Var_t _min = 0;
@@ -0,0 +1,152 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Headers
+#include "interpreter_profiler.h"
+#include <algorithm>
+#include <map>
+#include <tuple>
+#include <unordered_map>
+#include <fmt/format.h>
+
+namespace {
+	struct Key {
+		InterpreterProfiler::Source source;
+		int command_index;
+		int code;
+
+		auto Tie() const {
+			return std::tie(source.type, source.map_id, source.event_id, source.page_id, command_index, code);
+		}
+
+		bool operator==(const Key& o) const {
+			return Tie() == o.Tie();
+		}
+	};
+
+	struct KeyHash {
+		size_t operator()(const Key& key) const {
+			size_t h = static_cast<size_t>(key.source.type);
+			for (int v: { key.source.map_id, key.source.event_id, key.source.page_id, key.command_index, key.code }) {
+				h = h * 31 + std::hash<int>()(v);
+			}
+			return h;
+		}
+	};
+
+	struct Counter {
+		int64_t count = 0;
+		std::chrono::nanoseconds time = {};
+	};
+
+	bool enabled = false;
+	std::unordered_map<Key, Counter, KeyHash> counters;
+
+	void SortByTime(std::vector<InterpreterProfiler::Entry>& entries) {
+		std::sort(entries.begin(), entries.end(), [](const auto& a, const auto& b) {
+			return a.time > b.time;
+		});
+	}
+
+	const char* GetTypeName(InterpreterProfiler::SourceType type) {
+		switch (type) {
+			case InterpreterProfiler::SourceType::MapEvent:
+				return "map_event";
+			case InterpreterProfiler::SourceType::CommonEvent:
+				return "common_event";
+			default:
+				return "other";
+		}
+	}
+}
+
+bool InterpreterProfiler::IsEnabled() {
+	return enabled;
+}
+
+void InterpreterProfiler::SetEnabled(bool enable) {
+	enabled = enable;
+}
+
+void InterpreterProfiler::Record(const Source& source, int command_index, int code, std::chrono::nanoseconds time) {
+	auto& counter = counters[{ source, command_index, code }];
+	++counter.count;
+	counter.time += time;
+}
+
+std::vector<InterpreterProfiler::Entry> InterpreterProfiler::GetCommandEntries() {
+	std::vector<Entry> entries;
+	entries.reserve(counters.size());
+
+	for (const auto& c: counters) {
+		entries.push_back({ c.first.source, c.first.command_index, c.first.code, c.second.count, c.second.time });
+	}
+
+	SortByTime(entries);
+	return entries;
+}
+
+std::vector<InterpreterProfiler::Entry> InterpreterProfiler::GetEventEntries() {
+	using SourceKey = std::tuple<SourceType, int, int, int>;
+	std::map<SourceKey, Entry> events;
+
+	for (const auto& c: counters) {
+		const auto& s = c.first.source;
+		auto& entry = events[SourceKey(s.type, s.map_id, s.event_id, s.page_id)];
+		entry.source = s;
+		entry.count += c.second.count;
+		entry.time += c.second.time;
+	}
+
+	std::vector<Entry> entries;
+	entries.reserve(events.size());
+	for (const auto& e: events) {
+		entries.push_back(e.second);
+	}
+
+	SortByTime(entries);
+	return entries;
+}
+
+void InterpreterProfiler::Reset() {
+	counters.clear();
+}
+
+bool InterpreterProfiler::WriteCsv(std::ostream& os) {
+	os << "type,map_id,event_id,page_id,command_index,code,count,time_us\n";
+
+	for (const auto& entry: GetCommandEntries()) {
+		const auto& s = entry.source;
+		os << fmt::format("{},{},{},{},{},{},{},{}\n",
+			GetTypeName(s.type), s.map_id, s.event_id, s.page_id,
+			entry.command_index, entry.code, entry.count,
+			std::chrono::duration_cast<std::chrono::microseconds>(entry.time).count());
+	}
+
+	return os.good();
+}
+
+std::string InterpreterProfiler::GetSourceName(const Source& source) {
+	switch (source.type) {
+		case SourceType::MapEvent:
+			return fmt::format("M{:04d} EV{:04d} P{}", source.map_id, source.event_id, source.page_id);
+		case SourceType::CommonEvent:
+			return fmt::format("CE{:04d}", source.event_id);
+		default:
+			return fmt::format("EV{:04d}", source.event_id);
+	}
+}
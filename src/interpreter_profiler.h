@@ -0,0 +1,103 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EP_INTERPRETER_PROFILER_H
+#define EP_INTERPRETER_PROFILER_H
+
+// Headers
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * Optional profiler of the event interpreters.
+ * Counts executed commands and their wall time per command of an event
+ * page or common event, to find the events which use up the frame time.
+ * Disabled by default, enabled with --profile-interpreter.
+ */
+namespace InterpreterProfiler {
+	enum class SourceType {
+		/** Lists without an owner, e.g. troop pages or loaded from a save */
+		Other,
+		MapEvent,
+		CommonEvent
+	};
+
+	/** Origin of a command list */
+	struct Source {
+		SourceType type = SourceType::Other;
+		int map_id = 0;
+		/** Map event or common event ID */
+		int event_id = 0;
+		int page_id = 0;
+	};
+
+	/** Accumulated statistic of a command or of a whole event */
+	struct Entry {
+		Source source;
+		/** Index in the command list, -1 for event totals */
+		int command_index = -1;
+		/** Command code, 0 for event totals */
+		int code = 0;
+		int64_t count = 0;
+		std::chrono::nanoseconds time = {};
+	};
+
+	/** @return Whether commands are recorded */
+	bool IsEnabled();
+
+	/**
+	 * Enables or disables recording. Recorded data is kept.
+	 *
+	 * @param enabled Whether to record
+	 */
+	void SetEnabled(bool enabled);
+
+	/**
+	 * Records one execution of a command.
+	 *
+	 * @param source Origin of the command list
+	 * @param command_index Index of the command in the list
+	 * @param code Command code
+	 * @param time Wall time spent in the command
+	 */
+	void Record(const Source& source, int command_index, int code, std::chrono::nanoseconds time);
+
+	/** @return statistics per command, sorted by time descending */
+	std::vector<Entry> GetCommandEntries();
+
+	/** @return statistics per event page or common event, sorted by time descending */
+	std::vector<Entry> GetEventEntries();
+
+	/** Removes all recorded data */
+	void Reset();
+
+	/**
+	 * Writes the statistics per command as CSV.
+	 *
+	 * @param os Output stream
+	 * @return Whether writing succeeded
+	 */
+	bool WriteCsv(std::ostream& os);
+
+	/** @return short name of the source for display, e.g. "CE0012" or "M0003 EV0004 P1" */
+	std::string GetSourceName(const Source& source);
+}
+
+#endif
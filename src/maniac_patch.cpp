@@ -801,9 +801,18 @@ bool ManiacPatch::CheckString(StringView str_l, StringView str_r, int op, bool i
 	};
 
 	if (ignore_case) {
-		std::string str_l_lower = Utils::LowerCase(str_l);
-		std::string str_r_lower = Utils::LowerCase(str_r);
-		return check(str_l_lower, str_r_lower);
+		switch (op) {
+			case 0: // eq
+				return Utils::StrICmp(str_l, str_r) == 0;
+			case 2: // contains (l contains r)
+				return Utils::StrIFind(str_l, str_r) != std::string::npos;
+			case 1: // neq
+				return Utils::StrICmp(str_l, str_r) != 0;
+			case 3: // notContains (l does not contain r)
+				return Utils::StrIFind(str_l, str_r) == std::string::npos;
+			default:
+				return false;
+		}
 	}
 
 	return check(str_l, str_r);
@@ -41,6 +41,7 @@
 #include "output.h"
 #include "player.h"
 #include "bitmap.h"
+#include "scaler.h"
 #include "lcf/scope_guard.h"
 
 #if defined(__APPLE__) && TARGET_OS_OSX
@@ -220,6 +221,9 @@ Sdl2Ui::~Sdl2Ui() {
 	if (sdl_texture_scaled) {
 		SDL_DestroyTexture(sdl_texture_scaled);
 	}
+	if (cpu_scaling.texture) {
+		SDL_DestroyTexture(cpu_scaling.texture);
+	}
 	if (sdl_renderer) {
 		SDL_DestroyRenderer(sdl_renderer);
 	}
@@ -416,6 +420,8 @@ bool Sdl2Ui::RefreshDisplayMode() {
 					!!(rinfo.flags & SDL_RENDERER_PRESENTVSYNC)
 					);
 			texture_format = SelectFormat(rinfo, false);
+			// Scaling in the SDL software renderer is slower than Scaler
+			cpu_scaling.enabled = (rinfo.flags & SDL_RENDERER_SOFTWARE) != 0;
 		} else {
 			Output::Debug("SDL_GetRendererInfo failed : {}", SDL_GetError());
 		}
@@ -433,6 +439,10 @@ bool Sdl2Ui::RefreshDisplayMode() {
 
 		Output::Debug("SDL2: Selected Pixel Format {}", SDL_GetPixelFormatName(texture_format));
 
+		if (SDL_BYTESPERPIXEL(texture_format) != 4) {
+			cpu_scaling.enabled = false;
+		}
+
 		// Flush display
 		SDL_RenderClear(sdl_renderer);
 		SDL_RenderPresent(sdl_renderer);
@@ -595,23 +605,27 @@ void Sdl2Ui::ToggleVsync() {
 }
 
 void Sdl2Ui::UpdateDisplay() {
-#ifdef __WIIU__
-	if (vcfg.scaling_mode.Get() == ConfigEnum::ScalingMode::Bilinear && window.scale > 0.f) {
-		// Workaround WiiU bug: Bilinear uses a render target and for these the format is not converted
-		void* target_pixels;
-		int target_pitch;
-
-		SDL_LockTexture(sdl_texture_game, nullptr, &target_pixels, &target_pitch);
-		SDL_ConvertPixels(main_surface->width(), main_surface->height(), GetDefaultFormat(), main_surface->pixels(),
-			main_surface->pitch(), SDL_PIXELFORMAT_RGBA8888, target_pixels, target_pitch);
-		SDL_UnlockTexture(sdl_texture_game);
+	if (cpu_scaling.texture) {
+		// The scaled frame is uploaded below
 	} else {
-		SDL_UpdateTexture(sdl_texture_game, nullptr, main_surface->pixels(), main_surface->pitch());
-	}
+#ifdef __WIIU__
+		if (vcfg.scaling_mode.Get() == ConfigEnum::ScalingMode::Bilinear && window.scale > 0.f) {
+			// Workaround WiiU bug: Bilinear uses a render target and for these the format is not converted
+			void* target_pixels;
+			int target_pitch;
+
+			SDL_LockTexture(sdl_texture_game, nullptr, &target_pixels, &target_pitch);
+			SDL_ConvertPixels(main_surface->width(), main_surface->height(), GetDefaultFormat(), main_surface->pixels(),
+				main_surface->pitch(), SDL_PIXELFORMAT_RGBA8888, target_pixels, target_pitch);
+			SDL_UnlockTexture(sdl_texture_game);
+		} else {
+			SDL_UpdateTexture(sdl_texture_game, nullptr, main_surface->pixels(), main_surface->pitch());
+		}
 #else
-	// SDL_UpdateTexture was found to be faster than SDL_LockTexture / SDL_UnlockTexture.
-	SDL_UpdateTexture(sdl_texture_game, nullptr, main_surface->pixels(), main_surface->pitch());
+		// SDL_UpdateTexture was found to be faster than SDL_LockTexture / SDL_UnlockTexture.
+		SDL_UpdateTexture(sdl_texture_game, nullptr, main_surface->pixels(), main_surface->pitch());
 #endif
+	}
 
 	if (window.size_changed && window.width > 0 && window.height > 0) {
 		// Based on SDL2 function UpdateLogicalSize
@@ -675,7 +689,22 @@ void Sdl2Ui::UpdateDisplay() {
 			SDL_RenderSetViewport(sdl_renderer, &viewport);
 		}
 
-		if (vcfg.scaling_mode.Get() == ConfigEnum::ScalingMode::Bilinear && window.scale > 0.f) {
+		if (cpu_scaling.enabled) {
+			if (cpu_scaling.texture) {
+				SDL_DestroyTexture(cpu_scaling.texture);
+				cpu_scaling.texture = nullptr;
+			}
+			cpu_scaling.width = viewport.w;
+			cpu_scaling.height = viewport.h;
+			if (cpu_scaling.width > 0 && cpu_scaling.height > 0) {
+				cpu_scaling.texture = SDL_CreateTexture(sdl_renderer, texture_format, SDL_TEXTUREACCESS_STREAMING,
+					cpu_scaling.width, cpu_scaling.height);
+				if (!cpu_scaling.texture) {
+					Output::Debug("SDL_CreateTexture failed : {}", SDL_GetError());
+				}
+				cpu_scaling.pixels.resize(static_cast<size_t>(cpu_scaling.width) * cpu_scaling.height);
+			}
+		} else if (vcfg.scaling_mode.Get() == ConfigEnum::ScalingMode::Bilinear && window.scale > 0.f) {
 			if (sdl_texture_scaled) {
 				SDL_DestroyTexture(sdl_texture_scaled);
 			}
@@ -690,7 +719,19 @@ void Sdl2Ui::UpdateDisplay() {
 	}
 
 	SDL_RenderClear(sdl_renderer);
-	if (vcfg.scaling_mode.Get() == ConfigEnum::ScalingMode::Bilinear && window.scale > 0.f) {
+	if (cpu_scaling.texture) {
+		const auto* src = static_cast<const uint32_t*>(main_surface->pixels());
+		const int pitch = cpu_scaling.width * sizeof(uint32_t);
+		if (vcfg.scaling_mode.Get() == ConfigEnum::ScalingMode::Bilinear && window.scale > 0.f) {
+			Scaler::Bilinear(src, main_surface->width(), main_surface->height(), main_surface->pitch(),
+				cpu_scaling.pixels.data(), cpu_scaling.width, cpu_scaling.height, pitch, static_cast<int>(ceilf(window.scale)));
+		} else {
+			Scaler::Nearest(src, main_surface->width(), main_surface->height(), main_surface->pitch(),
+				cpu_scaling.pixels.data(), cpu_scaling.width, cpu_scaling.height, pitch);
+		}
+		SDL_UpdateTexture(cpu_scaling.texture, nullptr, cpu_scaling.pixels.data(), pitch);
+		SDL_RenderCopy(sdl_renderer, cpu_scaling.texture, nullptr, nullptr);
+	} else if (vcfg.scaling_mode.Get() == ConfigEnum::ScalingMode::Bilinear && window.scale > 0.f) {
 		// Render game texture on the scaled texture
 		SDL_SetRenderTarget(sdl_renderer, sdl_texture_scaled);
 		SDL_RenderClear(sdl_renderer);
@@ -25,6 +25,7 @@
 #include "system.h"
 
 #include <array>
+#include <vector>
 #include <SDL.h>
 
 extern "C" {
@@ -143,6 +144,15 @@ private:
 		float scale = 0.f;
 	} window = {};
 
+	/** Software renderer: The frame is scaled by Scaler and copied without scaling */
+	struct {
+		bool enabled = false;
+		SDL_Texture* texture = nullptr;
+		int width = 0;
+		int height = 0;
+		std::vector<uint32_t> pixels;
+	} cpu_scaling;
+
 	uint32_t texture_format = SDL_PIXELFORMAT_UNKNOWN;
 
 #ifdef SUPPORT_AUDIO
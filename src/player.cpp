@@ -78,10 +78,14 @@
 #include "scene_settings.h"
 #include "scene_title.h"
 #include "instrumentation.h"
+#include "interpreter_profiler.h"
+#include "battle_simulator.h"
 #include "transition.h"
 #include <lcf/scope_guard.h>
 #include <lcf/log_handler.h>
 #include "baseui.h"
+#include "bitmap.h"
+#include "pixel_format.h"
 #include "game_clock.h"
 #include "message_overlay.h"
 #include "audio_midi.h"
@@ -130,6 +134,8 @@ namespace Player {
 	int frames;
 	std::string replay_input_path;
 	std::string record_input_path;
+	std::string profile_interpreter_path;
+	int simulate_battle_runs = 0;
 	std::string command_line;
 	int speed_modifier_a;
 	int speed_modifier_b;
@@ -194,7 +200,10 @@ void Player::Init(std::vector<std::string> args) {
 
 	DisplayUi.reset();
 
-	if(! DisplayUi) {
+	if (simulate_battle_runs > 0) {
+		// The battle simulation never creates a window
+		Bitmap::SetFormat(Bitmap::ChooseFormat(format_R8G8B8A8_a().format()));
+	} else if(! DisplayUi) {
 		DisplayUi = BaseUi::CreateUi(Player::screen_width, Player::screen_height, cfg);
 	}
 
@@ -207,6 +216,12 @@ void Player::Init(std::vector<std::string> args) {
 }
 
 void Player::Run() {
+	if (simulate_battle_runs > 0) {
+		RunBattleSimulation();
+		Exit();
+		return;
+	}
+
 	Instrumentation::Init("EasyRPG-Player");
 
 	Scene::Push(std::make_shared<Scene_Logo>());
@@ -414,6 +429,13 @@ void Player::Exit() {
 	auto ret = FileFinder::Root().OpenOutputStream("/tmp/message.png", std::ios_base::binary | std::ios_base::out | std::ios_base::trunc);
 	if (ret) Output::TakeScreenshot(ret);
 #endif
+	if (!profile_interpreter_path.empty()) {
+		auto os = FileFinder::Root().OpenOutputStream(profile_interpreter_path, std::ios::out | std::ios::trunc);
+		if (!os || !InterpreterProfiler::WriteCsv(os)) {
+			Output::Warning("Failed to write interpreter profile to {}", profile_interpreter_path);
+		}
+	}
+
 	Player::ResetGameObjects();
 	Font::Dispose();
 	Graphics::Quit();
@@ -617,6 +639,19 @@ Game_Config Player::ParseCommandLine() {
 			}
 			continue;
 		}
+		if (cp.ParseNext(arg, 1, "--simulate-battle")) {
+			if (arg.ParseValue(0, li_value) && li_value > 0) {
+				simulate_battle_runs = li_value;
+			}
+			continue;
+		}
+		if (cp.ParseNext(arg, 1, "--profile-interpreter")) {
+			if (arg.NumValues() > 0) {
+				profile_interpreter_path = arg.Value(0);
+				InterpreterProfiler::SetEnabled(true);
+			}
+			continue;
+		}
 		if (cp.ParseNext(arg, 1, "--encoding")) {
 			if (arg.NumValues() > 0) {
 				forced_encoding = arg.Value(0);
@@ -863,7 +898,9 @@ void Player::UpdateTitle(std::string new_game_title) {
 		Output::Debug("Could not read game title.");
 	}
 	title << GAME_TITLE;
-	DisplayUi->SetTitle(title.str());
+	if (DisplayUi) {
+		DisplayUi->SetTitle(title.str());
+	}
 }
 
 bool Player::ChangeResolution(int width, int height) {
@@ -1303,6 +1340,51 @@ void Player::SetupBattleTest() {
 	Scene::Push(Scene_Battle::Create(std::move(args)), true);
 }
 
+void Player::RunBattleSimulation() {
+	exit_code = EXIT_FAILURE;
+
+	if (!Game_Battle::battle_test.enabled) {
+		Output::Warning("BattleSimulator: --simulate-battle requires --battle-test");
+		return;
+	}
+
+	auto fs = FileFinder::Game();
+	if (!fs) {
+		fs = FileFinder::Root().Create(Main_Data::GetDefaultProjectPath());
+	}
+	if (!fs || !(FileFinder::IsValidProject(fs) || FileFinder::OpenViewToEasyRpgFile(fs))) {
+		Output::Warning("BattleSimulator: {} is not a valid project", Main_Data::GetDefaultProjectPath());
+		return;
+	}
+	FileFinder::SetGameFilesystem(fs);
+	CreateGameObjects();
+
+	if (Player::IsRPG2k3()) {
+		// Only the turn order of the 2k battle system is simulated, the ATB
+		// system of 2k3 would give misleading results
+		Output::Warning("BattleSimulator: The RPG Maker 2003 battle system is not supported");
+		return;
+	}
+
+	const int troop_id = Game_Battle::battle_test.troop_id;
+	if (lcf::ReaderUtil::GetElement(lcf::Data::troops, troop_id) == nullptr) {
+		Output::Warning("BattleSimulator: Invalid Monster Party ID {}", troop_id);
+		return;
+	}
+
+	Main_Data::game_party->SetupBattleTest();
+
+	BattleSimulator::Config config;
+	config.troop_id = troop_id;
+	config.runs = simulate_battle_runs;
+	config.seed = rng_seed < 0 ? static_cast<int32_t>(time(NULL)) : rng_seed;
+
+	const auto results = BattleSimulator::Run(config);
+	BattleSimulator::WriteReport(std::cout, config, BattleSimulator::Summarize(results));
+
+	exit_code = EXIT_SUCCESS;
+}
+
 std::string Player::GetEncoding() {
 	encoding = forced_encoding;
 
@@ -1466,6 +1548,9 @@ Engine options:
                       of the engine.
  --no-patch           Disable all engine patches. To disable a single patch,
                       prefix any of the patch options with --no-
+ --profile-interpreter FILE
+                      Count executed event commands and their time and write
+                      the statistics as CSV to FILE on exit.
  --project-path PATH  Instead of using the working directory, the game in PATH
                       is used.
  --record-input FILE  Record all button inputs to FILE.
@@ -1529,6 +1614,10 @@ Debug options:
                       condition and terrain ID.
  --hide-title         Hide the title background image and center the command
                       menu.
+ --simulate-battle N  In combination with --battle-test run N battles without
+                      a window using auto battle for the party, print the
+                      win rate and turn counts and exit. --seed sets the seed
+                      of the first battle. RPG Maker 2000 battles only.
  --start-map-id N     Overwrite the map used for new games and use MapN.lmu
                       instead (N is padded to four digits).
                       Incompatible with --load-game-id.
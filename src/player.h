@@ -184,6 +184,12 @@ namespace Player {
 	 */
 	void SetupBattleTest();
 
+	/**
+	 * Runs the battles requested by --simulate-battle and prints the results.
+	 * Used by Run instead of the main loop, no window is created.
+	 */
+	void RunBattleSimulation();
+
 	/**
 	 * Moves the player to the start map.
 	 */
@@ -394,6 +400,12 @@ namespace Player {
 	/** Path to record input log to */
 	extern std::string record_input_path;
 
+	/** Path to write the interpreter profile to on exit */
+	extern std::string profile_interpreter_path;
+
+	/** Number of headless battles run instead of the battle test, 0 to show the battle */
+	extern int simulate_battle_runs;
+
 	/** The concatenated command line */
 	extern std::string command_line;
 
@@ -0,0 +1,90 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Headers
+#include <functional>
+#include <iterator>
+#include <list>
+#include <unordered_map>
+
+#include "regex_cache.h"
+
+namespace {
+	/** Amount of patterns before old patterns are evicted */
+	constexpr size_t max_entries = 64;
+
+	struct Key {
+		std::wstring pattern;
+		std::regex_constants::syntax_option_type flags;
+
+		bool operator==(const Key& o) const {
+			return flags == o.flags && pattern == o.pattern;
+		}
+	};
+
+	struct KeyHash {
+		size_t operator()(const Key& key) const {
+			size_t h = std::hash<std::wstring>()(key.pattern);
+			h ^= std::hash<int>()(static_cast<int>(key.flags)) + 0x9e3779b9 + (h << 6) + (h >> 2);
+			return h;
+		}
+	};
+
+	struct Entry {
+		Key key;
+		std::wregex regex;
+	};
+
+	using EntryList = std::list<Entry>;
+
+	/** Most recently used first */
+	EntryList entries;
+	std::unordered_map<Key, EntryList::iterator, KeyHash> entry_index;
+}
+
+const std::wregex& RegexCache::Get(const std::wstring& pattern, std::regex_constants::syntax_option_type flags) {
+	Key key { pattern, flags };
+
+	auto it = entry_index.find(key);
+	if (it != entry_index.end()) {
+		entries.splice(entries.begin(), entries, it->second);
+		return entries.front().regex;
+	}
+
+	// Compile before evicting, an invalid pattern throws and leaves the cache unchanged
+	std::wregex regex(pattern, flags);
+
+	while (entries.size() >= max_entries) {
+		auto last = std::prev(entries.end());
+		entry_index.erase(last->key);
+		entries.erase(last);
+	}
+
+	entries.push_front({ key, std::move(regex) });
+	entry_index.emplace(std::move(key), entries.begin());
+
+	return entries.front().regex;
+}
+
+void RegexCache::Clear() {
+	entry_index.clear();
+	entries.clear();
+}
+
+int RegexCache::GetSize() {
+	return static_cast<int>(entries.size());
+}
@@ -0,0 +1,50 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EP_REGEX_CACHE_H
+#define EP_REGEX_CACHE_H
+
+// Headers
+#include <regex>
+#include <string>
+
+/**
+ * Cache of compiled regular expressions.
+ * Compiling a std::regex is much slower than matching short strings, event
+ * scripts often match or replace with the same pattern in a loop.
+ * Least recently used patterns are evicted when the cache is full.
+ */
+namespace RegexCache {
+	/**
+	 * Returns the compiled pattern, compiles it on a cache miss.
+	 * The returned reference is valid until the next call of Get or Clear.
+	 *
+	 * @param pattern Regular expression
+	 * @param flags Syntax options used for compiling
+	 * @return compiled regex
+	 * @throw std::regex_error when the pattern is invalid, it is not cached
+	 */
+	const std::wregex& Get(const std::wstring& pattern, std::regex_constants::syntax_option_type flags = std::regex_constants::ECMAScript);
+
+	/** Removes all patterns. */
+	void Clear();
+
+	/** @return Amount of cached patterns */
+	int GetSize();
+}
+
+#endif
@@ -0,0 +1,204 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Headers
+#include "scaler.h"
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+namespace {
+	/** Source pixels and weight of pixel b (0 - 256) for one output column or row */
+	struct Tap {
+		int a;
+		int b;
+		uint32_t w;
+	};
+
+	/** Reused buffers, the scalers are only called by the UI thread */
+	std::vector<int> nearest_columns;
+	std::vector<Tap> taps_x;
+	std::vector<Tap> taps_y;
+	std::vector<uint32_t> row_a;
+	std::vector<uint32_t> row_b;
+
+	inline const uint32_t* RowAt(const uint32_t* pixels, int pitch, int y) {
+		return reinterpret_cast<const uint32_t*>(reinterpret_cast<const uint8_t*>(pixels) + static_cast<std::ptrdiff_t>(y) * pitch);
+	}
+
+	inline uint32_t* RowAt(uint32_t* pixels, int pitch, int y) {
+		return reinterpret_cast<uint32_t*>(reinterpret_cast<uint8_t*>(pixels) + static_cast<std::ptrdiff_t>(y) * pitch);
+	}
+
+	/** Source index sampled by the center of output pixel d */
+	inline int NearestIndex(int d, int src_size, int dst_size) {
+		return static_cast<int>((static_cast<int64_t>(2 * d + 1) * src_size) / (2 * static_cast<int64_t>(dst_size)));
+	}
+
+	/**
+	 * Interpolates two pixels, two channels are calculated at once.
+	 * The products of a channel fit into 16 bit because w <= 256.
+	 */
+	inline uint32_t Lerp(uint32_t p0, uint32_t p1, uint32_t w) {
+		const uint32_t iw = 256 - w;
+		const uint32_t rb = (((p0 & 0x00FF00FF) * iw + (p1 & 0x00FF00FF) * w) >> 8) & 0x00FF00FF;
+		const uint32_t ag = (((p0 >> 8) & 0x00FF00FF) * iw + ((p1 >> 8) & 0x00FF00FF) * w) & 0xFF00FF00;
+		return rb | ag;
+	}
+
+	void BuildTaps(std::vector<Tap>& taps, int src_size, int dst_size, int prescale) {
+		taps.resize(dst_size);
+
+		const int64_t virt_size = static_cast<int64_t>(src_size) * prescale;
+		for (int d = 0; d < dst_size; ++d) {
+			// Center of the output pixel in the (prescaled) source in 1/256 pixels
+			int64_t u = (static_cast<int64_t>(2 * d + 1) * virt_size * 256) / (2 * static_cast<int64_t>(dst_size)) - 128;
+			u = std::max<int64_t>(u, 0);
+
+			int64_t i = u >> 8;
+			uint32_t w = static_cast<uint32_t>(u & 0xFF);
+			if (i >= virt_size - 1) {
+				i = virt_size - 1;
+				w = 0;
+			}
+
+			Tap& tap = taps[d];
+			tap.a = static_cast<int>(i / prescale);
+			tap.b = std::min(static_cast<int>((i + 1) / prescale), src_size - 1);
+			tap.w = (tap.a == tap.b) ? 0 : w;
+		}
+	}
+
+	void ScaleRow(const uint32_t* in, uint32_t* out, const std::vector<Tap>& taps) {
+		const Tap* tap = taps.data();
+		const int n = static_cast<int>(taps.size());
+		for (int x = 0; x < n; ++x) {
+			const Tap& t = tap[x];
+			out[x] = (t.w == 0) ? in[t.a] : Lerp(in[t.a], in[t.b], t.w);
+		}
+	}
+}
+
+void Scaler::Nearest(const uint32_t* src, int src_width, int src_height, int src_pitch,
+		uint32_t* dst, int dst_width, int dst_height, int dst_pitch) {
+	if (src_width <= 0 || src_height <= 0 || dst_width <= 0 || dst_height <= 0) {
+		return;
+	}
+
+	const size_t row_bytes = dst_width * sizeof(uint32_t);
+
+	if (dst_width % src_width == 0 && dst_height % src_height == 0) {
+		const int kx = dst_width / src_width;
+		const int ky = dst_height / src_height;
+
+		for (int sy = 0; sy < src_height; ++sy) {
+			const uint32_t* in = RowAt(src, src_pitch, sy);
+			uint32_t* out = RowAt(dst, dst_pitch, sy * ky);
+
+			if (kx == 1) {
+				memcpy(out, in, row_bytes);
+			} else {
+				uint32_t* o = out;
+				for (int sx = 0; sx < src_width; ++sx) {
+					const uint32_t v = in[sx];
+					for (int k = 0; k < kx; ++k) {
+						*o++ = v;
+					}
+				}
+			}
+
+			for (int k = 1; k < ky; ++k) {
+				memcpy(RowAt(dst, dst_pitch, sy * ky + k), out, row_bytes);
+			}
+		}
+		return;
+	}
+
+	nearest_columns.resize(dst_width);
+	for (int dx = 0; dx < dst_width; ++dx) {
+		nearest_columns[dx] = NearestIndex(dx, src_width, dst_width);
+	}
+	const int* columns = nearest_columns.data();
+
+	int last_sy = -1;
+	for (int dy = 0; dy < dst_height; ++dy) {
+		const int sy = NearestIndex(dy, src_height, dst_height);
+		uint32_t* out = RowAt(dst, dst_pitch, dy);
+
+		if (sy == last_sy) {
+			memcpy(out, RowAt(dst, dst_pitch, dy - 1), row_bytes);
+			continue;
+		}
+		last_sy = sy;
+
+		const uint32_t* in = RowAt(src, src_pitch, sy);
+		for (int dx = 0; dx < dst_width; ++dx) {
+			out[dx] = in[columns[dx]];
+		}
+	}
+}
+
+void Scaler::Bilinear(const uint32_t* src, int src_width, int src_height, int src_pitch,
+		uint32_t* dst, int dst_width, int dst_height, int dst_pitch, int prescale) {
+	if (src_width <= 0 || src_height <= 0 || dst_width <= 0 || dst_height <= 0) {
+		return;
+	}
+	assert(prescale >= 1);
+
+	BuildTaps(taps_x, src_width, dst_width, prescale);
+	BuildTaps(taps_y, src_height, dst_height, prescale);
+
+	row_a.resize(dst_width);
+	row_b.resize(dst_width);
+
+	// Horizontally scaled source rows, reused while the output rows stay between them
+	int cached_a = -1;
+	int cached_b = -1;
+
+	for (int dy = 0; dy < dst_height; ++dy) {
+		const Tap& ty = taps_y[dy];
+		uint32_t* out = RowAt(dst, dst_pitch, dy);
+
+		if (ty.a != cached_a) {
+			if (ty.a == cached_b) {
+				std::swap(row_a, row_b);
+				std::swap(cached_a, cached_b);
+			} else {
+				ScaleRow(RowAt(src, src_pitch, ty.a), row_a.data(), taps_x);
+				cached_a = ty.a;
+			}
+		}
+
+		if (ty.w == 0) {
+			memcpy(out, row_a.data(), dst_width * sizeof(uint32_t));
+			continue;
+		}
+
+		if (ty.b != cached_b) {
+			ScaleRow(RowAt(src, src_pitch, ty.b), row_b.data(), taps_x);
+			cached_b = ty.b;
+		}
+
+		const uint32_t* a = row_a.data();
+		const uint32_t* b = row_b.data();
+		for (int x = 0; x < dst_width; ++x) {
+			out[x] = Lerp(a[x], b[x], ty.w);
+		}
+	}
+}
@@ -0,0 +1,66 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EP_SCALER_H
+#define EP_SCALER_H
+
+// Headers
+#include <cstdint>
+
+/**
+ * CPU scalers for the output of the UIs which cannot scale on the GPU.
+ *
+ * All functions work on 32 bit pixels, the channel order does not matter.
+ * Pitches are in bytes. Source and destination must not overlap.
+ */
+namespace Scaler {
+	/**
+	 * Nearest neighbour scaling to any size.
+	 * Whole number ratios are handled by replicating pixels and rows.
+	 *
+	 * @param src source pixels
+	 * @param src_width source width
+	 * @param src_height source height
+	 * @param src_pitch source bytes per row
+	 * @param dst destination pixels
+	 * @param dst_width destination width
+	 * @param dst_height destination height
+	 * @param dst_pitch destination bytes per row
+	 */
+	void Nearest(const uint32_t* src, int src_width, int src_height, int src_pitch,
+		uint32_t* dst, int dst_width, int dst_height, int dst_pitch);
+
+	/**
+	 * Bilinear scaling to any size with 8 bit fixed point weights.
+	 *
+	 * @param src source pixels
+	 * @param src_width source width
+	 * @param src_height source height
+	 * @param src_pitch source bytes per row
+	 * @param dst destination pixels
+	 * @param dst_width destination width
+	 * @param dst_height destination height
+	 * @param dst_pitch destination bytes per row
+	 * @param prescale The source is treated like it was upscaled by this factor
+	 *                 with nearest neighbour first. Values above 1 only blur the
+	 *                 pixel edges (ScalingMode::Bilinear).
+	 */
+	void Bilinear(const uint32_t* src, int src_width, int src_height, int src_pitch,
+		uint32_t* dst, int dst_width, int dst_height, int dst_pitch, int prescale = 1);
+}
+
+#endif
@@ -527,42 +527,6 @@ std::shared_ptr<Scene_Battle> Scene_Battle::Create(const BattleArgs& args)
 	}
 }
 
-void Scene_Battle::PrepareBattleAction(Game_Battler* battler) {
-	if (battler->GetBattleAlgorithm() == nullptr) {
-		return;
-	}
-
-	if (!battler->CanAct()) {
-		if (battler->GetBattleAlgorithm()->GetType() != Game_BattleAlgorithm::Type::None) {
-			battler->SetBattleAlgorithm(std::make_shared<Game_BattleAlgorithm::None>(battler));
-		}
-		return;
-	}
-
-	if (battler->GetSignificantRestriction() == lcf::rpg::State::Restriction_attack_ally) {
-		Game_Battler *target = battler->GetType() == Game_Battler::Type_Enemy ?
-			Main_Data::game_enemyparty->GetRandomActiveBattler() :
-			Main_Data::game_party->GetRandomActiveBattler();
-
-		battler->SetBattleAlgorithm(std::make_shared<Game_BattleAlgorithm::Normal>(battler, target));
-		return;
-	}
-
-	if (battler->GetSignificantRestriction() == lcf::rpg::State::Restriction_attack_enemy) {
-		Game_Battler *target = battler->GetType() == Game_Battler::Type_Ally ?
-			Main_Data::game_enemyparty->GetRandomActiveBattler() :
-			Main_Data::game_party->GetRandomActiveBattler();
-
-		battler->SetBattleAlgorithm(std::make_shared<Game_BattleAlgorithm::Normal>(battler, target));
-		return;
-	}
-
-	// If we can no longer perform the action (no more items, ran out of SP, etc..)
-	if (!battler->GetBattleAlgorithm()->ActionIsPossible()) {
-		battler->SetBattleAlgorithm(std::make_shared<Game_BattleAlgorithm::None>(battler));
-	}
-}
-
 void Scene_Battle::RemoveCurrentAction() {
 	battle_actions.front()->SetBattleAlgorithm(nullptr);
 	battle_actions.pop_front();
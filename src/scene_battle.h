@@ -164,8 +164,6 @@ protected:
 	 */
 	virtual void ActionSelectedCallback(Game_Battler* for_battler);
 
-	void PrepareBattleAction(Game_Battler* battler);
-
 	void RemoveCurrentAction();
 
 	bool CallDebug();
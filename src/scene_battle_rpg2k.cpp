@@ -37,7 +37,6 @@
 #include "scene_gameover.h"
 #include "game_interpreter_battle.h"
 #include "output.h"
-#include "rand.h"
 #include "autobattle.h"
 #include "enemyai.h"
 #include "battle_message.h"
@@ -800,7 +799,7 @@ Scene_Battle_Rpg2k::SceneActionReturn Scene_Battle_Rpg2k::ProcessSceneActionBatt
 		auto* battler = battle_actions.front();
 		// If we will start a new battle action, first check for state changes
 		// such as death, paralyze, confuse, etc..
-		PrepareBattleAction(battler);
+		Game_Battle::PrepareBattleAction(battler);
 		pending_battle_action = battler->GetBattleAlgorithm();
 
 #ifdef EP_DEBUG_BATTLE2K_STATE_MACHINE
@@ -1814,19 +1813,7 @@ void Scene_Battle_Rpg2k::SelectPreviousActor() {
 }
 
 void Scene_Battle_Rpg2k::CreateExecutionOrder() {
-	// Define random Agility. Must be done outside of the sort function because of the "strict weak ordering" property, so the sort is consistent
-	for (auto battler : battle_actions) {
-		int battle_order = battler->GetAgi() + Rand::GetRandomNumber(0, battler->GetAgi() / 4 + 3);
-		if (battler->GetBattleAlgorithm()->GetType() == Game_BattleAlgorithm::Type::Normal && battler->HasPreemptiveAttack()) {
-			// RPG_RT sets this value
-			battle_order += 9999;
-		}
-		battler->SetBattleOrderAgi(battle_order);
-	}
-	std::sort(battle_actions.begin(), battle_actions.end(),
-			[](Game_Battler* l, Game_Battler* r) {
-			return l->GetBattleOrderAgi() > r->GetBattleOrderAgi();
-			});
+	Game_Battle::CreateExecutionOrder(battle_actions);
 
 	for (const auto& battler : battle_actions) {
 		if (std::count(battle_actions.begin(), battle_actions.end(), battler) > 1) {
@@ -1847,13 +1834,7 @@ void Scene_Battle_Rpg2k::CreateEnemyActions() {
 			continue;
 		}
 
-		if (!EnemyAi::SetStateRestrictedAction(*enemy)) {
-			if (enemy->GetEnemyAi() == -1) {
-				enemyai_algos[default_enemyai_algo]->SetEnemyAiAction(*enemy);
-			} else {
-				enemyai_algos[enemy->GetEnemyAi()]->SetEnemyAiAction(*enemy);
-			}
-		}
+		Game_Battle::SelectEnemyAction(*enemy, enemyai_algos, default_enemyai_algo);
 		assert(enemy->GetBattleAlgorithm() != nullptr);
 		ActionSelectedCallback(enemy);
 	}
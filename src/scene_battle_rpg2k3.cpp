@@ -833,13 +833,7 @@ void Scene_Battle_Rpg2k3::CreateEnemyActions() {
 	// FIXME: RPG_RT checks animations and event ready flag?
 	for (auto* enemy: Main_Data::game_enemyparty->GetEnemies()) {
 		if (enemy->IsAtbGaugeFull() && !enemy->GetBattleAlgorithm()) {
-			if (!EnemyAi::SetStateRestrictedAction(*enemy)) {
-				if (enemy->GetEnemyAi() == -1) {
-					enemyai_algos[default_enemyai_algo]->SetEnemyAiAction(*enemy);
-				} else {
-					enemyai_algos[enemy->GetEnemyAi()]->SetEnemyAiAction(*enemy);
-				}
-			}
+			Game_Battle::SelectEnemyAction(*enemy, enemyai_algos, default_enemyai_algo);
 			assert(enemy->GetBattleAlgorithm() != nullptr);
 			ActionSelectedCallback(enemy);
 #ifdef EP_DEBUG_BATTLE2K3_STATE_MACHINE
@@ -1738,7 +1732,7 @@ Scene_Battle_Rpg2k3::SceneActionReturn Scene_Battle_Rpg2k3::ProcessSceneActionBa
 		auto* battler = battle_actions.front();
 		// If we will start a new battle action, first check for state changes
 		// such as death, paralyze, confuse, etc..
-		PrepareBattleAction(battler);
+		Game_Battle::PrepareBattleAction(battler);
 
 		pending_battle_action = battler->GetBattleAlgorithm();
 		SetBattleActionState(BattleActionState_Begin);
@@ -2211,7 +2205,7 @@ Scene_Battle_Rpg2k3::BattleActionReturn Scene_Battle_Rpg2k3::ProcessBattleAction
 	}
 
 	// If the event made the current action ususable, such as MP loss or silence etc..
-	PrepareBattleAction(source);
+	Game_Battle::PrepareBattleAction(source);
 	pending_battle_action = source->GetBattleAlgorithm();
 	action = pending_battle_action.get();
 
@@ -23,6 +23,7 @@
 #include "baseui.h"
 #include "cache.h"
 #include "input.h"
+#include "interpreter_profiler.h"
 #include "game_variables.h"
 #include "game_switches.h"
 #include "game_strings.h"
@@ -306,6 +307,18 @@ void Scene_Debug::PushUiStringView() {
 	stringview_window->Refresh();
 }
 
+void Scene_Debug::PushUiStatisticsView() {
+	Push(eUiStringView);
+
+	var_window->SetActive(false);
+	stringview_window->SetActive(true);
+	stringview_window->SetVisible(true);
+
+	stringview_window->SetDisplayData(GetStatisticsText());
+	stringview_window->SetIndex(0);
+	stringview_window->Refresh();
+}
+
 void Scene_Debug::PushUiInterpreterView() {
 	const bool was_range_list = (GetFrame().uimode == eUiRangeList);
 
@@ -649,6 +662,11 @@ void Scene_Debug::vUpdate() {
 			case eOpenMenu:
 				DoOpenMenu();
 				break;
+			case eStatistics:
+				if (sz == 1) {
+					PushUiStatisticsView();
+				}
+				break;
 		}
 		Game_Map::SetNeedRefresh(true);
 	} else if (range_window->GetActive() && Input::IsRepeated(Input::RIGHT)) {
@@ -733,6 +751,7 @@ void Scene_Debug::UpdateRangeListWindow() {
 				addItem("Strings", Player::IsPatchManiac());
 				addItem("Interpreter");
 				addItem("Open Menu", !is_battle);
+				addItem("Statistics");
 			}
 			break;
 		case eSwitch:
@@ -1185,6 +1204,45 @@ void Scene_Debug::DoCallBattleEvent() {
 	Output::Debug("Debug Scene Forced execution of battle troop {} event page {} on the map foreground interpreter.", troop->ID, page.ID);
 }
 
+std::string Scene_Debug::GetStatisticsText() const {
+	std::string text;
+
+	const auto effects = Cache::GetSpriteEffectStats();
+	const auto lookups = effects.hits + effects.misses;
+	text += "Sprite Effect Cache\n";
+	text += fmt::format("Entries: {}\n", effects.entries);
+	text += fmt::format("Hits: {} Misses: {}\n", effects.hits, effects.misses);
+	text += fmt::format("Hit Rate: {}%\n", lookups > 0 ? effects.hits * 100 / lookups : 0);
+	text += fmt::format("Purged: {}\n", effects.purged);
+
+	text += "\nInterpreter Profile\n";
+	if (!InterpreterProfiler::IsEnabled()) {
+		text += "Disabled (--profile-interpreter)\n";
+		return text;
+	}
+
+	auto to_ms = [](std::chrono::nanoseconds time) {
+		return std::chrono::duration<double, std::milli>(time).count();
+	};
+
+	const auto events = InterpreterProfiler::GetEventEntries();
+	text += "Events:\n";
+	for (size_t i = 0; i < std::min<size_t>(events.size(), 5); ++i) {
+		const auto& entry = events[i];
+		text += fmt::format("{}: {} cmds {:.1f} ms\n", InterpreterProfiler::GetSourceName(entry.source), entry.count, to_ms(entry.time));
+	}
+
+	const auto commands = InterpreterProfiler::GetCommandEntries();
+	text += "Commands:\n";
+	for (size_t i = 0; i < std::min<size_t>(commands.size(), 10); ++i) {
+		const auto& entry = commands[i];
+		text += fmt::format("{} #{} ({}): {}x {:.1f} ms\n", InterpreterProfiler::GetSourceName(entry.source),
+			entry.command_index, entry.code, entry.count, to_ms(entry.time));
+	}
+
+	return text;
+}
+
 void Scene_Debug::DoOpenMenu() {
 	if (Scene::Find(Scene::Menu)) {
 		Scene::PopUntil(Scene::Menu);
@@ -1224,12 +1282,12 @@ void Scene_Debug::CacheBackgroundInterpreterStates() {
 			if (ev.GetTrigger() != lcf::rpg::EventPage::Trigger_parallel || !ev.interpreter)
 				continue;
 			state_interpreter.ev.emplace_back(ev.GetId());
-			state_interpreter.state_ev.emplace_back(ev.interpreter->GetState());
+			state_interpreter.state_ev.emplace_back(ev.interpreter->GetSaveState());
 		}
 		for (auto& ce : Game_Map::GetCommonEvents()) {
 			if (ce.IsWaitingBackgroundExecution(false)) {
 				state_interpreter.ce.emplace_back(ce.common_event_id);
-				state_interpreter.state_ce.emplace_back(ce.interpreter->GetState());
+				state_interpreter.state_ce.emplace_back(ce.interpreter->GetSaveState());
 			}
 		}
 	} else if (Game_Battle::IsBattleRunning() && Player::IsPatchManiac()) {
@@ -1244,7 +1302,7 @@ void Scene_Debug::UpdateInterpreterWindow(int index) {
 	int evt_id = 0;
 
 	if (index == 1) {
-		state = Game_Interpreter::GetForegroundInterpreter().GetState();
+		state = Game_Interpreter::GetForegroundInterpreter().GetSaveState();
 		first_line = Game_Battle::IsBattleRunning() ? "Foreground (Battle)" : "Foreground (Map)";
 		valid = true;
 	} else if (index <= static_cast<int>(state_interpreter.ev.size())) {
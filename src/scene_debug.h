@@ -73,6 +73,7 @@ public:
 		eString,
 		eInterpreter,
 		eOpenMenu,
+		eStatistics,
 		eLastMainMenuOption,
 	};
 
@@ -136,6 +137,9 @@ private:
 	void DoCallBattleEvent();
 	void DoOpenMenu();
 
+	/** @return Performance statistics for the statistics view */
+	std::string GetStatisticsText() const;
+
 	const int choice_window_width = 120;
 
 	/** Displays a range selection for mode. */
@@ -172,6 +176,7 @@ private:
 	void PushUiNumberInput(int init_value, int digits, bool show_operator);
 	void PushUiChoices(std::vector<std::string> choices, std::vector<bool> choices_enabled);
 	void PushUiStringView();
+	void PushUiStatisticsView();
 	void PushUiInterpreterView();
 
 	Window_VarList::Mode GetWindowMode() const;
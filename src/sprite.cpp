@@ -23,6 +23,7 @@
 #include "bitmap.h"
 #include "cache.h"
 #include "drawable_mgr.h"
+#include "sprite_batch.h"
 
 // Constructor
 Sprite::Sprite(Drawable::Flags flags) : Drawable(0, flags)
@@ -41,6 +42,27 @@ void Sprite::BlitScreen(Bitmap& dst) {
 	if (!bitmap || (opacity_top_effect <= 0 && opacity_bottom_effect <= 0))
 		return;
 
+	bool has_effects = tone_effect != Tone() || flash_effect.alpha != 0 || flipx_effect || flipy_effect;
+	bool has_transform = zoom_x_effect != 1.0 || zoom_y_effect != 1.0 || angle_effect != 0.0 || waver_effect_depth != 0;
+
+	// Rebuilding the effect bitmap every frame of a tint fade or a flash is slower
+	// than the fused blit, but a static effect is cheaper to draw from the cache
+	bool effects_animated = tone_effect != last_tone || flash_effect != last_flash ||
+		flipx_effect != last_flip_x || flipy_effect != last_flip_y;
+	last_tone = tone_effect;
+	last_flash = flash_effect;
+	last_flip_x = flipx_effect;
+	last_flip_y = flipy_effect;
+
+	auto* batch = SpriteBatch::GetActive();
+	if (batch && (has_effects || has_transform)) {
+		batch->Flush();
+	}
+
+	if (has_effects && !has_transform && effects_animated && BlitScreenEffects(dst)) {
+		return;
+	}
+
 	BitmapRef draw_bitmap = Refresh(src_rect_effect);
 	if (!draw_bitmap) {
 		return;
@@ -64,6 +86,15 @@ void Sprite::BlitScreen(Bitmap& dst) {
 		}
 	}
 
+	if (batch && !has_effects && !has_transform) {
+		Opacity opacity(opacity_top_effect, opacity_bottom_effect, bush_effect);
+		if (batch->Add(dst, draw_bitmap, x - ox + GetRenderOx(), y - oy + GetRenderOy(), rect,
+				opacity, static_cast<Bitmap::BlendMode>(blend_type_effect))) {
+			return;
+		}
+		batch->Flush();
+	}
+
 	BlitScreenIntern(dst, *draw_bitmap, rect);
 }
 
@@ -78,6 +109,35 @@ void Sprite::BlitScreenIntern(Bitmap& dst, Bitmap const& draw_bitmap, Rect const
 		waver_effect_depth, waver_effect_phase, static_cast<Bitmap::BlendMode>(blend_type_effect));
 }
 
+bool Sprite::BlitScreenEffects(Bitmap& dst) {
+	if (Rect(x - ox, y - oy, GetWidth(), GetHeight()).IsOutOfBounds(Rect(0, 0, Player::screen_width, Player::screen_height))) {
+		return true;
+	}
+
+	src_rect_effect.Adjust(bitmap->GetWidth(), bitmap->GetHeight());
+	if (src_rect_effect.IsEmpty()) {
+		return true;
+	}
+
+	// Same source area as in BlitScreen. Mirroring the whole "sprite rect"
+	// (src_rect_effect) and drawing the mirrored subrect equals mirroring the subrect.
+	Rect rect = src_rect_effect.GetSubRect(src_rect);
+	rect.x = src_rect_effect.x + rect.x % src_rect_effect.width;
+	rect.y = src_rect_effect.y + rect.y % src_rect_effect.height;
+
+	if (!dst.ToneBlendFlipBlit(x - ox + GetRenderOx(), y - oy + GetRenderOy(), *bitmap, rect,
+			tone_effect, flash_effect, flipx_effect, flipy_effect,
+			Opacity(opacity_top_effect, opacity_bottom_effect, bush_effect),
+			static_cast<Bitmap::BlendMode>(blend_type_effect))) {
+		return false;
+	}
+
+	// Outdated while the effects change, rebuilt once they are stable
+	bitmap_effects.reset();
+	bitmap_changed = false;
+	return true;
+}
+
 BitmapRef Sprite::Refresh(Rect& rect) {
 	if (zoom_x_effect == 1.0 && zoom_y_effect == 1.0 && angle_effect == 0.0 && waver_effect_depth == 0) {
 		// Prevent effect sprite creation when not in the viewport
@@ -138,9 +138,24 @@ private:
 	bool current_flip_y = false;
 	bool bitmap_changed = true;
 
+	/** Effects of the previous frame, the fused blit is used while they change */
+	Tone last_tone;
+	Color last_flash;
+	bool last_flip_x = false;
+	bool last_flip_y = false;
+
 	void BlitScreen(Bitmap& dst);
 	void BlitScreenIntern(Bitmap& dst, Bitmap const& draw_bitmap,
 							Rect const& src_rect) const;
+	/**
+	 * Draws tone, flash and flip directly without an effect bitmap.
+	 * Only usable when the sprite is not zoomed, rotated or wavered.
+	 * Used while the effects change every frame, static effects are
+	 * drawn from the cached effect bitmap.
+	 *
+	 * @return false when the fused blit is not supported for the bitmap
+	 */
+	bool BlitScreenEffects(Bitmap& dst);
 	BitmapRef Refresh(Rect& rect);
 };
 
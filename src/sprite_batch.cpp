@@ -0,0 +1,100 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Headers
+#include "sprite_batch.h"
+#include "drawable.h"
+
+namespace {
+	SpriteBatch* active_batch = nullptr;
+}
+
+SpriteBatch::~SpriteBatch() {
+	Flush();
+}
+
+SpriteBatch* SpriteBatch::GetActive() {
+	return active_batch;
+}
+
+void SpriteBatch::Draw(Drawable& drawable, Bitmap& dst) {
+	// Restores the outer batch when lists are drawn recursively
+	auto* previous = active_batch;
+	active_batch = this;
+	drawable.Draw(dst);
+	active_batch = previous;
+}
+
+bool SpriteBatch::Add(Bitmap& dst, BitmapRef const& src, int x, int y, Rect const& src_rect,
+		Opacity const& opacity, Bitmap::BlendMode blend_mode) {
+	// The mask of a split opacity depends on the source rect
+	if (opacity.IsSplit() || !src) {
+		return false;
+	}
+
+	if (opacity.IsTransparent()) {
+		return true;
+	}
+
+	if (!items.empty() && (&dst != this->dst || src != this->src ||
+			opacity.Value() != this->opacity.Value() || blend_mode != this->blend_mode)) {
+		Flush();
+	}
+
+	if (items.empty()) {
+		this->dst = &dst;
+		this->src = src;
+		this->opacity = opacity;
+		this->blend_mode = blend_mode;
+	}
+
+	if (!items.empty()) {
+		// pixman has no composite of multiple rects: Merge blits that continue
+		// the previous one in the source and in the destination
+		auto& last = items.back();
+		const Rect& last_rect = last.src_rect;
+		if (y == last.y && src_rect.y == last_rect.y && src_rect.height == last_rect.height
+				&& x == last.x + last_rect.width && src_rect.x == last_rect.x + last_rect.width) {
+			last.src_rect.width += src_rect.width;
+			return true;
+		}
+		if (x == last.x && src_rect.x == last_rect.x && src_rect.width == last_rect.width
+				&& y == last.y + last_rect.height && src_rect.y == last_rect.y + last_rect.height) {
+			last.src_rect.height += src_rect.height;
+			return true;
+		}
+	}
+
+	items.push_back({ x, y, src_rect });
+	return true;
+}
+
+size_t SpriteBatch::GetSize() const {
+	return items.size();
+}
+
+void SpriteBatch::Flush() {
+	if (items.empty()) {
+		return;
+	}
+
+	dst->BatchBlit(*src, items, opacity, blend_mode);
+
+	items.clear();
+	dst = nullptr;
+	src.reset();
+}
@@ -0,0 +1,88 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EP_SPRITE_BATCH_H
+#define EP_SPRITE_BATCH_H
+
+// Headers
+#include <vector>
+#include "bitmap.h"
+#include "memory_management.h"
+#include "opacity.h"
+
+class Drawable;
+
+/**
+ * Collects consecutive blits with the same source bitmap, opacity and blend
+ * mode and draws them with Bitmap::BatchBlit.
+ * Blits which are adjacent in the source and in the destination are merged
+ * into one composite operation.
+ *
+ * Used by DrawableList::Draw: The batch is only active while a drawable
+ * which reports IsBatchable() draws. The queued blits are drawn before any
+ * other drawable and at the end of the list.
+ */
+class SpriteBatch {
+public:
+	SpriteBatch() = default;
+	SpriteBatch(const SpriteBatch&) = delete;
+	SpriteBatch& operator=(const SpriteBatch&) = delete;
+
+	/** Draws the queued blits */
+	~SpriteBatch();
+
+	/** @return the batch of the drawable which is currently drawing or nullptr */
+	static SpriteBatch* GetActive();
+
+	/**
+	 * Calls Draw of the drawable with this batch active.
+	 *
+	 * @param drawable drawable to draw
+	 * @param dst bitmap to draw onto
+	 */
+	void Draw(Drawable& drawable, Bitmap& dst);
+
+	/**
+	 * Queues a blit. When it does not match the queued blits they are drawn first.
+	 *
+	 * @param dst bitmap to draw onto
+	 * @param src source bitmap, kept alive until the batch is drawn
+	 * @param x destination x position
+	 * @param y destination y position
+	 * @param src_rect source bitmap rect
+	 * @param opacity opacity for blending with bitmap
+	 * @param blend_mode blend mode to use
+	 * @return false when the blit cannot be batched and the caller must draw it
+	 */
+	bool Add(Bitmap& dst, BitmapRef const& src, int x, int y, Rect const& src_rect,
+		Opacity const& opacity, Bitmap::BlendMode blend_mode);
+
+	/** Draws the queued blits */
+	void Flush();
+
+	/** @return Amount of queued blits after merging adjacent ones */
+	size_t GetSize() const;
+
+private:
+	Bitmap* dst = nullptr;
+	BitmapRef src;
+	Opacity opacity;
+	Bitmap::BlendMode blend_mode = Bitmap::BlendMode::Default;
+	std::vector<Bitmap::BatchItem> items;
+};
+
+#endif
@@ -56,6 +56,11 @@ void Sprite_Character::Draw(Bitmap &dst) {
 	Sprite::Draw(dst);
 }
 
+bool Sprite_Character::IsBatchable() const {
+	// Only draws through Sprite::Draw, events sharing a charset are drawn together
+	return true;
+}
+
 void Sprite_Character::Update() {
 	if (tile_id != character->GetTileId() ||
 		character_name != character->GetSpriteName() ||
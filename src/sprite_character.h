@@ -43,6 +43,8 @@ public:
 
 	void Draw(Bitmap& dst) override;
 
+	bool IsBatchable() const override;
+
 	/**
 	 * Updates sprite state.
 	 */
@@ -52,6 +52,7 @@
 #  define SUPPORT_JOYSTICK
 #  define SUPPORT_JOYSTICK_AXIS
 #  define SUPPORT_TOUCH
+#  define SUPPORT_THREADS
 #elif defined(EMSCRIPTEN)
 #  define SUPPORT_MOUSE
 #  define SUPPORT_TOUCH
@@ -82,6 +83,7 @@
 #  define SUPPORT_JOYSTICK
 #  define SUPPORT_JOYSTICK_AXIS
 #  define SUPPORT_FILE_BROWSER
+#  define SUPPORT_THREADS
 #elif defined(__SWITCH__)
 #  define SUPPORT_JOYSTICK
 #  define SUPPORT_JOYSTICK_AXIS
@@ -100,6 +102,7 @@
 #  define SUPPORT_JOYSTICK
 #  define SUPPORT_JOYSTICK_AXIS
 #  define SUPPORT_FILE_BROWSER
+#  define SUPPORT_THREADS
 #  define SYSTEM_DESKTOP_LINUX_BSD_MACOS
 #endif
 
@@ -112,7 +115,7 @@
 #  define JOYSTICK_TRIGGER_SENSIBILITY 0.2
 #endif
 
-#if defined(HAVE_LIBSAMPLERATE) || defined(HAVE_LIBSPEEXDSP)
+#if defined(HAVE_LIBSAMPLERATE) || defined(HAVE_LIBSPEEXDSP) || defined(WANT_BUILTIN_RESAMPLER)
 #  define USE_AUDIO_RESAMPLER
 #endif
 
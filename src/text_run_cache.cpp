@@ -0,0 +1,188 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Headers
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "text_run_cache.h"
+#include "bitmap.h"
+#include "font.h"
+#include "text.h"
+
+namespace {
+	/** Pixels of all cached runs before old runs are evicted */
+	constexpr size_t max_pixels = 512 * 1024;
+	/** Longer texts are not cached, they are usually not redrawn */
+	constexpr size_t max_text_length = 256;
+
+	/**
+	 * The text is a view: For lookups it refers to the argument of Get, in the
+	 * index it refers to the string owned by the entry. Lookups do not allocate.
+	 */
+	struct Key {
+		const Font* font;
+		const Bitmap* system;
+		const Font* exfont;
+		int color;
+		StringView text;
+
+		bool operator==(const Key& o) const {
+			return font == o.font && system == o.system && exfont == o.exfont && color == o.color && text == o.text;
+		}
+	};
+
+	struct KeyHash {
+		size_t operator()(const Key& key) const {
+			size_t h = std::hash<std::string_view>()(std::string_view(key.text.data(), key.text.size()));
+			h ^= std::hash<const void*>()(key.font) + 0x9e3779b9 + (h << 6) + (h >> 2);
+			h ^= std::hash<const void*>()(key.system) + 0x9e3779b9 + (h << 6) + (h >> 2);
+			h ^= std::hash<const void*>()(key.exfont) + 0x9e3779b9 + (h << 6) + (h >> 2);
+			h ^= std::hash<int>()(key.color) + 0x9e3779b9 + (h << 6) + (h >> 2);
+			return h;
+		}
+	};
+
+	struct Entry {
+		/** Storage of key.text */
+		std::string text;
+		Key key;
+		// Detect when a pointer of the key belongs to a new object at the same address
+		std::weak_ptr<Font> font;
+		std::weak_ptr<Bitmap> system;
+		std::weak_ptr<Font> exfont;
+		TextRunCache::Run run;
+		size_t pixels = 0;
+
+		bool IsValid() const {
+			return !font.expired() && !system.expired() && !exfont.expired();
+		}
+	};
+
+	using EntryList = std::list<Entry>;
+
+	/** Most recently used first */
+	EntryList entries;
+	std::unordered_map<Key, EntryList::iterator, KeyHash> entry_index;
+	size_t total_pixels = 0;
+
+	/** Bounding box of the pixels that are not fully transparent */
+	Rect GetVisibleBounds(const Bitmap& bmp) {
+		if (bmp.bpp() != 4) {
+			return bmp.GetRect();
+		}
+
+		int x0 = bmp.width(), y0 = bmp.height(), x1 = -1, y1 = -1;
+		auto* row = static_cast<const uint8_t*>(bmp.pixels());
+		for (int y = 0; y < bmp.height(); ++y, row += bmp.pitch()) {
+			auto* px = reinterpret_cast<const uint32_t*>(row);
+			for (int x = 0; x < bmp.width(); ++x) {
+				// Premultiplied: a transparent pixel is 0
+				if (px[x] != 0) {
+					x0 = std::min(x0, x);
+					x1 = std::max(x1, x);
+					y0 = std::min(y0, y);
+					y1 = y;
+				}
+			}
+		}
+
+		if (x1 < 0) {
+			return {};
+		}
+		return { x0, y0, x1 - x0 + 1, y1 - y0 + 1 };
+	}
+
+	TextRunCache::Run Render(const Font& font, const Bitmap& system, int color, StringView text) {
+		TextRunCache::Run run;
+
+		Rect size = Text::GetSize(font, text);
+		run.width = size.width;
+
+		// Glyphs can be drawn outside of the text size (offsets, shadow), add a margin
+		const int pad = size.height + 1;
+		auto canvas = Bitmap::Create(size.width + 1 + pad * 2, size.height + 1 + pad * 2, true);
+		run.advance = Text::Draw(*canvas, pad, pad, font, system, color, text);
+
+		Rect bounds = GetVisibleBounds(*canvas);
+		if (bounds.width > 0 && bounds.height > 0) {
+			run.bitmap = Bitmap::Create(bounds.width, bounds.height, true);
+			run.bitmap->Blit(0, 0, *canvas, bounds, Opacity::Opaque());
+			run.offset = { bounds.x - pad, bounds.y - pad };
+		}
+
+		return run;
+	}
+
+	void Erase(EntryList::iterator it) {
+		total_pixels -= it->pixels;
+		entry_index.erase(it->key);
+		entries.erase(it);
+	}
+}
+
+const TextRunCache::Run* TextRunCache::Get(const FontRef& font, const BitmapRef& system, int color, StringView text) {
+	if (text.empty() || text.size() > max_text_length || font->IsStyleApplied()) {
+		return nullptr;
+	}
+
+	const auto& exfont = Font::exfont;
+	const Key key { font.get(), system.get(), exfont.get(), color, text };
+
+	auto it = entry_index.find(key);
+	if (it != entry_index.end()) {
+		if (it->second->IsValid()) {
+			entries.splice(entries.begin(), entries, it->second);
+			return &entries.front().run;
+		}
+		Erase(it->second);
+	}
+
+	Run run = Render(*font, *system, color, text);
+	const size_t pixels = run.bitmap ? run.bitmap->width() * run.bitmap->height() : 0;
+
+	total_pixels += pixels;
+	while (!entries.empty() && total_pixels > max_pixels) {
+		Erase(std::prev(entries.end()));
+	}
+
+	// Constructed in place: The key refers to the text of the list node
+	auto& entry = entries.emplace_front();
+	entry.text = ToString(text);
+	entry.key = key;
+	entry.key.text = entry.text;
+	entry.font = font;
+	entry.system = system;
+	entry.exfont = exfont;
+	entry.run = std::move(run);
+	entry.pixels = pixels;
+	entry_index.emplace(entry.key, entries.begin());
+
+	return &entry.run;
+}
+
+void TextRunCache::Clear() {
+	entry_index.clear();
+	entries.clear();
+	total_pixels = 0;
+}
@@ -0,0 +1,62 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EP_TEXT_RUN_CACHE_H
+#define EP_TEXT_RUN_CACHE_H
+
+// Headers
+#include "memory_management.h"
+#include "point.h"
+#include "string_view.h"
+
+/**
+ * Cache of rendered text runs.
+ * A run is a string drawn with a font and a system color. It is rendered
+ * once into a tightly cropped bitmap that is blitted on later draws, this
+ * avoids shaping and rasterizing the glyphs of window texts on every refresh.
+ * Least recently used runs are evicted when the cache is full.
+ */
+namespace TextRunCache {
+	/** A rendered text run */
+	struct Run {
+		/** Rendered text or nullptr when no pixel is visible */
+		BitmapRef bitmap;
+		/** Position of the bitmap relative to the drawing position */
+		Point offset;
+		/** Return value of Text::Draw */
+		Point advance;
+		/** Width of the text used for alignment (Text::GetSize) */
+		int width = 0;
+	};
+
+	/**
+	 * Returns the run of the text, renders it on a cache miss.
+	 * The returned pointer is valid until the next call of Get or Clear.
+	 *
+	 * @param font Font to render with
+	 * @param system System graphic providing the color
+	 * @param color System color index
+	 * @param text Text to render
+	 * @return run or nullptr when the text cannot be cached
+	 */
+	const Run* Get(const FontRef& font, const BitmapRef& system, int color, StringView text);
+
+	/** Removes all runs. */
+	void Clear();
+}
+
+#endif
@@ -20,6 +20,8 @@
 #include <vector>
 #include <array>
 #include <cmath>
+#include <cstring>
+#include <limits>
 
 #include "player.h"
 #include "transition.h"
@@ -36,6 +38,7 @@
 #include "drawable_mgr.h"
 #include "output.h"
 #include "rand.h"
+#include "span.h"
 
 int Transition::GetDefaultFrames(Transition::Type type)
 {
@@ -128,16 +131,16 @@ void Transition::SetAttributesTransitions() {
 		random_blocks[i] = i;
 	}
 
+	select_map.clear();
+	select_lut.clear();
+	block_ranks.clear();
+
 	switch (transition_type) {
 	case TransitionRandomBlocks:
-		random_block_transition = Bitmap::Create(Player::screen_width, Player::screen_height, true);
-		current_blocks_print = 0;
 		std::shuffle(random_blocks.begin(), random_blocks.end(), Rand::GetRNG());
 		break;
 	case TransitionRandomBlocksDown:
 	case TransitionRandomBlocksUp:
-		random_block_transition = Bitmap::Create(Player::screen_width, Player::screen_height, true);
-		current_blocks_print = 0;
 		if (transition_type == TransitionRandomBlocksUp) { std::reverse(random_blocks.begin(), random_blocks.end()); }
 
 		w = Player::screen_width / 4;
@@ -172,6 +175,154 @@ void Transition::SetAttributesTransitions() {
 		// do nothing, keep the compiler happy
 		break;
 	}
+
+	PrecomputeSelectMaps();
+}
+
+void Transition::PrecomputeSelectMaps() {
+	const int w = Player::screen_width;
+	const int h = Player::screen_height;
+
+	switch (transition_type) {
+	case TransitionRandomBlocks:
+	case TransitionRandomBlocksDown:
+	case TransitionRandomBlocksUp: {
+		// Cell of every block and the position in the reveal order.
+		// Cells without a block keep showing screen1.
+		const int block_cols = w / size_random_blocks;
+		select_cell_w = size_random_blocks;
+		select_cell_h = size_random_blocks;
+		const int map_w = (w + select_cell_w - 1) / select_cell_w;
+		const int map_h = (h + select_cell_h - 1) / select_cell_h;
+
+		block_ranks.assign(map_w * map_h, std::numeric_limits<uint32_t>::max());
+		for (uint32_t i = 0; i < random_blocks.size(); ++i) {
+			const int col = random_blocks[i] % block_cols;
+			const int row = random_blocks[i] / block_cols;
+			if (row < map_h) {
+				block_ranks[row * map_w + col] = i;
+			}
+		}
+		select_map.resize(block_ranks.size());
+		break;
+	}
+	case TransitionBlindOpen:
+	case TransitionBlindClose:
+	case TransitionVerticalStripesIn:
+	case TransitionVerticalStripesOut:
+	case TransitionHorizontalStripesIn:
+	case TransitionHorizontalStripesOut: {
+		// The source of every row (or column) for every percentage.
+		// Same geometry as the blits RPG_RT does, rows that are not covered keep the screen.
+		const bool columns = (transition_type == TransitionHorizontalStripesIn || transition_type == TransitionHorizontalStripesOut);
+		const int lines = columns ? w : h;
+		select_cell_w = columns ? 1 : w;
+		select_cell_h = columns ? h : 1;
+
+		select_lut.assign(101 * lines, 0);
+		for (int percentage = 0; percentage <= 100; ++percentage) {
+			uint8_t* lut = &select_lut[percentage * lines];
+			auto fill = [&](int pos, int len, uint8_t src) {
+				const int begin = std::max(0, pos);
+				const int end = std::min(lines, pos + len);
+				if (begin < end) {
+					std::fill(lut + begin, lut + end, src);
+				}
+			};
+
+			switch (transition_type) {
+			case TransitionBlindOpen:
+				for (int i = 0; i < h / 8; i++) {
+					fill(i * 8, 8 - 8 * percentage / 100, 1);
+					fill(i * 8 + 8 - 8 * percentage / 100, 8 * percentage / 100, 2);
+				}
+				break;
+			case TransitionBlindClose:
+				for (int i = 0; i < h / 8; i++) {
+					fill(i * 8 + 8 * percentage / 100, 8 - 8 * percentage / 100, 1);
+					fill(i * 8, 8 * percentage / 100, 2);
+				}
+				break;
+			case TransitionVerticalStripesIn:
+			case TransitionVerticalStripesOut:
+				for (int i = 0; i < h / 6 + 1 - h / 6 * percentage / 100; i++) {
+					fill(i * 6 + 3, 3, 1);
+					fill(h - i * 6, 3, 1);
+				}
+				for (int i = 0; i < h / 6 * percentage / 100; i++) {
+					fill(i * 6, 3, 2);
+					fill(h - 3 - i * 6, 3, 2);
+				}
+				break;
+			default:
+				for (int i = 0; i < w / 8 + 1 - w / 8 * percentage / 100; i++) {
+					fill(i * 8 + 4, 4, 1);
+					fill(w - i * 8, 4, 1);
+				}
+				for (int i = 0; i < w / 8 * percentage / 100; i++) {
+					fill(i * 8, 4, 2);
+					fill(w - 4 - i * 8, 4, 2);
+				}
+				break;
+			}
+		}
+		break;
+	}
+	default:
+		break;
+	}
+}
+
+namespace {
+	/** Row buffer of the mosaic effect */
+	std::vector<uint32_t> mosaic_row;
+}
+
+void Transition::DrawMosaic(Bitmap& dst, const Bitmap& screen, int m_size) {
+	const int w = dst.GetWidth();
+	const int h = dst.GetHeight();
+	// The grid is centered, cells at the border are partially visible
+	const int off_x = ((m_size - w % m_size) % m_size) / 2;
+	const int off_y = ((m_size - h % m_size) % m_size) / 2;
+
+	auto sample = [&](int i, int j) {
+		// The first row and column sample the opposite corner of the cell
+		const int sx = i + (i == 0 ? m_size - 1 : 0);
+		const int sy = j + (j == 0 ? m_size - 1 : 0);
+		return reinterpret_cast<const uint32_t*>(static_cast<const uint8_t*>(screen.pixels()) + sy * screen.pitch())[sx];
+	};
+
+	if (dst.bpp() != 4 || screen.bpp() != 4) {
+		uint8_t m_r, m_g, m_b, m_a;
+		for (int i = 0; i < w; i += m_size) {
+			for (int j = 0; j < h; j += m_size) {
+				dst.pixel_format.uint32_to_rgba(sample(i, j), m_r, m_g, m_b, m_a);
+				dst.FillRect(Rect(i - off_x, j - off_y, m_size, m_size), Color(m_r, m_g, m_b, m_a));
+			}
+		}
+		return;
+	}
+
+	// Sample one row of cells and write the rows of the cells directly
+	const uint32_t alpha_fill = dst.GetTransparent() ? (0xFFu << Bitmap::pixel_format.a.shift) : 0;
+	mosaic_row.resize(w);
+
+	for (int j = 0; j < h; j += m_size) {
+		for (int i = 0; i < w; i += m_size) {
+			const int x0 = std::max(0, i - off_x);
+			const int x1 = std::min(w, i - off_x + m_size);
+			if (x0 < x1) {
+				std::fill(mosaic_row.begin() + x0, mosaic_row.begin() + x1, sample(i, j) | alpha_fill);
+			}
+		}
+
+		const int y0 = std::max(0, j - off_y);
+		const int y1 = std::min(h, j - off_y + m_size);
+		for (int y = y0; y < y1; ++y) {
+			auto* dst_row = reinterpret_cast<uint32_t*>(static_cast<uint8_t*>(dst.pixels()) + y * dst.pitch());
+			memcpy(dst_row, mosaic_row.data(), w * sizeof(uint32_t));
+		}
+	}
 }
 
 void Transition::Draw(Bitmap& dst) {
@@ -180,8 +331,7 @@ void Transition::Draw(Bitmap& dst) {
 
 	std::vector<int> z_pos(2), z_size(2), z_length(2);
 	int z_min, z_max, z_percent, z_fixed_pos, z_fixed_size;
-	uint8_t m_r, m_g, m_b, m_a;
-	uint32_t *m_pointer, blocks_to_print;
+	uint32_t blocks_to_print;
 	int m_size;
 
 	BitmapRef screen_pointer1, screen_pointer2;
@@ -207,48 +357,20 @@ void Transition::Draw(Bitmap& dst) {
 	case TransitionRandomBlocksUp:
 		blocks_to_print = random_blocks.size() * percentage / 100;
 
-		for (uint32_t i = current_blocks_print; i < blocks_to_print; i++) {
-			random_block_transition->Blit(random_blocks[i] % (w / size_random_blocks) * size_random_blocks,
-				random_blocks[i] / (w / size_random_blocks) * size_random_blocks, *screen2,
-				Rect(random_blocks[i] % (w / size_random_blocks) * size_random_blocks, random_blocks[i] / (w / size_random_blocks) * size_random_blocks,
-					size_random_blocks, size_random_blocks), Opacity::Opaque());
+		for (size_t i = 0; i < block_ranks.size(); i++) {
+			select_map[i] = (block_ranks[i] < blocks_to_print) ? 2 : 1;
 		}
-		dst.Blit(0, 0, *screen1, screen1->GetRect(), Opacity::Opaque());
-		dst.Blit(0, 0, *random_block_transition, random_block_transition->GetRect(), Opacity::Opaque());
-		current_blocks_print = blocks_to_print;
+		dst.SelectBlit(*screen1, *screen2, select_map, select_cell_w, select_cell_h);
 		break;
 	case TransitionBlindOpen:
-		for (int i = 0; i < h / 8; i++) {
-			dst.Blit(0, i * 8, *screen1, Rect(0, i * 8, w, 8 - 8 * percentage / 100), 255);
-			dst.Blit(0, i * 8 + 8 - 8 * percentage / 100, *screen2, Rect(0, i * 8 + 8 - 8 * percentage / 100, w, 8 * percentage / 100), 255);
-		}
-		break;
 	case TransitionBlindClose:
-		for (int i = 0; i < h / 8; i++) {
-			dst.Blit(0, i * 8 + 8 * percentage / 100, *screen1, Rect(0, i * 8 + 8 * percentage / 100, w, 8 - 8 * percentage / 100), 255);
-			dst.Blit(0, i * 8, *screen2, Rect(0, i * 8, w, 8 * percentage / 100), 255);
-		}
-		break;
 	case TransitionVerticalStripesIn:
 	case TransitionVerticalStripesOut:
-		for (int i = 0; i < h / 6 + 1 - h / 6 * percentage / 100; i++) {
-			dst.Blit(0, i * 6 + 3, *screen1, Rect(0, i * 6 + 3, w, 3), 255);
-			dst.Blit(0, h - i * 6, *screen1, Rect(0, h - i * 6, w, 3), 255);
-		}
-		for (int i = 0; i < h / 6 * percentage / 100; i++) {
-			dst.Blit(0, i * 6, *screen2, Rect(0, i * 6, w, 3), 255);
-			dst.Blit(0, h - 3 - i * 6, *screen2, Rect(0, h - 3 - i * 6, w, 3), 255);
-		}
-		break;
 	case TransitionHorizontalStripesIn:
 	case TransitionHorizontalStripesOut:
-		for (int i = 0; i < w / 8 + 1 - w / 8 * percentage / 100; i++) {
-			dst.Blit(i * 8 + 4, 0, *screen1, Rect(i * 8 + 4, 0, 4, h), 255);
-			dst.Blit(w - i * 8, 0, *screen1, Rect(w - i * 8, 0, 4, h), 255);
-		}
-		for (int i = 0; i < w / 8 * percentage / 100; i++) {
-			dst.Blit(i * 8, 0, *screen2, Rect(i * 8, 0, 4, h), 255);
-			dst.Blit(w - 4 - i * 8, 0, *screen2, Rect(w - 4 - i * 8, 0, 4, h), 255);
+		{
+			const int lines = static_cast<int>(select_lut.size()) / 101;
+			dst.SelectBlit(*screen1, *screen2, Span<const uint8_t>(&select_lut[percentage * lines], lines), select_cell_w, select_cell_h);
 		}
 		break;
 	case TransitionBorderToCenterIn:
@@ -357,13 +479,7 @@ void Transition::Draw(Bitmap& dst) {
 
 		m_size = (percentage + 1) * 4 / 10;
 		if (m_size > 1)
-			for (int i = 0; i < w; i += m_size)
-				for (int j = 0; j < h; j += m_size) {
-					m_pointer = static_cast<uint32_t *>(screen_pointer1->pixels()) + j * w + i;
-					m_pointer += ((i == 0 ? 1 : 0) + (j == 0 ? w : 0)) * (m_size - 1);
-					dst.pixel_format.uint32_to_rgba(*m_pointer, m_r, m_g, m_b, m_a);
-					dst.FillRect(Rect(i - ((m_size - w % m_size) % m_size) / 2, j - ((m_size - h % m_size) % m_size) / 2, m_size, m_size), Color(m_r, m_g, m_b, m_a));
-				}
+			DrawMosaic(dst, *screen_pointer1, m_size);
 		else
 			dst.Blit(0, 0, *screen_pointer1, screen_pointer1->GetRect(), 255);
 		break;
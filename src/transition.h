@@ -87,6 +87,15 @@ public:
 	/** @return the transition singleton */
 	static Transition& instance();
 
+	/**
+	 * Draws the screen as a centered grid of single colored cells.
+	 *
+	 * @param dst bitmap to draw onto
+	 * @param screen screen to sample, at least the size of dst
+	 * @param m_size cell size
+	 */
+	static void DrawMosaic(Bitmap& dst, const Bitmap& screen, int m_size);
+
 	/**
 	 * Initiate a ShowScreen transition
 	 *
@@ -124,7 +133,6 @@ private:
 
 	BitmapRef screen1;
 	BitmapRef screen2;
-	BitmapRef random_block_transition;
 
 	Type transition_type = TransitionNone;
 	Scene *scene = nullptr;
@@ -148,9 +156,19 @@ private:
 
 	std::vector<int> zoom_position;
 	std::vector<uint32_t> random_blocks;
-	uint32_t current_blocks_print;
+
+	/** Random blocks: Position of each map cell in the reveal order */
+	std::vector<uint32_t> block_ranks;
+	/** Blinds and stripes: Source map of every percentage (0 to 100) */
+	std::vector<uint8_t> select_lut;
+	/** Source map of the current frame, see Bitmap::SelectBlit */
+	std::vector<uint8_t> select_map;
+	int select_cell_w = 1;
+	int select_cell_h = 1;
 
 	void SetAttributesTransitions();
+	/** Precomputes the source maps of the transitions that only select between the screens */
+	void PrecomputeSelectMaps();
 };
 
 inline Transition& Transition::instance() {
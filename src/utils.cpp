@@ -93,6 +93,13 @@ int Utils::StrICmp(StringView l, StringView r) {
 	return l.size() - r.size();
 }
 
+size_t Utils::StrIFind(StringView str, StringView search) {
+	auto it = std::search(str.begin(), str.end(), search.begin(), search.end(), [](char l, char r) {
+		return Lower(l) == Lower(r);
+	});
+	return it == str.end() && !search.empty() ? std::string::npos : static_cast<size_t>(it - str.begin());
+}
+
 std::u16string Utils::DecodeUTF16(StringView str) {
 	std::u16string result;
 	for (auto it = str.begin(), str_end = str.end(); it < str_end; ++it) {
@@ -84,6 +84,16 @@ namespace Utils {
 	 */
 	int StrICmp(StringView l, StringView r);
 
+	/**
+	 * Case insensitive (ascii only) search of a substring.
+	 *
+	 * @param str string to search in
+	 * @param search string to search for
+	 *
+	 * @return position of the first match or std::string::npos
+	 */
+	size_t StrIFind(StringView str, StringView search);
+
 	/**
 	 * Converts Utf8 to UTF-16.
 	 *
@@ -28,6 +28,8 @@
 #include "player.h"
 #include "output.h"
 #include "rand.h"
+#include "options.h"
+#include "span.h"
 
 Weather::Weather() :
 	Drawable(Priority_Weather, Drawable::Flags::Shared)
@@ -119,17 +121,27 @@ static constexpr int fog_opacity[2][4] = {
 };
 
 
+/**
+ * The particle counts of RPG_RT are for a 320x240 screen.
+ * Larger screens get more particles to keep the same density.
+ */
+static int ScaleNumParticles(int num) {
+	const int64_t area = static_cast<int64_t>(Player::screen_width) * Player::screen_height;
+	const int64_t target_area = SCREEN_TARGET_WIDTH * SCREEN_TARGET_HEIGHT;
+	return std::max<int>(num, num * area / target_area);
+}
+
 int Weather::GetMaxNumParticles(int weather_type) {
 	switch (weather_type) {
 		case Game_Screen::Weather_None:
 			return 0;
 		case Game_Screen::Weather_Rain:
 		case Game_Screen::Weather_Snow:
-			return num_rain_or_snow_particles[num_strength - 1];
+			return ScaleNumParticles(num_rain_or_snow_particles[num_strength - 1]);
 		case Game_Screen::Weather_Fog:
 			return num_fog_particles;
 		case Game_Screen::Weather_Sandstorm:
-			return num_sand_particles[num_strength - 1];
+			return ScaleNumParticles(num_sand_particles[num_strength - 1]);
 	}
 	return 0;
 }
@@ -201,25 +213,25 @@ void Weather::DrawParticles(Bitmap& dst, const Bitmap& particle, const Rect rect
 	const auto strength = Main_Data::game_screen->GetWeatherStrength();
 	const auto& particles = Main_Data::game_screen->GetParticles();
 
-	const int num_particles = num_rain_or_snow_particles[Utils::Clamp(strength, 0, num_strength - 1)];
+	const int num_particles = std::min(
+			ScaleNumParticles(num_rain_or_snow_particles[Utils::Clamp(strength, 0, num_strength - 1)]),
+			particles.size());
 	const auto ainc = abase + strength;
 
 	auto surface_rect = weather_surface->GetRect();
 	weather_surface->Clear();
 
-	assert(num_particles <= static_cast<int>(particles.size()));
-
+	particle_opacities.resize(num_particles);
 	for (int i = 0; i < num_particles; ++i) {
-		auto& p = particles[i];
-		if (p.t > tmax) {
-			continue;
-		}
-
-		auto alpha = std::min(ainc * p.t, 255);
-
-		weather_surface->EdgeMirrorBlit(p.x, p.y, *bitmap, rect, true, true, alpha);
+		const int t = particles.t[i];
+		particle_opacities[i] = (t > tmax) ? 0 : std::min(ainc * t, 255);
 	}
 
+	weather_surface->ParticleBlit(*bitmap, rect, 1,
+			Span<const int16_t>(particles.x.data(), num_particles),
+			Span<const int16_t>(particles.y.data(), num_particles),
+			particle_opacities, true);
+
 	const auto shake_x = Main_Data::game_screen->GetShakeOffsetX();
 	const auto shake_y = Main_Data::game_screen->GetShakeOffsetY();
 	auto pan_rect = Main_Data::game_screen->GetScreenEffectsRect();
@@ -272,23 +284,20 @@ void Weather::DrawSandParticles(Bitmap& dst, const Bitmap& particle_bitmap) {
 
 	auto* bitmap = ApplyToneEffect(particle_bitmap, particle_bitmap.GetRect());
 
-	const int num_particles = num_sand_particles[Utils::Clamp(strength, 0, num_strength - 1)];
-
-	assert(num_particles <= static_cast<int>(particles.size()));
+	const int num_particles = std::min(
+			ScaleNumParticles(num_sand_particles[Utils::Clamp(strength, 0, num_strength - 1)]),
+			particles.size());
 
+	particle_opacities.resize(num_particles);
 	for (int i = 0; i < num_particles; ++i) {
-		auto& p = particles[i];
-		const int color = (i % num_sand_colors);
-
-		auto rect = Rect{
-			0,
-			color * sand_particle_rect.height,
-			sand_particle_rect.width,
-			sand_particle_rect.height
-		};
-
-		dst.Blit(p.x, p.y, *bitmap, rect, p.alpha);
+		particle_opacities[i] = Utils::Clamp<int>(particles.alpha[i], 0, 255);
 	}
+
+	// Each particle uses the color i % num_sand_colors
+	dst.ParticleBlit(*bitmap, sand_particle_rect, num_sand_colors,
+			Span<const int16_t>(particles.x.data(), num_particles),
+			Span<const int16_t>(particles.y.data(), num_particles),
+			particle_opacities, false);
 }
 
 void Weather::CreateFogOverlay() {
@@ -335,8 +344,8 @@ void Weather::DrawFogOverlay(Bitmap& dst, const Bitmap& overlay) {
 	// RPG_RT uses the first 2 particles for fog layer graphics
 	const auto& particles = Main_Data::game_screen->GetParticles();
 	assert(particles.size() >= num_fog_particles);
-	const auto fog_bg_frames = particles[0].x;
-	const auto fog_fg_frames = particles[1].x;
+	const auto fog_bg_frames = particles.x[0];
+	const auto fog_fg_frames = particles.x[1];
 
 	// Front layer moves left one pixel every 8 frames.
 	const int fx = shake_x + (fog_fg_frames / 8) % sr.width;
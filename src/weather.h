@@ -19,7 +19,9 @@
 #define EP_WEATHER_H
 
 // Headers
+#include <cstdint>
 #include <string>
+#include <vector>
 #include "drawable.h"
 #include "system.h"
 #include "tone.h"
@@ -67,6 +69,9 @@ private:
 
 	BitmapRef weather_surface;
 
+	/** Opacity of each particle of the current frame */
+	std::vector<uint8_t> particle_opacities;
+
 	Tone tone_effect;
 
 	bool tone_dirty = true;
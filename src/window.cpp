@@ -16,7 +16,9 @@
  */
 
 // Headers
+#include <algorithm>
 #include <cmath>
+#include <vector>
 #include "system.h"
 #include "player.h"
 #include "rect.h"
@@ -62,7 +64,9 @@ void Window::Draw(Bitmap& dst) {
 	if (x < -width || x > dst.GetWidth() || y < -height || y > dst.GetHeight()) return;
 
 	if (windowskin) {
-		if (width > 4 && height > 4 && (back_opacity * opacity / 255 > 0)) {
+		const bool composed = DrawSkinComposite(dst);
+
+		if (!composed && width > 4 && height > 4 && (back_opacity * opacity / 255 > 0)) {
 			if (background_needs_refresh) RefreshBackground();
 
 			if (animation_frames > 0) {
@@ -76,7 +80,7 @@ void Window::Draw(Bitmap& dst) {
 			}
 		}
 
-		if (width > 0 && height > 0 && opacity > 0) {
+		if (!composed && width > 0 && height > 0 && opacity > 0) {
 			if (frame_needs_refresh) RefreshFrame();
 
 			int fopacity = frame_opacity * opacity / 255;
@@ -175,6 +179,82 @@ void Window::Draw(Bitmap& dst) {
 	}
 }
 
+bool Window::SkinKey::operator==(const SkinKey& other) const {
+	return windowskin == other.windowskin && width == other.width && height == other.height &&
+		stretch == other.stretch && background_alpha == other.background_alpha &&
+		back_opacity == other.back_opacity && frame_opacity == other.frame_opacity;
+}
+
+bool Window::DrawSkinComposite(Bitmap& dst) {
+	// Drawing the composite with an opacity blends the overlap of frame and
+	// background differently than drawing both parts with that opacity
+	if (opacity < 255 || animation_frames > 0 || width <= 4 || height <= 4) {
+		return false;
+	}
+
+	SkinKey key;
+	key.windowskin = windowskin.get();
+	key.width = width;
+	key.height = height;
+	key.stretch = stretch;
+	key.background_alpha = background_alpha;
+	key.back_opacity = back_opacity;
+	key.frame_opacity = frame_opacity;
+
+	if (!skin_composite || !(key == skin_composite_key)) {
+		RefreshSkinComposite(key);
+	}
+
+	dst.Blit(x, y, *skin_composite, skin_composite->GetRect(), Opacity::Opaque());
+	return true;
+}
+
+void Window::RefreshSkinComposite(const SkinKey& key) {
+	struct CacheEntry {
+		SkinKey key;
+		std::weak_ptr<Bitmap> windowskin;
+		std::weak_ptr<Bitmap> composite;
+	};
+	// Menus stack several windows with the same size and skin
+	static std::vector<CacheEntry> cache;
+
+	skin_composite_key = key;
+	skin_composite.reset();
+
+	cache.erase(std::remove_if(cache.begin(), cache.end(), [](const CacheEntry& entry) {
+		return entry.composite.expired() || entry.windowskin.expired();
+	}), cache.end());
+
+	for (const auto& entry: cache) {
+		// The skin is compared by owner, the address alone could be reused
+		if (entry.key == key && !entry.windowskin.owner_before(windowskin) && !windowskin.owner_before(entry.windowskin)) {
+			skin_composite = entry.composite.lock();
+			return;
+		}
+	}
+
+	if (background_needs_refresh) RefreshBackground();
+	if (frame_needs_refresh) RefreshFrame();
+
+	BitmapRef bitmap = Bitmap::Create(width, height, true);
+	bitmap->Clear();
+
+	bitmap->Blit(0, 0, *background, background->GetRect(), back_opacity);
+	bitmap->Blit(0, 0, *frame_up, frame_up->GetRect(), frame_opacity);
+	bitmap->Blit(0, height - 8, *frame_down, frame_down->GetRect(), frame_opacity);
+
+	if (frame_left) {
+		bitmap->Blit(0, 8, *frame_left, frame_left->GetRect(), frame_opacity);
+	}
+
+	if (frame_right) {
+		bitmap->Blit(width - 8, 8, *frame_right, frame_right->GetRect(), frame_opacity);
+	}
+
+	skin_composite = bitmap;
+	cache.push_back({ key, windowskin, skin_composite });
+}
+
 void Window::RefreshBackground() {
 	background_needs_refresh = false;
 
@@ -129,6 +129,32 @@ private:
 	void RefreshFrame();
 	void RefreshCursor();
 
+	/** Everything the composed frame and background depend on */
+	struct SkinKey {
+		const Bitmap* windowskin = nullptr;
+		int width = 0;
+		int height = 0;
+		bool stretch = false;
+		bool background_alpha = false;
+		int back_opacity = 0;
+		int frame_opacity = 0;
+
+		bool operator==(const SkinKey& other) const;
+	};
+
+	/**
+	 * Draws the frame and background with a single blit of a bitmap
+	 * which is shared between all windows that look the same.
+	 *
+	 * @param dst bitmap to draw onto
+	 * @return false when the window must draw the parts separately
+	 */
+	bool DrawSkinComposite(Bitmap& dst);
+	void RefreshSkinComposite(const SkinKey& key);
+
+	BitmapRef skin_composite;
+	SkinKey skin_composite_key;
+
 	bool background_alpha = false;
 	bool background_needs_refresh;
 	bool frame_needs_refresh;
@@ -92,17 +92,39 @@ void Window_Item::Refresh() {
 
 	item_max = data.size();
 
-	CreateContents();
+	BeginItemRefresh();
 
 	SetIndex(index);
 
-	contents->Clear();
-
 	for (int i = 0; i < item_max; ++i) {
-		DrawItem(i);
+		if (UpdateItemState(i, GetItemState(i))) {
+			DrawItem(i);
+		}
 	}
 }
 
+Window_Selectable::ItemState Window_Item::GetItemState(int index) {
+	int item_id = data[index];
+	if (item_id <= 0) {
+		return { item_id, 0, 0, 0 };
+	}
+	return { item_id, GetItemNumber(item_id), CheckEnable(item_id), 0 };
+}
+
+int Window_Item::GetItemNumber(int item_id) const {
+	int number = Main_Data::game_party->GetItemCount(item_id);
+
+	if (actor) {
+		// Items are guaranteed to be valid
+		const lcf::rpg::Item* item = lcf::ReaderUtil::GetElement(lcf::Data::items, item_id);
+		if (item->use_skill) {
+			number += actor->GetItemCount(item_id);
+		}
+	}
+
+	return number;
+}
+
 void Window_Item::DrawItem(int index) {
 	Rect rect = GetItemRect(index);
 	contents->ClearRect(rect);
@@ -110,15 +132,10 @@ void Window_Item::DrawItem(int index) {
 	int item_id = data[index];
 
 	if (item_id > 0) {
-		int number = Main_Data::game_party->GetItemCount(item_id);
+		int number = GetItemNumber(item_id);
 
 		// Items are guaranteed to be valid
 		const lcf::rpg::Item* item = lcf::ReaderUtil::GetElement(lcf::Data::items, item_id);
-		if (actor) {
-			if (item->use_skill) {
-				number += actor->GetItemCount(item_id);
-			}
-		}
 
 		bool enabled = CheckEnable(item_id);
 		DrawItemName(*item, rect.x, rect.y, enabled);
@@ -79,6 +79,11 @@ public:
 	void SetActor(Game_Actor* actor);
 
 private:
+	ItemState GetItemState(int index);
+
+	/** @return Quantity shown for the item */
+	int GetItemNumber(int item_id) const;
+
 	std::vector<int> data;
 
 	Game_Actor* actor = nullptr;
@@ -21,6 +21,8 @@
 #include "input.h"
 #include "util_macro.h"
 #include "bitmap.h"
+#include "cache.h"
+#include "font.h"
 
 constexpr int arrow_animation_frames = 20;
 
@@ -35,6 +37,59 @@ void Window_Selectable::CreateContents() {
 	SetContents(Bitmap::Create(w, h));
 }
 
+namespace {
+	template <typename T>
+	bool IsSameObject(const std::weak_ptr<T>& weak, const std::shared_ptr<T>& ptr) {
+		return !weak.expired() && !weak.owner_before(ptr) && !ptr.owner_before(weak);
+	}
+}
+
+void Window_Selectable::BeginItemRefresh() {
+	int w = std::max(0, width - border_x * 2);
+	int h = std::max(0, std::max(height - border_y * 2, GetRowMax() * menu_item_height));
+	auto system = Cache::SystemOrBlack();
+	auto font = Font::Default();
+
+	if (!IsSameObject(item_states_contents, contents) || contents->GetWidth() != w || contents->GetHeight() != h
+			|| !IsSameObject(item_states_system, system) || !IsSameObject(item_states_font, font)) {
+		CreateContents();
+		contents->Clear();
+		item_states.clear();
+		item_states_contents = contents;
+		item_states_system = system;
+		item_states_font = font;
+	}
+
+	for (int i = item_max; i < static_cast<int>(item_states.size()); ++i) {
+		if (item_states[i]) {
+			contents->ClearRect(GetItemSlotRect(i));
+		}
+	}
+	item_states.resize(std::max(item_max, 0));
+}
+
+bool Window_Selectable::UpdateItemState(int index, const ItemState& state) {
+	if (index < 0 || index >= static_cast<int>(item_states.size())) {
+		return true;
+	}
+
+	auto& item_state = item_states[index];
+	if (item_state) {
+		if (*item_state == state) {
+			return false;
+		}
+		contents->ClearRect(GetItemSlotRect(index));
+	}
+	item_state = state;
+	return true;
+}
+
+Rect Window_Selectable::GetItemSlotRect(int index) {
+	// The spacing around the item rect is part of the slot, text shadows reach into it
+	Rect rect = GetItemRect(index);
+	return Rect(rect.x, rect.y - menu_item_height / 8, rect.width + 16, menu_item_height);
+}
+
 // Properties
 
 int Window_Selectable::GetIndex() const {
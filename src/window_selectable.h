@@ -19,7 +19,11 @@
 #define EP_WINDOW_SELECTABLE_H
 
 // Headers
+#include <array>
 #include <functional>
+#include <memory>
+#include <optional>
+#include <vector>
 #include "window_base.h"
 #include "window_help.h"
 
@@ -103,6 +107,27 @@ public:
 protected:
 	void UpdateArrows();
 
+	/** Values the drawing of an item depends on, see UpdateItemState */
+	using ItemState = std::array<int, 4>;
+
+	/**
+	 * Prepares the contents for drawing item_max items.
+	 * The contents are only recreated and cleared when their size, the system
+	 * graphic or the font changed. Otherwise the slots of removed items are
+	 * cleared and the remaining items keep their state.
+	 */
+	void BeginItemRefresh();
+
+	/**
+	 * Records the state an item is drawn with.
+	 * Used by Refresh implementations to only redraw items that changed.
+	 *
+	 * @param index item index
+	 * @param state values the drawing of the item depends on
+	 * @return whether the state differs from the last draw
+	 */
+	bool UpdateItemState(int index, const ItemState& state);
+
 	Window_Help* help_window = nullptr;
 	int item_max = 1;
 	int column_max = 1;
@@ -117,6 +142,14 @@ protected:
 	int scroll_progress = 0;
 
 	int wrap_limit = 2;
+
+private:
+	Rect GetItemSlotRect(int index);
+
+	std::vector<std::optional<ItemState>> item_states;
+	std::weak_ptr<Bitmap> item_states_contents;
+	std::weak_ptr<Bitmap> item_states_system;
+	std::weak_ptr<Font> item_states_font;
 };
 
 inline void Window_Selectable::SetItemMax(int value) {
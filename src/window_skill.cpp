@@ -62,13 +62,21 @@ void Window_Skill::Refresh() {
 
 	item_max = data.size();
 
-	CreateContents();
-
-	contents->Clear();
+	BeginItemRefresh();
 
 	for (int i = 0; i < item_max; ++i) {
-		DrawItem(i);
+		if (UpdateItemState(i, GetItemState(i))) {
+			DrawItem(i);
+		}
+	}
+}
+
+Window_Selectable::ItemState Window_Skill::GetItemState(int index) {
+	int skill_id = data[index];
+	if (skill_id <= 0) {
+		return { skill_id, 0, 0, 0 };
 	}
+	return { skill_id, actor->CalculateSkillCost(skill_id), CheckEnable(skill_id), 0 };
 }
 
 void Window_Skill::DrawItem(int index) {
@@ -86,6 +86,8 @@ public:
 	void SetSubsetFilter(int subset);
 
 protected:
+	ItemState GetItemState(int index);
+
 	std::vector<int> data;
 
 	const Game_Actor* actor;
@@ -0,0 +1,167 @@
+#include "system.h"
+
+#ifdef SUPPORT_THREADS
+
+#include <algorithm>
+#include <vector>
+#include "audio_decoder_streamed.h"
+#include "doctest.h"
+
+TEST_SUITE_BEGIN("AudioDecoderStreamed");
+
+namespace {
+/** Produces a counting byte sequence of a fixed length */
+class CountingDecoder : public AudioDecoder {
+public:
+	explicit CountingDecoder(int length) : length(length) {}
+
+	bool Open(Filesystem_Stream::InputStream) override { return true; }
+	bool Seek(std::streamoff offset, std::ios_base::seekdir) override {
+		pos = static_cast<int>(offset);
+		++seeks;
+		return true;
+	}
+	bool IsFinished() const override { return pos >= length; }
+	void GetFormat(int& frequency, Format& format, int& channels) const override {
+		frequency = 1000;
+		format = Format::U8;
+		channels = 1;
+	}
+	int GetTicks() const override { return pos; }
+	bool SetPitch(int new_pitch) override {
+		pitch = new_pitch;
+		return true;
+	}
+	int GetPitch() const override { return pitch; }
+
+	int seeks = 0;
+	int pitch = 100;
+
+private:
+	int FillBuffer(uint8_t* buffer, int size) override {
+		int len = std::min(size, length - pos);
+		for (int i = 0; i < len; ++i) {
+			buffer[i] = static_cast<uint8_t>(pos + i);
+		}
+		pos += len;
+		return len;
+	}
+
+	int length;
+	int pos = 0;
+};
+}
+
+TEST_CASE("Read") {
+	auto dec = std::make_unique<CountingDecoder>(100);
+	AudioDecoderStreamed streamed(std::move(dec), std::chrono::milliseconds(1000));
+
+	REQUIRE(streamed.GetStream()->Fill());
+
+	std::vector<uint8_t> buf(60);
+	REQUIRE_EQ(streamed.Decode(buf.data(), 60), 60);
+	REQUIRE_EQ(buf[59], 59);
+	REQUIRE_EQ(streamed.Decode(buf.data(), 60), 40);
+	REQUIRE_EQ(buf[39], 99);
+	REQUIRE(streamed.IsFinished());
+}
+
+TEST_CASE("Loop while decoding ahead") {
+	auto dec = std::make_unique<CountingDecoder>(50);
+	auto* counting = dec.get();
+	dec->SetLooping(true);
+	AudioDecoderStreamed streamed(std::move(dec), std::chrono::milliseconds(100));
+
+	std::vector<uint8_t> buf(30);
+	for (int i = 0; i < 10; ++i) {
+		streamed.GetStream()->Fill();
+		int seeks = counting->seeks;
+		REQUIRE_EQ(streamed.Decode(buf.data(), 30), 30);
+		// Reading from the buffer does not seek
+		REQUIRE_EQ(counting->seeks, seeks);
+		for (int j = 0; j < 30; ++j) {
+			REQUIRE_EQ(buf[j], (i * 30 + j) % 50);
+		}
+	}
+
+	REQUIRE(!streamed.IsFinished());
+
+	// The loop count follows the played data, play the rest of the decoded chunk
+	buf.resize(250);
+	REQUIRE_EQ(streamed.Decode(buf.data(), 250), 250);
+	REQUIRE_GT(streamed.GetLoopCount(), 0);
+}
+
+TEST_CASE("Underrun decodes directly") {
+	auto dec = std::make_unique<CountingDecoder>(100);
+	AudioDecoderStreamed streamed(std::move(dec), std::chrono::milliseconds(10));
+
+	std::vector<uint8_t> buf(40);
+	REQUIRE_EQ(streamed.Decode(buf.data(), 40), 40);
+	REQUIRE_EQ(buf[39], 39);
+}
+
+TEST_CASE("Seek discards buffer") {
+	auto dec = std::make_unique<CountingDecoder>(100);
+	AudioDecoderStreamed streamed(std::move(dec), std::chrono::milliseconds(1000));
+
+	streamed.GetStream()->Fill();
+	REQUIRE(streamed.Seek(20, std::ios_base::beg));
+	streamed.GetStream()->Fill();
+
+	std::vector<uint8_t> buf(10);
+	REQUIRE_EQ(streamed.Decode(buf.data(), 10), 10);
+	REQUIRE_EQ(buf[0], 20);
+}
+
+TEST_CASE("Ticks of the played data") {
+	auto dec = std::make_unique<CountingDecoder>(10000);
+	AudioDecoderStreamed streamed(std::move(dec), std::chrono::milliseconds(10000));
+
+	REQUIRE(streamed.GetStream()->Fill());
+	// Decoded ahead but nothing played yet
+	REQUIRE_EQ(streamed.GetTicks(), 0);
+
+	std::vector<uint8_t> buf(4000);
+	REQUIRE_EQ(streamed.Decode(buf.data(), 1000), 1000);
+	REQUIRE_EQ(streamed.GetTicks(), 1000);
+	REQUIRE_EQ(streamed.Decode(buf.data(), 4000), 4000);
+	REQUIRE_EQ(streamed.GetTicks(), 5000);
+
+	REQUIRE(streamed.Seek(200, std::ios_base::beg));
+	REQUIRE_EQ(streamed.GetTicks(), 200);
+	streamed.GetStream()->Fill();
+	REQUIRE_EQ(streamed.GetTicks(), 200);
+	REQUIRE_EQ(streamed.Decode(buf.data(), 100), 100);
+	REQUIRE_EQ(streamed.GetTicks(), 300);
+}
+
+TEST_CASE("Loop count of the played data") {
+	auto dec = std::make_unique<CountingDecoder>(500);
+	dec->SetLooping(true);
+	AudioDecoderStreamed streamed(std::move(dec), std::chrono::milliseconds(10000));
+
+	streamed.GetStream()->Fill();
+	REQUIRE_EQ(streamed.GetLoopCount(), 0);
+
+	std::vector<uint8_t> buf(4096);
+	REQUIRE_EQ(streamed.Decode(buf.data(), 4096), 4096);
+	REQUIRE_EQ(streamed.GetLoopCount(), 8);
+}
+
+TEST_CASE("Pitch is applied by the worker") {
+	auto dec = std::make_unique<CountingDecoder>(100);
+	auto* counting = dec.get();
+	AudioDecoderStreamed streamed(std::move(dec), std::chrono::milliseconds(10));
+
+	REQUIRE(streamed.SetPitch(150));
+	REQUIRE_EQ(streamed.GetPitch(), 150);
+	REQUIRE_EQ(counting->pitch, 100);
+
+	streamed.GetStream()->Fill();
+	REQUIRE_EQ(counting->pitch, 150);
+}
+
+TEST_SUITE_END();
+
+#endif
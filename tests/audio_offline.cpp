@@ -0,0 +1,115 @@
+#include <cstdlib>
+#include <sstream>
+#include <vector>
+#include "audio_offline.h"
+#include "filesystem_stream.h"
+#include "doctest.h"
+
+#ifdef WANT_DRWAV
+
+TEST_SUITE_BEGIN("OfflineAudio");
+
+namespace {
+constexpr int frequency = 44100;
+constexpr int crossfade_frames = frequency * 50 / 1000;
+
+/** Stereo WAV with a constant sample value in the output format */
+Filesystem_Stream::InputStream MakeWav(int16_t value) {
+	std::ostringstream os;
+	auto write = [&](uint32_t v, int bytes) {
+		for (int i = 0; i < bytes; ++i) {
+			os.put(static_cast<char>((v >> (i * 8)) & 0xFF));
+		}
+	};
+
+	const uint32_t frames = frequency;
+	os.write("RIFF", 4);
+	write(36 + frames * 4, 4);
+	os.write("WAVEfmt ", 8);
+	write(16, 4);
+	write(1, 2);
+	write(2, 2);
+	write(frequency, 4);
+	write(frequency * 4, 4);
+	write(4, 2);
+	write(16, 2);
+	os.write("data", 4);
+	write(frames * 4, 4);
+	for (uint32_t i = 0; i < frames * 2; ++i) {
+		write(static_cast<uint16_t>(value), 2);
+	}
+
+	std::string str = os.str();
+	std::vector<uint8_t> data(str.begin(), str.end());
+	return Filesystem_Stream::InputStream(new Filesystem_Stream::InputMemoryStreamBuf(std::move(data)), "test.wav");
+}
+
+/** @return Left channel of the captured output */
+std::vector<int> GetLeftChannel(const OfflineAudio& audio) {
+	std::ostringstream os;
+	REQUIRE(audio.WriteWav(os));
+	std::string wav = os.str();
+
+	std::vector<int> samples;
+	for (size_t i = 44; i + 4 <= wav.size(); i += 4) {
+		auto lo = static_cast<uint8_t>(wav[i]);
+		auto hi = static_cast<uint8_t>(wav[i + 1]);
+		samples.push_back(static_cast<int16_t>(lo | (hi << 8)));
+	}
+	return samples;
+}
+}
+
+TEST_CASE("Crossfade") {
+	Game_ConfigAudio cfg;
+	OfflineAudio audio(cfg, frequency, frequency / 100);
+	audio.SetCapture(true);
+
+	audio.BGM_Play(MakeWav(8000), 100, 100, 0);
+	audio.Render(std::chrono::milliseconds(200));
+	audio.BGM_Play(MakeWav(-8000), 100, 100, 0);
+	audio.Render(std::chrono::milliseconds(200));
+	audio.BGM_Stop();
+
+	auto samples = GetLeftChannel(audio);
+	const size_t change = frequency / 5;
+	REQUIRE_EQ(samples.size(), change * 2);
+
+	const int old_value = samples[change - 1];
+	const int new_value = samples.back();
+	REQUIRE_GT(old_value, 0);
+	REQUIRE_LT(new_value, 0);
+
+	// Ramps over the crossfade instead of cutting
+	const int max_step = (old_value - new_value) / 100;
+	for (size_t i = change; i < samples.size(); ++i) {
+		REQUIRE_LE(std::abs(samples[i] - samples[i - 1]), max_step);
+	}
+
+	const int middle = samples[change + crossfade_frames / 2];
+	REQUIRE_LT(middle, old_value / 2);
+	REQUIRE_GT(middle, new_value / 2);
+	REQUIRE_LE(std::abs(samples[change + crossfade_frames + 1] - new_value), 1);
+}
+
+TEST_CASE("Stop cuts immediately") {
+	Game_ConfigAudio cfg;
+	OfflineAudio audio(cfg, frequency, frequency / 100);
+
+	audio.BGM_Play(MakeWav(8000), 100, 100, 0);
+	audio.Render(std::chrono::milliseconds(100));
+	REQUIRE(audio.BGM_IsPlaying());
+
+	audio.BGM_Stop();
+	REQUIRE(!audio.BGM_IsPlaying());
+
+	audio.SetCapture(true);
+	audio.Render(std::chrono::milliseconds(10));
+	for (int sample: GetLeftChannel(audio)) {
+		REQUIRE_EQ(sample, 0);
+	}
+}
+
+TEST_SUITE_END();
+
+#endif
@@ -0,0 +1,74 @@
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "audio_resampler_polyphase.h"
+#include "doctest.h"
+
+TEST_SUITE_BEGIN("AudioResampler");
+
+static std::vector<float> Resample(AudioPolyphaseResampler& res, const std::vector<float>& in, int channels, int chunk) {
+	std::vector<float> out;
+	std::vector<float> buf(chunk * channels);
+
+	size_t offset = 0;
+	const size_t frames = in.size() / channels;
+	while (offset < frames) {
+		uint32_t in_frames = std::min<size_t>(chunk, frames - offset);
+		uint32_t out_frames = chunk;
+		res.Process(&in[offset * channels], in_frames, buf.data(), out_frames);
+		offset += in_frames;
+		out.insert(out.end(), buf.begin(), buf.begin() + out_frames * channels);
+	}
+	return out;
+}
+
+static void testRatio(uint32_t in_rate, uint32_t out_rate) {
+	constexpr int frames = 20000;
+	AudioPolyphaseResampler res(2, 32);
+	res.SetRate(in_rate, out_rate);
+
+	std::vector<float> in(frames * 2);
+	for (int i = 0; i < frames; ++i) {
+		in[i * 2] = std::sin(i * 0.05f);
+		in[i * 2 + 1] = 0.5f;
+	}
+
+	auto out = Resample(res, in, 2, 100);
+	const double ratio = static_cast<double>(out_rate) / in_rate;
+
+	// Only the filter delay is missing at the end
+	REQUIRE_LE(out.size() / 2, frames * ratio + 1);
+	REQUIRE_GE(out.size() / 2, frames * ratio - 64);
+
+	for (size_t i = 64; i < out.size() / 2 - 64; ++i) {
+		REQUIRE(std::abs(out[i * 2] - std::sin(i / ratio * 0.05)) < 1e-3);
+		REQUIRE(std::abs(out[i * 2 + 1] - 0.5f) < 1e-4);
+	}
+}
+
+TEST_CASE("Exact ratios") {
+	testRatio(22050, 44100);
+	testRatio(32000, 48000);
+	testRatio(48000, 24000);
+}
+
+TEST_CASE("Interpolated ratios") {
+	testRatio(44100, 48000);
+	testRatio(44100 * 110, 48000 * 100);
+}
+
+TEST_CASE("Partial consumption") {
+	AudioPolyphaseResampler res(1, 16);
+	res.SetRate(1, 2);
+
+	std::vector<float> in(100, 1.0f);
+	std::vector<float> out(10);
+	uint32_t in_frames = 100;
+	uint32_t out_frames = 10;
+	res.Process(in.data(), in_frames, out.data(), out_frames);
+
+	REQUIRE_EQ(out_frames, 10);
+	REQUIRE_LT(in_frames, 100);
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,104 @@
+#include "test_mock_actor.h"
+#include "autobattle.h"
+#include "enemyai.h"
+#include "game_battlealgorithm.h"
+#include "battle_simulator.h"
+#include "game_pictures.h"
+#include "doctest.h"
+
+TEST_SUITE_BEGIN("BattleSimulator");
+
+TEST_CASE("Summarize") {
+	std::vector<BattleSimulator::RunResult> results = {
+		{ BattleResult::Victory, 3 },
+		{ BattleResult::Victory, 1 },
+		{ BattleResult::Defeat, 5 },
+		{ BattleResult::Victory, 2 },
+		{ BattleResult::Abort, 100 },
+	};
+
+	auto summary = BattleSimulator::Summarize(results);
+	REQUIRE_EQ(summary.runs, 5);
+	REQUIRE_EQ(summary.victories, 3);
+	REQUIRE_EQ(summary.defeats, 1);
+	REQUIRE_EQ(summary.timeouts, 1);
+
+	REQUIRE_EQ(summary.victory_turns.count, 3);
+	REQUIRE_EQ(summary.victory_turns.min, 1);
+	REQUIRE_EQ(summary.victory_turns.median, 2);
+	REQUIRE_EQ(summary.victory_turns.max, 3);
+	REQUIRE(doctest::Approx(2.0) == summary.victory_turns.mean);
+
+	REQUIRE_EQ(summary.defeat_turns.count, 1);
+	REQUIRE_EQ(summary.defeat_turns.min, 5);
+	REQUIRE_EQ(summary.defeat_turns.max, 5);
+
+	auto empty = BattleSimulator::Summarize({});
+	REQUIRE_EQ(empty.runs, 0);
+	REQUIRE_EQ(empty.victory_turns.count, 0);
+}
+
+TEST_CASE("Run") {
+	const MockBattle mb(1, 1);
+	Main_Data::game_pictures = std::make_unique<Game_Pictures>();
+
+	MakeDBEnemy(1, 1, 0, 0, 0, 0, 0);
+	auto* actor = Main_Data::game_party->GetActors()[0];
+	Setup(actor, 500, 0, 100, 100, 100, 100);
+	actor->SetHp(400);
+
+	BattleSimulator::Config config;
+	config.troop_id = 1;
+	config.runs = 10;
+	config.seed = 1;
+	config.autobattle_algo = AutoBattle::AttackOnly::name;
+
+	auto results = BattleSimulator::Run(config);
+	REQUIRE_EQ(results.size(), 10);
+	for (auto& result : results) {
+		REQUIRE_EQ(result.result, BattleResult::Victory);
+		REQUIRE_GE(result.turns, 1);
+	}
+
+	// Same seed, same battle
+	REQUIRE_EQ(BattleSimulator::Run(config)[3].turns, results[3].turns);
+
+	// The party is restored after the simulation
+	REQUIRE_EQ(actor->GetHp(), 400);
+	REQUIRE_FALSE(Game_Battle::IsBattleRunning());
+}
+
+TEST_CASE("ExecutionOrder") {
+	const MockBattle mb(2, 2);
+
+	MakeDBEnemy(1, 1, 0, 0, 0, 0, 1);
+	MakeDBEnemy(2, 1, 0, 0, 0, 0, 500);
+
+	std::vector<std::unique_ptr<EnemyAi::AlgorithmBase>> algos;
+	algos.push_back(EnemyAi::CreateAlgorithm(EnemyAi::RpgRtCompat::name));
+
+	std::deque<Game_Battler*> battlers;
+	for (auto* actor : Main_Data::game_party->GetActors()) {
+		actor->SetBattleAlgorithm(std::make_shared<Game_BattleAlgorithm::None>(actor));
+		battlers.push_back(actor);
+	}
+	for (auto* enemy : Main_Data::game_enemyparty->GetEnemies()) {
+		Game_Battle::SelectEnemyAction(*enemy, algos, 0);
+		REQUIRE(enemy->GetBattleAlgorithm() != nullptr);
+		battlers.push_back(enemy);
+	}
+
+	Game_Battle::CreateExecutionOrder(battlers);
+
+	REQUIRE_EQ(battlers.size(), 4);
+	REQUIRE_EQ(battlers.front(), Main_Data::game_enemyparty->GetEnemies()[1]);
+	for (size_t i = 1; i < battlers.size(); ++i) {
+		REQUIRE_GE(battlers[i - 1]->GetBattleOrderAgi(), battlers[i]->GetBattleOrderAgi());
+	}
+
+	for (auto* battler : battlers) {
+		battler->SetBattleAlgorithm(nullptr);
+	}
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,139 @@
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+#include "bitmap.h"
+#include "pixel_format.h"
+#include "doctest.h"
+
+TEST_SUITE_BEGIN("Bitmap");
+
+namespace {
+/** Compares the raw pixels, allows a rounding difference of 1 per channel */
+void RequireSamePixels(const Bitmap& a, const Bitmap& b) {
+	REQUIRE_EQ(a.width(), b.width());
+	REQUIRE_EQ(a.height(), b.height());
+
+	for (int y = 0; y < a.height(); ++y) {
+		auto* row_a = reinterpret_cast<const uint32_t*>(static_cast<const uint8_t*>(a.pixels()) + y * a.pitch());
+		auto* row_b = reinterpret_cast<const uint32_t*>(static_cast<const uint8_t*>(b.pixels()) + y * b.pitch());
+		for (int x = 0; x < a.width(); ++x) {
+			for (int shift = 0; shift < 32; shift += 8) {
+				int ca = (row_a[x] >> shift) & 0xFF;
+				int cb = (row_b[x] >> shift) & 0xFF;
+				INFO("x=", x, " y=", y, " shift=", shift);
+				REQUIRE_LE(std::abs(ca - cb), 1);
+			}
+		}
+	}
+}
+
+/** Two 4x4 frames stacked vertically with opaque, translucent and empty pixels */
+BitmapRef MakeParticleFrames() {
+	auto src = Bitmap::Create(4, 8, true);
+	src->FillRect(Rect(0, 0, 2, 2), Color(255, 255, 255, 255));
+	src->FillRect(Rect(2, 1, 2, 2), Color(40, 120, 200, 128));
+	src->FillRect(Rect(1, 5, 3, 2), Color(200, 40, 80, 64));
+	src->FillRect(Rect(0, 7, 1, 1), Color(10, 20, 30, 255));
+	return src;
+}
+
+BitmapRef MakeBackground() {
+	auto dst = Bitmap::Create(16, 12, true);
+	dst->FillRect(Rect(0, 0, 16, 6), Color(0, 80, 160, 255));
+	dst->FillRect(Rect(0, 6, 8, 6), Color(160, 80, 0, 128));
+	return dst;
+}
+}
+
+TEST_CASE("ParticleBlit") {
+	Bitmap::SetFormat(format_R8G8B8A8_a().format());
+	auto src = MakeParticleFrames();
+	const Rect src_rect(0, 0, 4, 4);
+
+	// Inside, clipped, across the right, bottom and both edges, skipped
+	const std::vector<int16_t> xs = { 2, -2, 14, 5, 15, 7, 9 };
+	const std::vector<int16_t> ys = { 1, 3, 2, 10, 11, -1, 4 };
+	const std::vector<uint8_t> opacities = { 255, 128, 255, 200, 64, 0, 255 };
+
+	for (bool wrap: { true, false }) {
+		auto actual = MakeBackground();
+		actual->ParticleBlit(*src, src_rect, 2, xs, ys, opacities, wrap);
+
+		auto expected = MakeBackground();
+		for (size_t i = 0; i < xs.size(); ++i) {
+			const Rect frame(0, static_cast<int>(i % 2) * 4, 4, 4);
+			if (wrap) {
+				expected->EdgeMirrorBlit(xs[i], ys[i], *src, frame, true, true, Opacity(opacities[i]));
+			} else {
+				expected->Blit(xs[i], ys[i], *src, frame, Opacity(opacities[i]));
+			}
+		}
+
+		INFO("wrap=", wrap);
+		RequireSamePixels(*actual, *expected);
+	}
+}
+
+TEST_CASE("ParticleBlitReusesFrames") {
+	Bitmap::SetFormat(format_R8G8B8A8_a().format());
+	auto src = MakeParticleFrames();
+
+	// A call with fewer frames after one with more must not see stale pixels
+	const std::vector<int16_t> xs = { 1, 6 };
+	const std::vector<int16_t> ys = { 1, 1 };
+	const std::vector<uint8_t> opacities = { 255, 255 };
+
+	auto actual = MakeBackground();
+	actual->ParticleBlit(*src, Rect(0, 0, 4, 4), 2, xs, ys, opacities, false);
+	actual->ParticleBlit(*src, Rect(0, 4, 4, 4), 1, xs, ys, opacities, false);
+
+	auto expected = MakeBackground();
+	expected->Blit(1, 1, *src, Rect(0, 0, 4, 4), Opacity::Opaque());
+	expected->Blit(6, 1, *src, Rect(0, 4, 4, 4), Opacity::Opaque());
+	expected->Blit(1, 1, *src, Rect(0, 4, 4, 4), Opacity::Opaque());
+	expected->Blit(6, 1, *src, Rect(0, 4, 4, 4), Opacity::Opaque());
+
+	RequireSamePixels(*actual, *expected);
+}
+
+TEST_CASE("SelectBlit") {
+	Bitmap::SetFormat(format_R8G8B8A8_a().format());
+	const Color background(0, 0, 255, 255);
+	const Color color1(255, 0, 0, 255);
+	const Color color2(0, 255, 0, 255);
+
+	auto src1 = Bitmap::Create(7, 5, color1);
+	auto src2 = Bitmap::Create(7, 5, color2);
+
+	auto check = [&](int cell_w, int cell_h, const std::vector<uint8_t>& map) {
+		auto dst = Bitmap::Create(7, 5, background);
+		dst->SelectBlit(*src1, *src2, map, cell_w, cell_h);
+
+		// Cells at the right and bottom border are partially visible
+		const int map_w = (7 + cell_w - 1) / cell_w;
+		for (int y = 0; y < 5; ++y) {
+			for (int x = 0; x < 7; ++x) {
+				const uint8_t m = map[(y / cell_h) * map_w + x / cell_w];
+				const Color expected = (m == 0) ? background : (m == 1) ? color1 : color2;
+				INFO("cell=", cell_w, "x", cell_h, " x=", x, " y=", y);
+				REQUIRE_EQ(dst->GetColorAt(x, y), expected);
+			}
+		}
+	};
+
+	check(2, 2, {
+		0, 1, 2, 1,
+		2, 2, 0, 0,
+		1, 0, 2, 2
+	});
+
+	check(3, 5, { 2, 0, 1 });
+
+	std::vector<uint8_t> pixel_map(7 * 5);
+	for (size_t i = 0; i < pixel_map.size(); ++i) {
+		pixel_map[i] = static_cast<uint8_t>(i % 3);
+	}
+	check(1, 1, pixel_map);
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,124 @@
+#include <vector>
+#include "bitmap.h"
+#include "cache.h"
+#include "doctest.h"
+
+TEST_SUITE_BEGIN("Cache");
+
+namespace {
+BitmapRef Effect(const BitmapRef& src, int x, bool flip_x = true, bool flip_y = false, const Tone& tone = Tone()) {
+	return Cache::SpriteEffect(src, Rect(x, 0, 1, 1), flip_x, flip_y, tone, Color());
+}
+}
+
+TEST_CASE("SpriteEffectHit") {
+	Cache::Clear();
+	Cache::ResetSpriteEffectStats();
+
+	auto src = Bitmap::Create(16, 1);
+	auto effect = Effect(src, 0);
+	REQUIRE_EQ(Effect(src, 0), effect);
+
+	auto stats = Cache::GetSpriteEffectStats();
+	REQUIRE_EQ(stats.hits, 1);
+	REQUIRE_EQ(stats.misses, 1);
+	REQUIRE_EQ(stats.entries, 1u);
+}
+
+TEST_CASE("SpriteEffectDistinctKeys") {
+	Cache::Clear();
+
+	auto src = Bitmap::Create(16, 1);
+	auto other_src = Bitmap::Create(16, 1);
+
+	std::vector<BitmapRef> effects = {
+		Effect(src, 0),
+		Effect(src, 1),
+		Effect(src, 0, false, false, Tone(255, 0, 0, 0)),
+		Effect(src, 0, true, false, Tone(255, 0, 0, 0)),
+		Effect(src, 0, false, true),
+		Cache::SpriteEffect(src, Rect(0, 0, 1, 1), false, false, Tone(), Color(255, 0, 0, 128)),
+		Effect(other_src, 0),
+	};
+
+	for (size_t i = 0; i < effects.size(); ++i) {
+		for (size_t j = i + 1; j < effects.size(); ++j) {
+			REQUIRE_NE(effects[i], effects[j]);
+		}
+	}
+	REQUIRE_EQ(Cache::GetSpriteEffectStats().entries, effects.size());
+
+	// All of them are still found
+	REQUIRE_EQ(Effect(src, 1), effects[1]);
+	REQUIRE_EQ(Effect(other_src, 0), effects[6]);
+}
+
+TEST_CASE("SpriteEffectSourceReplaced") {
+	Cache::Clear();
+
+	auto src = Bitmap::Create(16, 1);
+	auto effect = Effect(src, 0);
+
+	// The effect is alive, but it was created from a destroyed bitmap
+	src = Bitmap::Create(16, 1);
+	REQUIRE_NE(Effect(src, 0), effect);
+}
+
+TEST_CASE("SpriteEffectExpiry") {
+	Cache::Clear();
+	Cache::ResetSpriteEffectStats();
+
+	auto src = Bitmap::Create(128, 1);
+	for (int i = 0; i < 32; ++i) {
+		// The effect is dropped immediately
+		Effect(src, i);
+	}
+	REQUIRE_EQ(Cache::GetSpriteEffectStats().entries, 32u);
+
+	// Expired entries are purged after a few misses
+	for (int i = 32; i < 128; ++i) {
+		Effect(src, i);
+	}
+
+	auto stats = Cache::GetSpriteEffectStats();
+	REQUIRE_GT(stats.purged, 0);
+	REQUIRE_LT(stats.entries, 128u);
+}
+
+TEST_CASE("SpriteEffectLimit") {
+	Cache::Clear();
+	Cache::ResetSpriteEffectStats();
+
+	auto src = Bitmap::Create(1024, 1);
+	std::vector<BitmapRef> effects;
+
+	auto recent = Effect(src, 0);
+	for (int i = 1; i < 1024; ++i) {
+		// Held by "sprites", they never expire
+		effects.push_back(Effect(src, i));
+		REQUIRE_LE(Cache::GetSpriteEffectStats().entries, 512u);
+
+		// Used every frame, must survive the trimming
+		REQUIRE_EQ(Effect(src, 0), recent);
+	}
+
+	auto stats = Cache::GetSpriteEffectStats();
+	REQUIRE_GT(stats.purged, 0);
+
+	// The trimming leaves room for further misses, it does not run on every miss
+	auto purged = stats.purged;
+	int x = 0;
+	while (Cache::GetSpriteEffectStats().purged == purged) {
+		effects.push_back(Effect(src, x++, false, true));
+	}
+	purged = Cache::GetSpriteEffectStats().purged;
+	for (int i = 0; i < 100; ++i) {
+		effects.push_back(Effect(src, x++, false, true));
+	}
+	REQUIRE_EQ(Cache::GetSpriteEffectStats().purged, purged);
+
+	// The oldest entries were dropped
+	REQUIRE_NE(Effect(src, 1), effects[0]);
+}
+
+TEST_SUITE_END();
@@ -4,6 +4,7 @@
 #include "drawable_list.h"
 #include "drawable_mgr.h"
 #include "bitmap.h"
+#include "sprite_batch.h"
 #include "doctest.h"
 
 TEST_SUITE_BEGIN("DrawableList");
@@ -16,6 +17,30 @@ class TestSprite : public Drawable {
 		void Draw(Bitmap&) override {}
 };
 
+class TestBatchSprite : public Drawable {
+	public:
+		TestBatchSprite(Drawable::Z_t z, BitmapRef bitmap, int x) : Drawable(z, Drawable::Flags::Global), bitmap(bitmap), x(x) {}
+		void Draw(Bitmap& dst) override {
+			auto* batch = SpriteBatch::GetActive();
+			REQUIRE(batch != nullptr);
+			REQUIRE(batch->Add(dst, bitmap, x, 0, bitmap->GetRect(), Opacity::Opaque(), Bitmap::BlendMode::Default));
+		}
+		bool IsBatchable() const override { return true; }
+	private:
+		BitmapRef bitmap;
+		int x;
+};
+
+class TestProbe : public Drawable {
+	public:
+		TestProbe(Drawable::Z_t z) : Drawable(z, Drawable::Flags::Global) {}
+		void Draw(Bitmap& dst) override {
+			REQUIRE(SpriteBatch::GetActive() == nullptr);
+			color = dst.GetColorAt(0, 0);
+		}
+		Color color;
+};
+
 class TestFrame : public Drawable {
 	public:
 		TestFrame(Drawable::Z_t z = 0) : Drawable(z, Drawable::Flags::Global | Drawable::Flags::Shared) {}
@@ -350,4 +375,71 @@ TEST_CASE("TakeFromPred") {
 	REQUIRE(list2.IsDirty());
 }
 
+TEST_CASE("BatchedDraw") {
+	Bitmap::SetFormat(format_R8G8B8A8_a().format());
+	Bitmap bitmap(16, 16, true);
+	auto red = Bitmap::Create(4, 4, Color(255, 0, 0, 255));
+
+	TestBatchSprite s1(1, red, 0);
+	TestProbe probe(2);
+	TestBatchSprite s2(3, red, 4);
+	TestBatchSprite s3(4, red, 8);
+
+	DrawableList list;
+	list.Append(&s1);
+	list.Append(&probe);
+	list.Append(&s2);
+	list.Append(&s3);
+
+	list.Draw(bitmap);
+
+	// Queued blits are drawn before a drawable which is not batchable
+	REQUIRE_EQ(probe.color, Color(255, 0, 0, 255));
+	REQUIRE_EQ(bitmap.GetColorAt(4, 0), Color(255, 0, 0, 255));
+	REQUIRE_EQ(bitmap.GetColorAt(11, 3), Color(255, 0, 0, 255));
+	REQUIRE_EQ(bitmap.GetColorAt(12, 0), Color(0, 0, 0, 0));
+	REQUIRE(SpriteBatch::GetActive() == nullptr);
+}
+
+TEST_CASE("BatchMergesAdjacentBlits") {
+	Bitmap::SetFormat(format_R8G8B8A8_a().format());
+	Bitmap bitmap(16, 16, true);
+	Bitmap expected(16, 16, true);
+	auto sheet = Bitmap::Create(8, 8, true);
+	sheet->FillRect(Rect(0, 0, 4, 4), Color(255, 0, 0, 255));
+	sheet->FillRect(Rect(4, 0, 4, 4), Color(0, 255, 0, 255));
+	sheet->FillRect(Rect(0, 4, 4, 4), Color(0, 0, 255, 255));
+
+	const struct {
+		int x;
+		int y;
+		Rect src_rect;
+	} blits[] = {
+		// Merged horizontally
+		{ 2, 2, Rect(0, 0, 4, 4) },
+		{ 6, 2, Rect(4, 0, 4, 4) },
+		// Adjacent in the destination only
+		{ 10, 2, Rect(0, 0, 4, 4) },
+		// Merged vertically
+		{ 10, 6, Rect(0, 4, 4, 4) },
+		// Adjacent in the source only
+		{ 0, 12, Rect(4, 4, 4, 4) },
+	};
+
+	SpriteBatch batch;
+	for (auto& blit: blits) {
+		REQUIRE(batch.Add(bitmap, sheet, blit.x, blit.y, blit.src_rect, Opacity::Opaque(), Bitmap::BlendMode::Default));
+		expected.Blit(blit.x, blit.y, *sheet, blit.src_rect, Opacity::Opaque());
+	}
+	REQUIRE_EQ(batch.GetSize(), 3u);
+
+	batch.Flush();
+	REQUIRE_EQ(batch.GetSize(), 0u);
+	for (int y = 0; y < 16; ++y) {
+		for (int x = 0; x < 16; ++x) {
+			REQUIRE_EQ(bitmap.GetColorAt(x, y), expected.GetColorAt(x, y));
+		}
+	}
+}
+
 TEST_SUITE_END();
@@ -860,4 +860,72 @@ TEST_CASE("ChangeParam") {
 	}
 }
 
+TEST_CASE("EquippedItemCount") {
+	const MockActor m;
+	auto& party = *Main_Data::game_party;
+
+	MakeDBEquip(5, lcf::rpg::Item::Type_armor);
+	auto* a1 = Main_Data::game_actors->GetActor(1);
+	auto* a2 = Main_Data::game_actors->GetActor(2);
+	a1->SetEquipment(lcf::rpg::Item::Type_armor, 5);
+	a2->SetEquipment(lcf::rpg::Item::Type_armor, 5);
+
+	// Only party members count
+	REQUIRE_EQ(party.GetEquippedItemCount(5), 0);
+
+	party.AddActor(1);
+	REQUIRE_EQ(party.GetEquippedItemCount(5), 1);
+	party.AddActor(2);
+	REQUIRE_EQ(party.GetEquippedItemCount(5), 2);
+	REQUIRE_EQ(party.GetEquippedItemCount(0), 8);
+
+	a2->SetEquipment(lcf::rpg::Item::Type_armor, 0);
+	REQUIRE_EQ(party.GetEquippedItemCount(5), 1);
+	REQUIRE_EQ(party.GetEquippedItemCount(0), 9);
+
+	party.AddItem(5, 3);
+	REQUIRE_EQ(party.GetItemTotalCount(5), 4);
+
+	party.RemoveActor(1);
+	REQUIRE_EQ(party.GetEquippedItemCount(5), 0);
+	REQUIRE_EQ(party.GetItemTotalCount(5), 3);
+
+	REQUIRE_EQ(party.GetEquippedItemCount(-1), 0);
+	REQUIRE_EQ(party.GetEquippedItemCount(1000), 0);
+}
+
+TEST_CASE("StatCache") {
+	const MockActor m;
+	auto actor = MakeActor(1, 1, 99, 100, 10, 11, 12, 13, 14);
+	MakeDBEquip(1, lcf::rpg::Item::Type_weapon, 1, 2, 3, 4);
+
+	REQUIRE_EQ(actor.GetBaseAtk(), 11);
+	REQUIRE_EQ(actor.GetBaseDef(), 12);
+
+	actor.SetEquipment(1, 1);
+	REQUIRE_EQ(actor.GetBaseAtk(), 12);
+	REQUIRE_EQ(actor.GetBaseDef(), 14);
+	REQUIRE_EQ(actor.GetBaseAtk(Game_Battler::WeaponNone), 11);
+	REQUIRE_EQ(actor.GetBaseAtk(Game_Battler::WeaponPrimary), 12);
+
+	actor.SetBaseAtk(50);
+	REQUIRE_EQ(actor.GetBaseAtk(), 50);
+	REQUIRE_EQ(actor.GetBaseAtk(Game_Battler::WeaponNone), 49);
+
+	actor.SetEquipment(1, 0);
+	REQUIRE_EQ(actor.GetBaseAtk(), 49);
+	REQUIRE_EQ(actor.GetBaseDef(), 12);
+
+	lcf::Data::actors[0].parameters.attack[1] = 21;
+	lcf::Data::actors[0].parameters.maxhp[1] = 200;
+	actor.SetLevel(2);
+	REQUIRE_EQ(actor.GetBaseAtk(), 59);
+	REQUIRE_EQ(actor.GetBaseMaxHp(), 200);
+
+	auto save = actor.GetSaveData();
+	save.attack_mod = 0;
+	actor.SetSaveData(save);
+	REQUIRE_EQ(actor.GetBaseAtk(), 21);
+}
+
 TEST_SUITE_END();
@@ -52,7 +52,7 @@ TEST_CASE("AssertDestinyScript")
 	const char* destinyScript;
 
 	auto frame = MakeFrame(lines.begin(), lines.end());
-	destinyScript = destiny.Interpreter().MakeString(frame);
+	destinyScript = destiny.Interpreter().MakeString(frame, frame.commands);
 
 	CHECK_EQ(*destinyScript, '$');
 
@@ -0,0 +1,310 @@
+#include <vector>
+#include "game_interpreter_map.h"
+#include "game_switches.h"
+#include "game_variables.h"
+#include "main_data.h"
+#include "player.h"
+#include "doctest.h"
+
+#include "mock_game.h"
+
+TEST_SUITE_BEGIN("Game_Interpreter");
+
+namespace {
+using Cmd = lcf::rpg::EventCommand::Code;
+
+lcf::rpg::EventCommand MakeCommand(Cmd code, std::vector<int32_t> parameters, int indent = 0) {
+	lcf::rpg::EventCommand com;
+	com.code = static_cast<int>(code);
+	com.indent = indent;
+	com.parameters = lcf::DBArray<int32_t>(parameters.begin(), parameters.end());
+	return com;
+}
+
+class TestInterpreter : public Game_Interpreter_Map {
+public:
+	using Game_Interpreter_Map::Game_Interpreter_Map;
+	using Game_Interpreter::GetDecodedList;
+
+	/**
+	 * Executes the base frame once like Update does, without the checks
+	 * for waits, messages and scene changes.
+	 */
+	void Run() {
+		for (int i = 0; i < loop_limit; ++i) {
+			auto* frame = GetFramePtr();
+			if (frame == nullptr || frame->current_command >= static_cast<int>(GetFrameCommands().size())) {
+				return;
+			}
+
+			const int index_before_exec = frame->current_command;
+			if (!ExecuteCommand()) {
+				return;
+			}
+
+			frame = GetFramePtr();
+			if (frame && index_before_exec == frame->current_command) {
+				frame->current_command++;
+			}
+		}
+	}
+};
+
+/** Decodes the commands with specialized handlers to their generic handlers */
+class GenericInterpreter : public TestInterpreter {
+public:
+	CommandEntry DecodeCommand(lcf::rpg::EventCommand const& com) const override {
+		switch (static_cast<Cmd>(com.code)) {
+			case Cmd::ControlVars:
+				return CmdDecode<&GenericInterpreter::CommandControlVariables, 7>();
+			case Cmd::ConditionalBranch:
+				return CmdDecode<&GenericInterpreter::CommandConditionalBranch, 6>();
+			case Cmd::EndLoop:
+				return CmdDecode<&GenericInterpreter::CommandEndLoop, 0>();
+			default:
+				return TestInterpreter::DecodeCommand(com);
+		}
+	}
+};
+
+class ManiacGuard {
+public:
+	explicit ManiacGuard(int patch) {
+		_patch = Player::game_config.patch_maniac.Get();
+		Player::game_config.patch_maniac.Set(patch);
+	}
+
+	ManiacGuard(const ManiacGuard&) = delete;
+	ManiacGuard& operator=(const ManiacGuard&) = delete;
+
+	~ManiacGuard() {
+		Player::game_config.patch_maniac.Set(_patch);
+	}
+private:
+	int _patch = 0;
+};
+
+/**
+ * Runs the list with the specialized and the generic handlers from the same
+ * variables and requires the same variables afterwards.
+ *
+ * @param vars initial values of the variables 1 to vars.size()
+ * @return variables after running the list
+ */
+std::vector<int> RunSpecializedAndGeneric(std::vector<lcf::rpg::EventCommand> commands, const std::vector<int>& vars) {
+	auto list = std::make_shared<const Game_Interpreter::SharedCommands>(std::move(commands));
+
+	auto run = [&](TestInterpreter& interpreter) {
+		for (size_t i = 0; i < vars.size(); ++i) {
+			Main_Data::game_variables->Set(static_cast<int>(i) + 1, vars[i]);
+		}
+		interpreter.Push(list, 0);
+		interpreter.Run();
+
+		std::vector<int> result;
+		for (size_t i = 0; i < vars.size(); ++i) {
+			result.push_back(Main_Data::game_variables->Get(static_cast<int>(i) + 1));
+		}
+		return result;
+	};
+
+	TestInterpreter specialized;
+	GenericInterpreter generic;
+	const auto expected = run(generic);
+	const auto result = run(specialized);
+	REQUIRE_EQ(result, expected);
+	return result;
+}
+
+/** @return whether the command at index uses a different handler than the generic one */
+bool IsSpecialized(const Game_Interpreter::SharedCommands& list, size_t index) {
+	TestInterpreter specialized;
+	GenericInterpreter generic;
+	return specialized.GetDecodedList(list).commands[index].handler != generic.GetDecodedList(list).commands[index].handler;
+}
+
+bool Compare(int val, int val2, int op) {
+	switch (op) {
+		case 0: return val == val2;
+		case 1: return val >= val2;
+		case 2: return val <= val2;
+		case 3: return val > val2;
+		case 4: return val < val2;
+		default: return val != val2;
+	}
+}
+}
+
+TEST_CASE("DecodedList") {
+	const MockGame mg(MockMap::ePass40x30);
+
+	auto list = std::make_shared<const Game_Interpreter::SharedCommands>(std::vector<lcf::rpg::EventCommand>{
+		MakeCommand(Cmd::ControlSwitches, { 0, 1, 1, 0 }),
+		MakeCommand(Cmd::ControlVars, { 0, 5, 5, 0, 0, 42, 0 }),
+		// Malformed, the missing parameters are 0
+		MakeCommand(Cmd::ControlSwitches, { 0, 3 }),
+		MakeCommand(Cmd::ControlVars, { 0, 6 }),
+		MakeCommand(Cmd::Comment, {}),
+		MakeCommand(Cmd::END, {})
+	});
+
+	Main_Data::game_variables->Set(6, 7);
+
+	TestInterpreter interpreter;
+	interpreter.Push(list, 0);
+
+	REQUIRE_EQ(list->decoded.size(), 1);
+	const auto& decoded = interpreter.GetDecodedList(*list);
+	REQUIRE_EQ(&decoded, list->decoded.front().get());
+	REQUIRE_EQ(decoded.commands.size(), 6);
+	REQUIRE_EQ(decoded.padded.size(), 2);
+
+	// Well formed commands are not copied
+	REQUIRE_EQ(decoded.commands[0].com, &list->commands[0]);
+	REQUIRE_EQ(decoded.commands[1].com, &list->commands[1]);
+	REQUIRE_EQ(decoded.commands[2].com->parameters.size(), 4);
+	REQUIRE_EQ(decoded.commands[3].com->parameters.size(), 7);
+	REQUIRE_EQ(decoded.commands[4].handler, nullptr);
+
+	interpreter.Run();
+
+	REQUIRE(Main_Data::game_switches->Get(1));
+	REQUIRE_FALSE(Main_Data::game_switches->Get(2));
+	REQUIRE(Main_Data::game_switches->Get(3));
+	REQUIRE_EQ(Main_Data::game_variables->Get(5), 42);
+	REQUIRE_EQ(Main_Data::game_variables->Get(6), 0);
+
+	// The save state contains the commands as they were in the list
+	const auto save = interpreter.GetSaveState();
+	REQUIRE_EQ(save.stack.size(), 1);
+	REQUIRE_EQ(save.stack[0].commands[2].parameters.size(), 2);
+
+	// Another interpreter of the same type reuses the decoded list
+	TestInterpreter other;
+	other.Push(list, 0);
+	REQUIRE_EQ(list->decoded.size(), 1);
+}
+
+TEST_CASE("SpecializedControlVariables") {
+	const MockGame mg(MockMap::ePass40x30);
+
+	for (int operand = 0; operand <= 1; ++operand) {
+		for (int operation = 0; operation <= 5; ++operation) {
+			INFO("operand=", operand, " operation=", operation);
+			// Variable 1 is the target, variable 2 is the operand variable
+			const auto com = MakeCommand(Cmd::ControlVars, { 0, 1, 1, operation, operand, operand == 0 ? 3 : 2, 0 });
+
+			REQUIRE(IsSpecialized(Game_Interpreter::SharedCommands({ com }), 0));
+			RunSpecializedAndGeneric({ com }, { 17, -4 });
+		}
+	}
+
+	// Ranges, other operands and Maniac operations stay generic
+	for (auto com: {
+			MakeCommand(Cmd::ControlVars, { 1, 1, 2, 1, 0, 3, 0 }),
+			MakeCommand(Cmd::ControlVars, { 0, 1, 1, 1, 2, 1, 5 }),
+			MakeCommand(Cmd::ControlVars, { 0, 1, 1, 6, 0, 3, 0 })
+	}) {
+		REQUIRE_FALSE(IsSpecialized(Game_Interpreter::SharedCommands({ com }), 0));
+	}
+}
+
+TEST_CASE("SpecializedConditionalBranch") {
+	const MockGame mg(MockMap::ePass40x30);
+
+	for (int mode = 0; mode <= 1; ++mode) {
+		for (int op = 0; op <= 5; ++op) {
+			for (int value: { 2, 3, 4 }) {
+				INFO("mode=", mode, " op=", op, " value=", value);
+				// Compares variable 1 with 3 or with variable 2, writes the branch into variable 3
+				std::vector<lcf::rpg::EventCommand> commands = {
+					MakeCommand(Cmd::ConditionalBranch, { 1, 1, mode, mode == 0 ? 3 : 2, op, 1 }),
+					MakeCommand(Cmd::ControlVars, { 0, 3, 3, 0, 0, 1, 0 }, 1),
+					MakeCommand(Cmd::END, {}, 1),
+					MakeCommand(Cmd::ElseBranch, {}),
+					MakeCommand(Cmd::ControlVars, { 0, 3, 3, 0, 0, 2, 0 }, 1),
+					MakeCommand(Cmd::END, {}, 1),
+					MakeCommand(Cmd::EndBranch, {}),
+					MakeCommand(Cmd::END, {})
+				};
+
+				REQUIRE(IsSpecialized(Game_Interpreter::SharedCommands(commands), 0));
+				const auto vars = RunSpecializedAndGeneric(commands, { value, 3, 0 });
+				REQUIRE_EQ(vars[2], Compare(value, 3, op) ? 1 : 2);
+			}
+		}
+	}
+
+	// Other operands stay generic
+	const auto com = MakeCommand(Cmd::ConditionalBranch, { 1, 1, 2, 3, 0, 1 });
+	REQUIRE_FALSE(IsSpecialized(Game_Interpreter::SharedCommands({ com }), 0));
+}
+
+namespace {
+/**
+ * Maniac Patch loop incrementing variable 1 while the condition holds.
+ * The iterations are counted in variable 3.
+ */
+std::vector<lcf::rpg::EventCommand> MakeWhileLoop(int type, int mode_l, int mode_r, int op, int right) {
+	const int modes = mode_l | (mode_r << 4) | (op << 8);
+	return {
+		MakeCommand(Cmd::Loop, { type, modes, 1, right, 3 }),
+		MakeCommand(Cmd::ControlVars, { 0, 1, 1, 1, 0, 1, 0 }, 1),
+		// Guards against endless loops when the condition is ignored
+		MakeCommand(Cmd::ConditionalBranch, { 1, 1, 0, 100, 1, 0 }, 1),
+		MakeCommand(Cmd::BreakLoop, {}, 2),
+		MakeCommand(Cmd::END, {}, 2),
+		MakeCommand(Cmd::EndBranch, {}, 1),
+		MakeCommand(Cmd::END, {}, 1),
+		MakeCommand(Cmd::EndLoop, { type, modes, 1, right, 3 }),
+		MakeCommand(Cmd::END, {})
+	};
+}
+}
+
+TEST_CASE("SpecializedEndLoop") {
+	const MockGame mg(MockMap::ePass40x30);
+	const ManiacGuard maniac(1);
+
+	for (int type = 4; type <= 5; ++type) {
+		for (int mode_r = 0; mode_r <= 1; ++mode_r) {
+			for (int op = 0; op <= 5; ++op) {
+				for (int start: { 0, 5, 10 }) {
+					INFO("type=", type, " mode_r=", mode_r, " op=", op, " start=", start);
+					// Variable 1 compared with 5 or with variable 2
+					const auto commands = MakeWhileLoop(type, 1, mode_r, op, mode_r == 0 ? 5 : 2);
+					REQUIRE(IsSpecialized(Game_Interpreter::SharedCommands(commands), 7));
+
+					const auto vars = RunSpecializedAndGeneric(commands, { start, 5, 0 });
+					if (type == 5 || Compare(start, 5, op)) {
+						REQUIRE_NE(vars[0], start);
+					} else {
+						REQUIRE_EQ(vars[0], start);
+					}
+				}
+			}
+		}
+	}
+
+	// Constant on the left side
+	RunSpecializedAndGeneric(MakeWhileLoop(4, 0, 1, 4, 2), { 0, 7, 0 });
+
+	// Other loop types and operands stay generic
+	REQUIRE_FALSE(IsSpecialized(Game_Interpreter::SharedCommands(MakeWhileLoop(2, 0, 0, 0, 5)), 7));
+	REQUIRE_FALSE(IsSpecialized(Game_Interpreter::SharedCommands(MakeWhileLoop(4, 2, 0, 0, 5)), 7));
+}
+
+TEST_CASE("SpecializedEndLoopWithoutManiac") {
+	const MockGame mg(MockMap::ePass40x30);
+	const ManiacGuard maniac(0);
+
+	// The loop is endless without the Maniac Patch, only the break ends it
+	const auto commands = MakeWhileLoop(4, 1, 0, 4, 5);
+	REQUIRE(IsSpecialized(Game_Interpreter::SharedCommands(commands), 7));
+
+	const auto vars = RunSpecializedAndGeneric(commands, { 0, 0, 0 });
+	REQUIRE_EQ(vars[0], 100);
+	REQUIRE_EQ(vars[2], 0);
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,120 @@
+#include "game_strings.h"
+#include "main_data.h"
+#include "doctest.h"
+
+#include "mock_game.h"
+
+TEST_SUITE_BEGIN("Game_Strings");
+
+TEST_CASE("PopLine") {
+	Game_Strings strings;
+	strings.Set(1, "first\r\nsecond\nlast");
+
+	REQUIRE_EQ(strings.PopLine(1, 0, 2), "first");
+	REQUIRE_EQ(strings.Get(1), "second\nlast");
+
+	REQUIRE_EQ(strings.PopLine(1, 1, 2), "last");
+	REQUIRE_EQ(strings.Get(1), "");
+
+	// Nothing left to pop
+	REQUIRE_EQ(strings.PopLine(1, 0, 2), "");
+	REQUIRE_EQ(strings.Get(1), "");
+}
+
+TEST_CASE("PopLineLastLine") {
+	Game_Strings strings;
+
+	SUBCASE("no line ending") {
+		strings.Set(1, "only");
+		REQUIRE_EQ(strings.PopLine(1, 0, 5), "only");
+	}
+
+	SUBCASE("line ending") {
+		strings.Set(1, "only\n");
+		REQUIRE_EQ(strings.PopLine(1, 0, 5), "only");
+	}
+
+	REQUIRE_EQ(strings.Get(1), "");
+	REQUIRE_EQ(strings.GetData().size(), 5);
+}
+
+TEST_CASE("PopLineSameId") {
+	Game_Strings strings;
+	strings.Set(1, "a\nb");
+
+	// The popped line is discarded
+	REQUIRE_EQ(strings.PopLine(1, 0, 1), "b");
+	REQUIRE_EQ(strings.PopLine(1, 0, 1), "");
+}
+
+TEST_CASE("Split") {
+	const MockGame mg(MockMap::ePass40x30);
+	auto& variables = *Main_Data::game_variables;
+
+	Game_Strings strings;
+	strings.Set(1, "a,,b,");
+
+	REQUIRE_EQ(strings.Split(1, ",", 10, 1, variables), 4);
+	REQUIRE_EQ(variables.Get(1), 4);
+	REQUIRE_EQ(strings.Get(10), "a");
+	REQUIRE_EQ(strings.Get(11), "");
+	REQUIRE_EQ(strings.Get(12), "b");
+	REQUIRE_EQ(strings.Get(13), "");
+
+	// Empty fields are not assigned, Cat starts them from scratch
+	REQUIRE_EQ(strings.ToNum(11, 2, variables), 0);
+	REQUIRE_EQ(strings.Cat(11, "x"), "x");
+
+	// The output can overwrite the source
+	strings.Set(1, "c;d");
+	REQUIRE_EQ(strings.Split(1, ";", 1, 1, variables), 2);
+	REQUIRE_EQ(strings.Get(1), "c");
+	REQUIRE_EQ(strings.Get(2), "d");
+}
+
+TEST_CASE("SetGrow") {
+	Game_Strings strings;
+
+	// Empty strings do not grow the storage
+	strings.Set(50, "");
+	REQUIRE(strings.GetData().empty());
+
+	strings.Set(1, "source");
+	strings.Set(100, "z");
+	REQUIRE_EQ(strings.GetData().size(), 100);
+	REQUIRE_EQ(strings.Get(99), "");
+	REQUIRE_EQ(strings.Get(100), "z");
+	REQUIRE_EQ(strings.Get(101), "");
+
+	// The source is a view into the storage that is moved when growing
+	strings.Set(1000, strings.Get(1));
+	REQUIRE_EQ(strings.Get(1000), "source");
+	REQUIRE_EQ(strings.Get(1), "source");
+}
+
+TEST_CASE("LcfData") {
+	Game_Strings strings;
+	strings.Set(3, "c");
+	strings.Set(4, "d");
+	strings.Set(4, "");
+	// Grows to the output id, the popped line is empty and not assigned
+	REQUIRE_EQ(strings.PopLine(4, 0, 8), "");
+	REQUIRE_EQ(strings.GetData().size(), 8);
+
+	// Gaps are saved as empty strings, trailing unassigned strings are not saved
+	auto data = strings.GetLcfData();
+	REQUIRE_EQ(data.size(), 4);
+	REQUIRE_EQ(ToString(data[0]), "");
+	REQUIRE_EQ(ToString(data[1]), "");
+	REQUIRE_EQ(ToString(data[2]), "c");
+	REQUIRE_EQ(ToString(data[3]), "");
+
+	// Does not grow on every load and save
+	Game_Strings loaded;
+	loaded.SetData(data);
+	REQUIRE(loaded.GetLcfData() == data);
+	REQUIRE_EQ(loaded.Get(1), "");
+	REQUIRE_EQ(loaded.Get(3), "c");
+}
+
+TEST_SUITE_END();
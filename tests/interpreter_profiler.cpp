@@ -0,0 +1,61 @@
+#include <sstream>
+#include "interpreter_profiler.h"
+#include "doctest.h"
+
+TEST_SUITE_BEGIN("InterpreterProfiler");
+
+using namespace std::chrono_literals;
+
+static InterpreterProfiler::Source MakeSource(InterpreterProfiler::SourceType type, int map_id, int event_id, int page_id) {
+	InterpreterProfiler::Source source;
+	source.type = type;
+	source.map_id = map_id;
+	source.event_id = event_id;
+	source.page_id = page_id;
+	return source;
+}
+
+TEST_CASE("Aggregate") {
+	InterpreterProfiler::Reset();
+
+	const auto ce = MakeSource(InterpreterProfiler::SourceType::CommonEvent, 0, 12, 0);
+	const auto ev = MakeSource(InterpreterProfiler::SourceType::MapEvent, 3, 4, 1);
+
+	InterpreterProfiler::Record(ce, 0, 10110, 5us);
+	InterpreterProfiler::Record(ce, 0, 10110, 5us);
+	InterpreterProfiler::Record(ce, 1, 12010, 1us);
+	InterpreterProfiler::Record(ev, 2, 11410, 7us);
+
+	const auto commands = InterpreterProfiler::GetCommandEntries();
+	REQUIRE_EQ(commands.size(), 3);
+	REQUIRE_EQ(commands[0].source.event_id, 12);
+	REQUIRE_EQ(commands[0].command_index, 0);
+	REQUIRE_EQ(commands[0].count, 2);
+	REQUIRE_EQ(commands[0].time, 10us);
+	REQUIRE_EQ(commands[1].code, 11410);
+	REQUIRE_EQ(commands[2].code, 12010);
+
+	const auto events = InterpreterProfiler::GetEventEntries();
+	REQUIRE_EQ(events.size(), 2);
+	REQUIRE_EQ(InterpreterProfiler::GetSourceName(events[0].source), "CE0012");
+	REQUIRE_EQ(events[0].count, 3);
+	REQUIRE_EQ(events[0].time, 11us);
+	REQUIRE_EQ(InterpreterProfiler::GetSourceName(events[1].source), "M0003 EV0004 P1");
+
+	InterpreterProfiler::Reset();
+	REQUIRE(InterpreterProfiler::GetCommandEntries().empty());
+}
+
+TEST_CASE("Csv") {
+	InterpreterProfiler::Reset();
+
+	InterpreterProfiler::Record(MakeSource(InterpreterProfiler::SourceType::MapEvent, 3, 4, 1), 2, 11410, 7us);
+
+	std::stringstream ss;
+	REQUIRE(InterpreterProfiler::WriteCsv(ss));
+	REQUIRE_EQ(ss.str(), "type,map_id,event_id,page_id,command_index,code,count,time_us\nmap_event,3,4,1,2,11410,1,7\n");
+
+	InterpreterProfiler::Reset();
+}
+
+TEST_SUITE_END();
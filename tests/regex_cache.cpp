@@ -0,0 +1,49 @@
+#include "regex_cache.h"
+#include "doctest.h"
+
+TEST_SUITE_BEGIN("RegexCache");
+
+TEST_CASE("Get") {
+	RegexCache::Clear();
+
+	const auto& a = RegexCache::Get(L"a+");
+	REQUIRE(std::regex_match(std::wstring(L"aaa"), a));
+	REQUIRE_EQ(RegexCache::GetSize(), 1);
+
+	// Cache hit returns the same object
+	REQUIRE_EQ(&RegexCache::Get(L"a+"), &a);
+	REQUIRE_EQ(RegexCache::GetSize(), 1);
+
+	// Flags are part of the key
+	const auto& icase = RegexCache::Get(L"a+", std::regex_constants::ECMAScript | std::regex_constants::icase);
+	REQUIRE(std::regex_match(std::wstring(L"AA"), icase));
+	REQUIRE_EQ(RegexCache::GetSize(), 2);
+
+	RegexCache::Clear();
+	REQUIRE_EQ(RegexCache::GetSize(), 0);
+}
+
+TEST_CASE("Invalid") {
+	RegexCache::Clear();
+
+	REQUIRE_THROWS_AS(RegexCache::Get(L"(a"), std::regex_error);
+	REQUIRE_EQ(RegexCache::GetSize(), 0);
+}
+
+TEST_CASE("Evict") {
+	RegexCache::Clear();
+
+	const auto& first = RegexCache::Get(L"first");
+	(void)first;
+	for (int i = 0; i < 1000; ++i) {
+		RegexCache::Get(std::to_wstring(i));
+		// Keep first in use
+		RegexCache::Get(L"first");
+	}
+	REQUIRE_LT(RegexCache::GetSize(), 1000);
+	REQUIRE(std::regex_match(std::wstring(L"first"), RegexCache::Get(L"first")));
+
+	RegexCache::Clear();
+}
+
+TEST_SUITE_END();
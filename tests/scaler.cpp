@@ -0,0 +1,80 @@
+#include <cstddef>
+#include <vector>
+#include "scaler.h"
+#include "doctest.h"
+
+TEST_SUITE_BEGIN("Scaler");
+
+TEST_CASE("NearestInteger") {
+	std::vector<uint32_t> src = { 1, 2, 3, 4 };
+	std::vector<uint32_t> dst(6 * 4);
+
+	Scaler::Nearest(src.data(), 2, 2, 2 * 4, dst.data(), 6, 4, 6 * 4);
+
+	std::vector<uint32_t> expected = {
+		1, 1, 1, 2, 2, 2,
+		1, 1, 1, 2, 2, 2,
+		3, 3, 3, 4, 4, 4,
+		3, 3, 3, 4, 4, 4
+	};
+	REQUIRE_EQ(dst, expected);
+}
+
+TEST_CASE("NearestFractional") {
+	std::vector<uint32_t> src(7 * 5);
+	for (size_t i = 0; i < src.size(); ++i) {
+		src[i] = static_cast<uint32_t>(i);
+	}
+
+	const int w = 17;
+	const int h = 9;
+	// Rows are padded
+	const int pitch = (w + 3) * 4;
+	std::vector<uint32_t> dst((w + 3) * h);
+
+	Scaler::Nearest(src.data(), 7, 5, 7 * 4, dst.data(), w, h, pitch);
+
+	for (int y = 0; y < h; ++y) {
+		for (int x = 0; x < w; ++x) {
+			const int sx = (2 * x + 1) * 7 / (2 * w);
+			const int sy = (2 * y + 1) * 5 / (2 * h);
+			REQUIRE_EQ(dst[y * (w + 3) + x], src[sy * 7 + sx]);
+		}
+	}
+}
+
+TEST_CASE("BilinearSameSize") {
+	std::vector<uint32_t> src = { 0x01020304, 0xFFFFFFFF, 0x00000000, 0x80808080 };
+	std::vector<uint32_t> dst(4);
+
+	Scaler::Bilinear(src.data(), 2, 2, 2 * 4, dst.data(), 2, 2, 2 * 4);
+
+	REQUIRE_EQ(dst, src);
+}
+
+TEST_CASE("BilinearUpscale") {
+	std::vector<uint32_t> src = { 0x00000000, 0xFFFFFFFF };
+	std::vector<uint32_t> dst(4);
+
+	Scaler::Bilinear(src.data(), 2, 1, 2 * 4, dst.data(), 4, 1, 4 * 4);
+
+	REQUIRE_EQ(dst[0], 0x00000000u);
+	REQUIRE_EQ(dst[1], 0x3F3F3F3Fu);
+	REQUIRE_EQ(dst[2], 0xBFBFBFBFu);
+	REQUIRE_EQ(dst[3], 0xFFFFFFFFu);
+}
+
+TEST_CASE("BilinearPrescale") {
+	std::vector<uint32_t> src = { 0x00000000, 0xFFFFFFFF };
+	std::vector<uint32_t> dst(8);
+
+	// Like upscaling to 8 pixels with nearest neighbour first: No blending inside a source pixel
+	Scaler::Bilinear(src.data(), 2, 1, 2 * 4, dst.data(), 8, 1, 8 * 4, 4);
+
+	REQUIRE_EQ(dst[0], 0x00000000u);
+	REQUIRE_EQ(dst[2], 0x00000000u);
+	REQUIRE_EQ(dst[5], 0xFFFFFFFFu);
+	REQUIRE_EQ(dst[7], 0xFFFFFFFFu);
+}
+
+TEST_SUITE_END();
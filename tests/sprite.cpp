@@ -0,0 +1,68 @@
+#include <cstdlib>
+#include "sprite.h"
+#include "bitmap.h"
+#include "cache.h"
+#include "drawable_list.h"
+#include "drawable_mgr.h"
+#include "pixel_format.h"
+#include "doctest.h"
+
+TEST_SUITE_BEGIN("Sprite");
+
+namespace {
+/** Compares the colors, allows a rounding difference of 1 per channel */
+void RequireSameColor(const Color& a, const Color& b) {
+	REQUIRE_LE(std::abs(a.red - b.red), 1);
+	REQUIRE_LE(std::abs(a.green - b.green), 1);
+	REQUIRE_LE(std::abs(a.blue - b.blue), 1);
+	REQUIRE_EQ(a.alpha, b.alpha);
+}
+
+void DrawStaticAndFadingTone() {
+	auto fused = Bitmap::Create(16, 16);
+	auto cached = Bitmap::Create(16, 16);
+
+	Sprite sprite;
+	sprite.SetBitmap(Bitmap::Create(16, 16, Color(128, 128, 128, 255)));
+	sprite.SetTone(Tone(255, 0, 0, 128));
+
+	// The tone changed since the last frame, drawn without an effect bitmap
+	sprite.Draw(*fused);
+	REQUIRE_EQ(Cache::GetSpriteEffectStats().misses, 0);
+
+	// The tone is stable, the effect bitmap is created once and reused
+	for (int i = 0; i < 10; ++i) {
+		sprite.Draw(*cached);
+	}
+	auto stats = Cache::GetSpriteEffectStats();
+	REQUIRE_EQ(stats.misses, 1);
+	REQUIRE_EQ(stats.hits, 0);
+
+	RequireSameColor(fused->GetColorAt(3, 5), cached->GetColorAt(3, 5));
+
+	// A fade changes the tone every frame and never creates effect bitmaps
+	for (int i = 0; i < 10; ++i) {
+		sprite.SetTone(Tone(255 - i * 20, 0, 0, 128));
+		sprite.Draw(*fused);
+	}
+	REQUIRE_EQ(Cache::GetSpriteEffectStats().misses, 1);
+
+	// After the fade the final tone is cached again
+	sprite.Draw(*fused);
+	sprite.Draw(*fused);
+	REQUIRE_EQ(Cache::GetSpriteEffectStats().misses, 2);
+}
+}
+
+TEST_CASE("StaticToneUsesEffectCache") {
+	Bitmap::SetFormat(format_R8G8B8A8_a().format());
+	Cache::Clear();
+	Cache::ResetSpriteEffectStats();
+
+	DrawableList list;
+	DrawableMgr::SetLocalList(&list);
+	DrawStaticAndFadingTone();
+	DrawableMgr::SetLocalList(nullptr);
+}
+
+TEST_SUITE_END();
@@ -123,6 +123,56 @@ TEST_CASE("FlipRange") {
 	REQUIRE_FALSE(s.Get(n + 1));
 }
 
+TEST_CASE("RangeWords") {
+	constexpr int n = 300;
+	auto s = make();
+
+	// Ranges inside one word, across a word boundary and over several words
+	s.SetRange(3, 10, true);
+	s.SetRange(60, 70, true);
+	s.FlipRange(100, 260);
+	s.SetRange(128, 192, false);
+
+	for (int i = 1; i <= n; ++i) {
+		const bool expected = (i >= 3 && i <= 10) || (i >= 60 && i <= 70)
+			|| (i >= 100 && i <= 260 && !(i >= 128 && i <= 192));
+		REQUIRE_EQ(s.Get(i), expected);
+	}
+	REQUIRE_EQ(s.GetSize(), 260);
+
+	REQUIRE_EQ(s.CountRange(1, n), 8 + 11 + 28 + 68);
+	REQUIRE_EQ(s.CountRange(5, 64), 6 + 5);
+	REQUIRE_EQ(s.CountRange(65, 65), 1);
+	REQUIRE_EQ(s.CountRange(128, 192), 0);
+	REQUIRE_EQ(s.CountRange(10, 3), 0);
+	REQUIRE_EQ(s.CountRange(-5, 3), 1);
+}
+
+TEST_CASE("Data") {
+	auto s = make();
+
+	Game_Switches::Switches_t data(70);
+	data[0] = true;
+	data[63] = true;
+	data[64] = true;
+	data[69] = true;
+	s.SetData(data);
+
+	REQUIRE_EQ(s.GetSize(), 70);
+	REQUIRE(s.Get(1));
+	REQUIRE_FALSE(s.Get(2));
+	REQUIRE(s.Get(64));
+	REQUIRE(s.Get(65));
+	REQUIRE(s.Get(70));
+	REQUIRE_EQ(s.CountRange(1, 70), 4);
+	REQUIRE(s.GetData() == data);
+
+	// Growing must not reveal old bits
+	s.SetData(Game_Switches::Switches_t(3, false));
+	s.Set(80, false);
+	REQUIRE_EQ(s.CountRange(1, 80), 0);
+}
+
 TEST_CASE("GetSize") {
 	auto s = make();
 	REQUIRE_EQ(s.GetSizeWithLimit(), max_switches);
@@ -0,0 +1,86 @@
+#include <string>
+#include "text_run_cache.h"
+#include "text.h"
+#include "pixel_format.h"
+#include "cache.h"
+#include "bitmap.h"
+#include "font.h"
+#include "doctest.h"
+
+TEST_SUITE_BEGIN("TextRunCache");
+
+TEST_CASE("Hit") {
+	Bitmap::SetFormat(format_R8G8B8A8_a().format());
+	TextRunCache::Clear();
+	auto font = Font::Default();
+	auto system = Cache::SysBlack();
+
+	const auto* run = TextRunCache::Get(font, system, 0, "abc");
+	REQUIRE(run != nullptr);
+	REQUIRE(run->bitmap != nullptr);
+	REQUIRE_EQ(run->advance, Point(18, 12));
+	REQUIRE_EQ(run->width, 18);
+
+	const std::string text = "abc";
+	REQUIRE_EQ(TextRunCache::Get(font, system, 0, text), run);
+
+	// Different color
+	REQUIRE_NE(TextRunCache::Get(font, system, 1, "abc"), run);
+	REQUIRE_EQ(TextRunCache::Get(font, system, 0, "abc"), run);
+}
+
+TEST_CASE("KeyOwnsText") {
+	Bitmap::SetFormat(format_R8G8B8A8_a().format());
+	TextRunCache::Clear();
+	auto font = Font::Default();
+	auto system = Cache::SysBlack();
+
+	std::string text = "xyz";
+	const auto* run = TextRunCache::Get(font, system, 0, text);
+	REQUIRE(run != nullptr);
+
+	// The cache must not refer to the string of the caller
+	text = "uvw";
+	REQUIRE_NE(TextRunCache::Get(font, system, 0, text), run);
+	REQUIRE_EQ(TextRunCache::Get(font, system, 0, "xyz"), run);
+}
+
+TEST_CASE("NotCached") {
+	TextRunCache::Clear();
+	auto font = Font::Default();
+	auto system = Cache::SysBlack();
+
+	REQUIRE(TextRunCache::Get(font, system, 0, "") == nullptr);
+	REQUIRE(TextRunCache::Get(font, system, 0, std::string(300, 'a')) == nullptr);
+
+	// Only spaces: Cached, but nothing to draw
+	const auto* run = TextRunCache::Get(font, system, 0, "  ");
+	REQUIRE(run != nullptr);
+	REQUIRE(run->bitmap == nullptr);
+	REQUIRE_EQ(run->advance, Point(12, 12));
+}
+
+TEST_CASE("SameAsTextDraw") {
+	Bitmap::SetFormat(format_R8G8B8A8_a().format());
+	TextRunCache::Clear();
+	auto font = Font::Default();
+	auto system = Cache::SysBlack();
+	const std::string text = "Ag$A";
+
+	auto expected = Bitmap::Create(80, 40);
+	Text::Draw(*expected, 10, 10, *font, *system, 0, text);
+
+	const auto* run = TextRunCache::Get(font, system, 0, text);
+	REQUIRE(run != nullptr);
+	REQUIRE(run->bitmap != nullptr);
+	auto actual = Bitmap::Create(80, 40);
+	actual->Blit(10 + run->offset.x, 10 + run->offset.y, *run->bitmap, run->bitmap->GetRect(), Opacity::Opaque());
+
+	for (int y = 0; y < 40; ++y) {
+		for (int x = 0; x < 80; ++x) {
+			REQUIRE_EQ(actual->GetColorAt(x, y), expected->GetColorAt(x, y));
+		}
+	}
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,49 @@
+#include <cstdint>
+#include <vector>
+#include "transition.h"
+#include "bitmap.h"
+#include "pixel_format.h"
+#include "doctest.h"
+
+TEST_SUITE_BEGIN("Transition");
+
+TEST_CASE("MosaicUsesPitch") {
+	Bitmap::SetFormat(format_R8G8B8A8_a().format());
+	const auto& format = Bitmap::pixel_format;
+
+	constexpr int w = 10;
+	constexpr int h = 7;
+	constexpr int m_size = 4;
+	// Rows of the screen are padded, the padding must never be sampled
+	constexpr int stride = w + 3;
+	const uint32_t padding = format.rgba_to_uint32_t(255, 0, 255, 255);
+
+	std::vector<uint32_t> pixels(stride * h, padding);
+	for (int y = 0; y < h; ++y) {
+		for (int x = 0; x < w; ++x) {
+			pixels[y * stride + x] = format.rgba_to_uint32_t(x * 20, y * 30, 0, 255);
+		}
+	}
+	auto screen = Bitmap::Create(pixels.data(), w, h, stride * sizeof(uint32_t), format);
+
+	auto dst = Bitmap::Create(w, h, Color(0, 0, 0, 255));
+	Transition::DrawMosaic(*dst, *screen, m_size);
+
+	// The grid is centered, every cell has the color of one screen pixel
+	const int off_x = ((m_size - w % m_size) % m_size) / 2;
+	const int off_y = ((m_size - h % m_size) % m_size) / 2;
+	for (int y = 0; y < h; ++y) {
+		for (int x = 0; x < w; ++x) {
+			const int i = (x + off_x) / m_size * m_size;
+			const int j = (y + off_y) / m_size * m_size;
+			const int sx = (i == 0) ? m_size - 1 : i;
+			const int sy = (j == 0) ? m_size - 1 : j;
+
+			INFO("x=", x, " y=", y);
+			REQUIRE_EQ(dst->GetColorAt(x, y), screen->GetColorAt(sx, sy));
+			REQUIRE_NE(dst->GetColorAt(x, y), Color(255, 0, 255, 255));
+		}
+	}
+}
+
+TEST_SUITE_END();
@@ -51,6 +51,15 @@ TEST_CASE("StrICmp") {
 	}
 }
 
+TEST_CASE("StrIFind") {
+	REQUIRE_EQ(Utils::StrIFind("EasyRPG Player", "rpg"), 4);
+	REQUIRE_EQ(Utils::StrIFind("EasyRPG Player", "PLAYER"), 8);
+	REQUIRE_EQ(Utils::StrIFind("EasyRPG Player", ""), 0);
+	REQUIRE_EQ(Utils::StrIFind("", ""), 0);
+	REQUIRE_EQ(Utils::StrIFind("EasyRPG", "Player"), std::string::npos);
+	REQUIRE_EQ(Utils::StrIFind("", "a"), std::string::npos);
+}
+
 TEST_CASE("ReplaceAll") {
 	SUBCASE("one") {
 		REQUIRE(Utils::ReplaceAll("abc", "b", "xyz") == "axyzc");
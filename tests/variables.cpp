@@ -1,5 +1,6 @@
 #include "game_variables.h"
 #include "doctest.h"
+#include <algorithm>
 
 TEST_SUITE_BEGIN("Variables");
 
@@ -553,6 +554,64 @@ TEST_CASE("Overflow/Underflow") {
 	v.Set(1, _min);
 	v.Mult(1, 2);
 	REQUIRE(v.Get(1) == _min);
+
+	v.Set(1, _min);
+	v.Div(1, -1);
+	REQUIRE(v.Get(1) == _max);
+
+	v.Set(1, _min);
+	v.Mod(1, -1);
+	REQUIRE(v.Get(1) == 0);
+}
+
+TEST_CASE("Overflow/Underflow Range") {
+	lcf::Data::variables.resize(max_vars);
+
+	auto _min = std::numeric_limits<Game_Variables::Var_t>::min();
+	auto _max = std::numeric_limits<Game_Variables::Var_t>::max();
+
+	Game_Variables v(_min, _max);
+	v.SetWarning(0);
+
+	v.Set(1, _max);
+	v.Set(2, _min);
+	v.Set(3, 5);
+	v.AddRange(1, 3, _max);
+	REQUIRE_EQ(v.Get(1), _max);
+	REQUIRE_EQ(v.Get(2), -1);
+	REQUIRE_EQ(v.Get(3), _max);
+
+	v.Set(1, _max);
+	v.Set(2, _min);
+	v.Set(3, -5);
+	v.SubRange(1, 3, _max);
+	REQUIRE_EQ(v.Get(1), 0);
+	REQUIRE_EQ(v.Get(2), _min);
+	REQUIRE_EQ(v.Get(3), _min);
+
+	v.Set(1, _max);
+	v.Set(2, _min);
+	v.Set(3, 0);
+	v.SubRange(1, 3, _min);
+	REQUIRE_EQ(v.Get(1), _max);
+	REQUIRE_EQ(v.Get(2), 0);
+	REQUIRE_EQ(v.Get(3), _max);
+
+	v.Set(1, _max);
+	v.Set(2, _min);
+	v.Set(3, _min);
+	v.Set(4, _max);
+	v.AddArray(1, 2, 3);
+	REQUIRE_EQ(v.Get(1), -1);
+	REQUIRE_EQ(v.Get(2), -1);
+
+	v.Set(1, _max);
+	v.Set(2, _min);
+	v.Set(3, _min);
+	v.Set(4, _max);
+	v.SubArray(1, 2, 3);
+	REQUIRE_EQ(v.Get(1), _max);
+	REQUIRE_EQ(v.Get(2), _min);
 }
 
 TEST_CASE("Enumerate") {
@@ -607,4 +666,26 @@ TEST_CASE("Sort") {
 	REQUIRE_EQ(s.Get(4), 4);
 }
 
+TEST_CASE("SortLarge") {
+	constexpr int n = 1000;
+	auto s = make();
+
+	for (int i = 1; i <= n; ++i) {
+		// Mix of negative, positive and values wider than one byte
+		s.Set(i, ((i * 7919) % 2001 - 1000) * ((i % 3 == 0) ? 1000 : 1));
+	}
+	std::vector<Game_Variables::Var_t> expected(s.GetData().begin() + 1, s.GetData().begin() + n - 1);
+
+	s.SortRange(2, n - 1, true);
+	std::sort(expected.begin(), expected.end());
+	REQUIRE(std::equal(expected.begin(), expected.end(), s.GetData().begin() + 1));
+
+	s.SortRange(2, n - 1, false);
+	std::reverse(expected.begin(), expected.end());
+	REQUIRE(std::equal(expected.begin(), expected.end(), s.GetData().begin() + 1));
+
+	REQUIRE_EQ(s.Get(1), (7919 % 2001) - 1000);
+	REQUIRE_EQ(s.Get(n), ((n * 7919) % 2001 - 1000));
+}
+
 TEST_SUITE_END();
@@ -0,0 +1,87 @@
+#include <vector>
+#include "window_selectable.h"
+#include "drawable_list.h"
+#include "drawable_mgr.h"
+#include "pixel_format.h"
+#include "bitmap.h"
+#include "test_mock_actor.h"
+#include "doctest.h"
+
+TEST_SUITE_BEGIN("Window_Selectable");
+
+namespace {
+class TestWindow : public Window_Selectable {
+public:
+	TestWindow() : Window_Selectable(0, 0, 100, 80) {}
+
+	void Refresh() {
+		item_max = static_cast<int>(states.size());
+		drawn.clear();
+
+		BeginItemRefresh();
+		for (int i = 0; i < item_max; ++i) {
+			if (UpdateItemState(i, states[i])) {
+				drawn.push_back(i);
+				contents->FillRect(GetItemRect(i), GetItemColor(i));
+			}
+		}
+	}
+
+	Color GetItemColor(int i) const {
+		return Color(states[i][0] * 40, 0, 0, 255);
+	}
+
+	Color GetItemPixel(int i) {
+		Rect rect = GetItemRect(i);
+		return contents->GetColorAt(rect.x + 1, rect.y + 1);
+	}
+
+	std::vector<std::array<int, 4>> states;
+	std::vector<int> drawn;
+};
+}
+
+TEST_CASE("PartialItemRedraw") {
+	const MockActor m;
+	DrawableList list;
+	DrawableMgr::SetLocalList(&list);
+	Bitmap::SetFormat(format_R8G8B8A8_a().format());
+
+	{
+		TestWindow window;
+		window.states = { {1, 0, 0, 0}, {2, 0, 0, 0}, {3, 0, 0, 0} };
+		window.Refresh();
+		REQUIRE_EQ(window.drawn, (std::vector<int>{ 0, 1, 2 }));
+		auto contents = window.GetContents();
+
+		// Nothing changed
+		window.Refresh();
+		REQUIRE(window.drawn.empty());
+
+		// Only the changed item is redrawn, the other items keep their pixels
+		window.states[1] = { 5, 0, 0, 0 };
+		window.Refresh();
+		REQUIRE_EQ(window.drawn, (std::vector<int>{ 1 }));
+		REQUIRE_EQ(window.GetContents(), contents);
+		for (int i = 0; i < 3; ++i) {
+			REQUIRE_EQ(window.GetItemPixel(i), window.GetItemColor(i));
+		}
+
+		// The slot of a removed item is cleared
+		window.states.pop_back();
+		window.Refresh();
+		REQUIRE(window.drawn.empty());
+		REQUIRE_EQ(window.GetItemPixel(2), Color(0, 0, 0, 0));
+		REQUIRE_EQ(window.GetItemPixel(1), window.GetItemColor(1));
+
+		// New items are drawn into the existing contents
+		window.states.push_back({ 4, 0, 0, 0 });
+		window.Refresh();
+		REQUIRE_EQ(window.drawn, (std::vector<int>{ 2 }));
+		REQUIRE_EQ(window.GetItemPixel(2), window.GetItemColor(2));
+	}
+
+	DrawableMgr::SetLocalList(nullptr);
+}
+
+TEST_SUITE_END();